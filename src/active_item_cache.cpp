@@ -3,15 +3,26 @@
 #include <algorithm>
 #include <utility>
 
+#include "calendar.h"
 #include "item.h"
 #include "safe_reference.h"
 
+// No item::processing_interval() is longer than this.
+static const time_duration longest_interval = 10_minutes;
+
 void active_item_cache::remove( const item *it )
 {
-    active_items[it->processing_speed()].remove_if( [it]( const item_reference & active_item ) {
-        item *const target = active_item.item_ref.get();
-        return !target || target == it;
-    } );
+    for( auto iter = active_items.begin(); iter != active_items.end(); ) {
+        iter->second.remove_if( [it]( const item_reference & active_item ) {
+            item *const target = active_item.item_ref.get();
+            return !target || target == it;
+        } );
+        if( iter->second.empty() ) {
+            iter = active_items.erase( iter );
+        } else {
+            ++iter;
+        }
+    }
     if( it->can_revive() ) {
         special_items[ special_item_type::corpse ].remove_if( [it]( const item_reference & active_item ) {
             item *const target = active_item.item_ref.get();
@@ -30,12 +41,13 @@ void active_item_cache::remove( const item *it )
 void active_item_cache::add( item &it, point location )
 {
     // If the item is alread in the cache for some reason, don't add a second reference
-    std::list<item_reference> &target_list = active_items[it.processing_speed()];
-    if( std::find_if( target_list.begin(),
-    target_list.end(), [&it]( const item_reference & active_item_ref ) {
-    return &it == active_item_ref.item_ref.get();
-    } ) != target_list.end() ) {
-        return;
+    for( const std::pair<const time_point, std::list<item_reference>> &kv : active_items ) {
+        if( std::find_if( kv.second.begin(),
+        kv.second.end(), [&it]( const item_reference & active_item_ref ) {
+        return &it == active_item_ref.item_ref.get();
+        } ) != kv.second.end() ) {
+            return;
+        }
     }
     if( it.can_revive() ) {
         special_items[ special_item_type::corpse ].push_back( item_reference{ location, it.get_safe_reference() } );
@@ -43,12 +55,16 @@ void active_item_cache::add( item &it, point location )
     if( it.get_use( "explosion" ) ) {
         special_items[ special_item_type::explosive ].push_back( item_reference{ location, it.get_safe_reference() } );
     }
-    target_list.push_back( item_reference{ location, it.get_safe_reference() } );
+    // Items that are processed every turn start right away, others are spread over their
+    // interval so that a whole stockpile put down at once does not wake up all at once.
+    const int interval = to_turns<int>( it.processing_interval() );
+    const time_point due = calendar::turn + time_duration::from_turns( added_count++ % interval );
+    active_items[due].push_back( item_reference{ location, it.get_safe_reference() } );
 }
 
 bool active_item_cache::empty() const
 {
-    for( std::pair<int, std::list<item_reference>> active_queue : active_items ) {
+    for( const std::pair<const time_point, std::list<item_reference>> &active_queue : active_items ) {
         if( !active_queue.second.empty() ) {
             return false;
         }
@@ -59,7 +75,7 @@ bool active_item_cache::empty() const
 std::vector<item_reference> active_item_cache::get()
 {
     std::vector<item_reference> all_cached_items;
-    for( std::pair<const int, std::list<item_reference>> &kv : active_items ) {
+    for( std::pair<const time_point, std::list<item_reference>> &kv : active_items ) {
         for( std::list<item_reference>::iterator it = kv.second.begin(); it != kv.second.end(); ) {
             if( it->item_ref ) {
                 all_cached_items.emplace_back( *it );
@@ -75,23 +91,30 @@ std::vector<item_reference> active_item_cache::get()
 std::vector<item_reference> active_item_cache::get_for_processing()
 {
     std::vector<item_reference> items_to_process;
-    for( std::pair<const int, std::list<item_reference>> &kv : active_items ) {
-        // Rely on iteration logic to make sure the number is sane.
-        int num_to_process = kv.second.size() / kv.first;
-        std::list<item_reference>::iterator it = kv.second.begin();
-        for( ; it != kv.second.end() && num_to_process >= 0; ) {
-            if( it->item_ref ) {
-                items_to_process.push_back( *it );
-                --num_to_process;
-                ++it;
-            } else {
+    const time_point now = calendar::turn;
+    if( !active_items.empty() && active_items.rbegin()->first > now + longest_interval ) {
+        // The time has been set back (debug menu), wake everything up now.
+        std::list<item_reference> &due = active_items[now];
+        for( auto it = std::next( active_items.find( now ) ); it != active_items.end(); ++it ) {
+            due.splice( due.end(), it->second );
+        }
+        active_items.erase( std::next( active_items.find( now ) ), active_items.end() );
+    }
+    while( !active_items.empty() && active_items.begin()->first <= now ) {
+        std::list<item_reference> &due = active_items.begin()->second;
+        while( !due.empty() ) {
+            const std::list<item_reference>::iterator it = due.begin();
+            if( !it->item_ref ) {
                 // The item has been destroyed, so remove the reference from the cache
-                it = kv.second.erase( it );
+                due.erase( it );
+                continue;
             }
+            items_to_process.push_back( *it );
+            // Never due again this turn, the interval is at least one turn.
+            std::list<item_reference> &next = active_items[now + it->item_ref->processing_interval()];
+            next.splice( next.end(), due, it );
         }
-        // Rotate the returned items to the end of their list so that the items that weren't
-        // returned this time will be first in line on the next call
-        kv.second.splice( kv.second.end(), kv.second, kv.second.begin(), it );
+        active_items.erase( active_items.begin() );
     }
     return items_to_process;
 }
@@ -107,7 +130,7 @@ std::vector<item_reference> active_item_cache::get_special( special_item_type ty
 
 void active_item_cache::subtract_locations( const point &delta )
 {
-    for( std::pair<const int, std::list<item_reference>> &pair : active_items ) {
+    for( std::pair<const time_point, std::list<item_reference>> &pair : active_items ) {
         for( item_reference &ir : pair.second ) {
             ir.location -= delta;
         }
@@ -116,7 +139,7 @@ void active_item_cache::subtract_locations( const point &delta )
 
 void active_item_cache::rotate_locations( int turns, const point &dim )
 {
-    for( std::pair<const int, std::list<item_reference>> &pair : active_items ) {
+    for( std::pair<const time_point, std::list<item_reference>> &pair : active_items ) {
         for( item_reference &ir : pair.second ) {
             ir.location = ir.location.rotate( turns, dim );
         }
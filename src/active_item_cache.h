@@ -4,9 +4,11 @@
 
 #include <iosfwd>
 #include <list>
+#include <map>
 #include <unordered_map>
 #include <vector>
 
+#include "calendar.h"
 #include "point.h"
 #include "safe_reference.h"
 
@@ -37,20 +39,24 @@ struct hash<special_item_type> {
 class active_item_cache
 {
     private:
-        std::unordered_map<int, std::list<item_reference>> active_items;
+        /**
+         * Active items by the turn they are next due to be processed, see
+         * item::processing_interval(). Items that are not due are not looked at.
+         */
+        std::map<time_point, std::list<item_reference>> active_items;
         std::unordered_map<special_item_type, std::list<item_reference>> special_items;
+        /** Spreads the first wake-up of items added together over their interval. */
+        int added_count = 0;
 
     public:
         /**
          * Removes the item if it is in the cache. Does nothing if the item is not in the cache.
-         * Relies on the fact that item::processing_speed() is a constant.
-         * Also removes any items that have been destroyed in the list containing it
+         * Also removes any items that have been destroyed.
          */
         void remove( const item *it );
 
         /**
          * Adds the reference to the cache. Does nothing if the reference is already in the cache.
-         * Relies on the fact that item::processing_speed() is a constant.
          */
         void add( item &it, point location );
 
@@ -66,12 +72,10 @@ class active_item_cache
         std::vector<item_reference> get();
 
         /**
-         * Returns the first size() / processing_speed() elements of each list, rounded up.
-         * Items returned are rotated to the back of their respective lists, otherwise only the
-         * first n items will ever be processed.
+         * Returns the items that are due to be processed this turn and schedules them again
+         * after their current item::processing_interval().
          * Broken references encountered when collecting the items to be processed are removed from
          * the cache.
-         * Relies on the fact that item::processing_speed() is a constant.
          */
         std::vector<item_reference> get_for_processing();
 
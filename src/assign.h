@@ -13,6 +13,7 @@
 #include "color.h"
 #include "damage.h"
 #include "debug.h"
+#include "flag.h"
 #include "json.h"
 #include "units.h"
 
@@ -207,6 +208,16 @@ typename std::enable_if<std::is_constructible<T, std::string>::value, bool>::typ
     return res;
 }
 
+inline bool assign( const JsonObject &jo, const std::string &name, flag_set &val, bool strict = false )
+{
+    std::set<std::string> tags( val.begin(), val.end() );
+    if( !assign( jo, name, tags, strict ) ) {
+        return false;
+    }
+    val = tags;
+    return true;
+}
+
 inline bool assign( const JsonObject &jo, const std::string &name, units::volume &val,
                     bool strict = false,
                     const units::volume lo = units::volume_min,
@@ -30,6 +30,7 @@
 #include "field_type.h"
 #include "game.h"
 #include "game_constants.h"
+#include "hash_utils.h"
 #include "int_id.h"
 #include "item.h"
 #include "item_factory.h"
@@ -226,6 +227,7 @@ void cata_tiles::on_options_changed()
     settings.scale_to_fit = get_option<bool>( "PIXEL_MINIMAP_SCALE_TO_FIT" );
 
     minimap->set_settings( settings );
+    invalidate_frame_cache();
 }
 
 const tile_type *tileset::find_tile_type( const std::string &id ) const
@@ -244,6 +246,8 @@ tile_type &tileset::create_tile_type( const std::string &id, tile_type &&new_til
 void cata_tiles::load_tileset( const std::string &tileset_id, const bool precheck,
                                const bool force )
 {
+    // Also called after the game data was reloaded, which changes the ids of the types.
+    clear_tile_lookups();
     if( tileset_ptr && tileset_ptr->get_tileset_id() == tileset_id && !force ) {
         return;
     }
@@ -997,6 +1001,10 @@ void cata_tiles::draw( const point &dest, const tripoint &center, int width, int
     if( !g ) {
         return;
     }
+    // Seasonal tiles are part of the cached lookups.
+    if( season_of_year( calendar::turn ) != cached_tiles_season ) {
+        clear_tile_lookups();
+    }
 
 #if defined(__ANDROID__)
     // Attempted bugfix for Google Play crash - prevent divide-by-zero if no tile
@@ -1006,16 +1014,6 @@ void cata_tiles::draw( const point &dest, const tripoint &center, int width, int
     }
 #endif
 
-    {
-        //set clipping to prevent drawing over stuff we shouldn't
-        SDL_Rect clipRect = {dest.x, dest.y, width, height};
-        printErrorIf( SDL_RenderSetClipRect( renderer.get(), &clipRect ) != 0,
-                      "SDL_RenderSetClipRect failed" );
-
-        //fill render area with black to prevent artifacts where no new pixels are drawn
-        geometry->rect( renderer, clipRect, SDL_Color() );
-    }
-
     point s;
     get_window_tile_counts( width, height, s.x, s.y );
 
@@ -1057,6 +1055,42 @@ void cata_tiles::draw( const point &dest, const tripoint &center, int width, int
     auto vision_cache = you.get_vision_modes();
     nv_goggles_activated = vision_cache[NV_GOGGLES];
 
+    bool use_frame_cache = can_use_frame_cache();
+    const point size( width, height );
+    if( use_frame_cache && ( !frame_cache.texture || frame_cache.size != size ) ) {
+        frame_cache.texture = CreateTexture( renderer, SDL_PIXELFORMAT_ARGB8888,
+                                             SDL_TEXTUREACCESS_TARGET, width, height );
+        frame_cache.valid = false;
+        use_frame_cache = frame_cache.texture != nullptr;
+    }
+    if( use_frame_cache ) {
+        if( frame_cache.dest != dest || frame_cache.size != size || frame_cache.o != o ||
+            frame_cache.zlev != center.z || frame_cache.tile_width != tile_width ||
+            frame_cache.tile_height != tile_height ||
+            frame_cache.nv_goggles != nv_goggles_activated ||
+            frame_cache.show_memory != you.should_show_map_memory() ) {
+            frame_cache.valid = false;
+        }
+        frame_cache.dest = dest;
+        frame_cache.size = size;
+        frame_cache.o = o;
+        frame_cache.zlev = center.z;
+        frame_cache.tile_width = tile_width;
+        frame_cache.tile_height = tile_height;
+        frame_cache.nv_goggles = nv_goggles_activated;
+        frame_cache.show_memory = you.should_show_map_memory();
+        frame_cache.animated.clear();
+        // The tiles are drawn into the kept texture, at its origin.
+        SetRenderTarget( renderer, frame_cache.texture );
+        op = point_zero;
+    } else {
+        frame_cache.valid = false;
+    }
+    const SDL_Rect target_rect{ op.x, op.y, width, height };
+    //set clipping to prevent drawing over stuff we shouldn't
+    printErrorIf( SDL_RenderSetClipRect( renderer.get(), &target_rect ) != 0,
+                  "SDL_RenderSetClipRect failed" );
+
     // check that the creature for which we'll draw the visibility map is still alive at that point
     if( g->display_overlay_state( ACTION_DISPLAY_VISIBILITY ) &&
         g->displaying_visibility_creature ) {
@@ -1103,222 +1137,339 @@ void cata_tiles::draw( const point &dest, const tripoint &center, int width, int
                                            cache ) );
     };
 
-    for( int row = min_row; row < max_row; row ++ ) {
-        std::vector<tile_render_info> draw_points;
-        draw_points.reserve( max_col );
-        for( int col = min_col; col < max_col; col ++ ) {
-            int temp_x;
-            int temp_y;
-            if( iso_mode ) {
-                // in isometric, rows and columns represent a checkerboard screen space,
-                // and we place the appropriate tile in valid squares by getting position
-                // relative to the screen center.
-                if( modulo( row - s.y / 2, 2 ) != modulo( col - s.x / 2, 2 ) ) {
-                    continue;
+    // Draws the tiles in the screen columns and rows in [min, max), back to front.
+    const auto draw_tiles = [&]( const point & min, const point & max ) {
+        for( int row = min.y; row < max.y; row ++ ) {
+            std::vector<tile_render_info> draw_points;
+            draw_points.reserve( max.x - min.x );
+            for( int col = min.x; col < max.x; col ++ ) {
+                int temp_x;
+                int temp_y;
+                if( iso_mode ) {
+                    // in isometric, rows and columns represent a checkerboard screen space,
+                    // and we place the appropriate tile in valid squares by getting position
+                    // relative to the screen center.
+                    if( modulo( row - s.y / 2, 2 ) != modulo( col - s.x / 2, 2 ) ) {
+                        continue;
+                    }
+                    temp_x = divide_round_down( col - row - s.x / 2 + s.y / 2, 2 ) + o.x;
+                    temp_y = divide_round_down( row + col - s.y / 2 - s.x / 2, 2 ) + o.y;
+                } else {
+                    temp_x = col + o.x;
+                    temp_y = row + o.y;
                 }
-                temp_x = divide_round_down( col - row - s.x / 2 + s.y / 2, 2 ) + o.x;
-                temp_y = divide_round_down( row + col - s.y / 2 - s.x / 2, 2 ) + o.y;
-            } else {
-                temp_x = col + o.x;
-                temp_y = row + o.y;
-            }
-            const tripoint pos( temp_x, temp_y, center.z );
-            const int &x = pos.x;
-            const int &y = pos.y;
-
-            lit_level ll;
-            // invisible to normal eyes
-            bool invisible[5];
-            invisible[0] = false;
-
-            if( y < min_visible_y || y > max_visible_y || x < min_visible_x || x > max_visible_x ) {
-                if( has_memory_at( pos ) ) {
-                    ll = lit_level::MEMORIZED;
-                    invisible[0] = true;
-                } else if( has_draw_override( pos ) ) {
-                    ll = lit_level::DARK;
-                    invisible[0] = true;
+                const tripoint pos( temp_x, temp_y, center.z );
+                const int &x = pos.x;
+                const int &y = pos.y;
+
+                lit_level ll;
+                // invisible to normal eyes
+                bool invisible[5];
+                invisible[0] = false;
+
+                if( y < min_visible_y || y > max_visible_y || x < min_visible_x ||
+                    x > max_visible_x ) {
+                    if( has_memory_at( pos ) ) {
+                        ll = lit_level::MEMORIZED;
+                        invisible[0] = true;
+                    } else if( has_draw_override( pos ) ) {
+                        ll = lit_level::DARK;
+                        invisible[0] = true;
+                    } else {
+                        apply_vision_effects( pos, offscreen_type );
+                        continue;
+                    }
                 } else {
-                    apply_vision_effects( pos, offscreen_type );
-                    continue;
+                    ll = ch.visibility_cache[x][y];
                 }
-            } else {
-                ll = ch.visibility_cache[x][y];
-            }
 
-            // Add scent value to the overlay_strings list for every visible tile when
-            // displaying scent
-            if( g->display_overlay_state( ACTION_DISPLAY_SCENT ) && !invisible[0] ) {
-                const int scent_value = get_scent().get( pos );
-                if( scent_value > 0 ) {
-                    overlay_strings.emplace( player_to_screen( point( x, y ) ) + half_tile,
-                                             formatted_text( std::to_string( scent_value ),
-                                                     8 + catacurses::yellow, direction::NORTH ) );
+                // Add scent value to the overlay_strings list for every visible tile when
+                // displaying scent
+                if( g->display_overlay_state( ACTION_DISPLAY_SCENT ) && !invisible[0] ) {
+                    const int scent_value = get_scent().get( pos );
+                    if( scent_value > 0 ) {
+                        overlay_strings.emplace( player_to_screen( point( x, y ) ) + half_tile,
+                                                 formatted_text( std::to_string( scent_value ),
+                                                         8 + catacurses::yellow,
+                                                         direction::NORTH ) );
+                    }
                 }
-            }
 
-            // Add scent type to the overlay_strings list for every visible tile when
-            // displaying scent
-            if( g->display_overlay_state( ACTION_DISPLAY_SCENT_TYPE ) && !invisible[0] ) {
-                const scenttype_id scent_type = get_scent().get_type( pos );
-                if( !scent_type.is_empty() ) {
-                    overlay_strings.emplace( player_to_screen( point( x, y ) ) + half_tile,
-                                             formatted_text( scent_type.c_str(),
-                                                     8 + catacurses::yellow, direction::NORTH ) );
+                // Add scent type to the overlay_strings list for every visible tile when
+                // displaying scent
+                if( g->display_overlay_state( ACTION_DISPLAY_SCENT_TYPE ) && !invisible[0] ) {
+                    const scenttype_id scent_type = get_scent().get_type( pos );
+                    if( !scent_type.is_empty() ) {
+                        overlay_strings.emplace( player_to_screen( point( x, y ) ) + half_tile,
+                                                 formatted_text( scent_type.c_str(),
+                                                         8 + catacurses::yellow,
+                                                         direction::NORTH ) );
+                    }
                 }
-            }
 
-            if( g->display_overlay_state( ACTION_DISPLAY_RADIATION ) ) {
-                const auto rad_override = radiation_override.find( pos );
-                const bool rad_overridden = rad_override != radiation_override.end();
-                if( rad_overridden || !invisible[0] ) {
-                    const int rad_value = rad_overridden ? rad_override->second :
-                                          here.get_radiation( pos );
-                    catacurses::base_color col;
-                    if( rad_value > 0 ) {
-                        col = catacurses::green;
+                if( g->display_overlay_state( ACTION_DISPLAY_RADIATION ) ) {
+                    const auto rad_override = radiation_override.find( pos );
+                    const bool rad_overridden = rad_override != radiation_override.end();
+                    if( rad_overridden || !invisible[0] ) {
+                        const int rad_value = rad_overridden ? rad_override->second :
+                                              here.get_radiation( pos );
+                        catacurses::base_color col;
+                        if( rad_value > 0 ) {
+                            col = catacurses::green;
+                        } else {
+                            col = catacurses::cyan;
+                        }
+                        overlay_strings.emplace( player_to_screen( point( x, y ) ) + half_tile,
+                                                 formatted_text( std::to_string( rad_value ),
+                                                         8 + col, direction::NORTH ) );
+                    }
+                }
+
+                // Add temperature value to the overlay_strings list for every visible tile when
+                // displaying temperature
+                if( g->display_overlay_state( ACTION_DISPLAY_TEMPERATURE ) && !invisible[0] ) {
+                    int temp_value = get_weather().get_temperature( pos );
+                    int ctemp = temp_to_celsius( temp_value );
+                    short color;
+                    const short bold = 8;
+                    if( ctemp > 40 ) {
+                        color = catacurses::red;
+                    } else if( ctemp > 25 ) {
+                        color = catacurses::yellow + bold;
+                    } else if( ctemp > 10 ) {
+                        color = catacurses::green + bold;
+                    } else if( ctemp > 0 ) {
+                        color = catacurses::white + bold;
+                    } else if( ctemp > -10 ) {
+                        color = catacurses::cyan + bold;
                     } else {
-                        col = catacurses::cyan;
+                        color = catacurses::blue + bold;
+                    }
+                    if( get_option<std::string>( "USE_CELSIUS" ) == "celsius" ) {
+                        temp_value = temp_to_celsius( temp_value );
+                    } else if( get_option<std::string>( "USE_CELSIUS" ) == "kelvin" ) {
+                        temp_value = temp_to_kelvin( temp_value );
+
                     }
                     overlay_strings.emplace( player_to_screen( point( x, y ) ) + half_tile,
-                                             formatted_text( std::to_string( rad_value ),
-                                                     8 + col, direction::NORTH ) );
+                                             formatted_text( std::to_string( temp_value ), color,
+                                                     direction::NORTH ) );
                 }
-            }
 
-            // Add temperature value to the overlay_strings list for every visible tile when
-            // displaying temperature
-            if( g->display_overlay_state( ACTION_DISPLAY_TEMPERATURE ) && !invisible[0] ) {
-                int temp_value = get_weather().get_temperature( pos );
-                int ctemp = temp_to_celsius( temp_value );
-                short color;
-                const short bold = 8;
-                if( ctemp > 40 ) {
-                    color = catacurses::red;
-                } else if( ctemp > 25 ) {
-                    color = catacurses::yellow + bold;
-                } else if( ctemp > 10 ) {
-                    color = catacurses::green + bold;
-                } else if( ctemp > 0 ) {
-                    color = catacurses::white + bold;
-                } else if( ctemp > -10 ) {
-                    color = catacurses::cyan + bold;
-                } else {
-                    color = catacurses::blue + bold;
-                }
-                if( get_option<std::string>( "USE_CELSIUS" ) == "celsius" ) {
-                    temp_value = temp_to_celsius( temp_value );
-                } else if( get_option<std::string>( "USE_CELSIUS" ) == "kelvin" ) {
-                    temp_value = temp_to_kelvin( temp_value );
+                if( g->display_overlay_state( ACTION_DISPLAY_VISIBILITY ) &&
+                    g->displaying_visibility_creature && !invisible[0] ) {
+                    const bool visibility = g->displaying_visibility_creature->sees( pos );
 
-                }
-                overlay_strings.emplace( player_to_screen( point( x, y ) ) + half_tile,
-                                         formatted_text( std::to_string( temp_value ), color,
-                                                 direction::NORTH ) );
-            }
+                    // color overlay.
+                    auto block_color = visibility ? windowsPalette[catacurses::green] :
+                                       SDL_Color{ 192, 192, 192, 255 };
+                    block_color.a = 100;
+                    color_blocks.first = SDL_BLENDMODE_BLEND;
+                    color_blocks.second.emplace( player_to_screen( point( x, y ) ), block_color );
 
-            if( g->display_overlay_state( ACTION_DISPLAY_VISIBILITY ) &&
-                g->displaying_visibility_creature && !invisible[0] ) {
-                const bool visibility = g->displaying_visibility_creature->sees( pos );
-
-                // color overlay.
-                auto block_color = visibility ? windowsPalette[catacurses::green] :
-                                   SDL_Color{ 192, 192, 192, 255 };
-                block_color.a = 100;
-                color_blocks.first = SDL_BLENDMODE_BLEND;
-                color_blocks.second.emplace( player_to_screen( point( x, y ) ), block_color );
-
-                // overlay string
-                std::string visibility_str = visibility ? "+" : "-";
-                overlay_strings.emplace( player_to_screen( point( x, y ) ) + quarter_tile,
-                                         formatted_text( visibility_str, catacurses::black,
-                                                 direction::NORTH ) );
-            }
+                    // overlay string
+                    std::string visibility_str = visibility ? "+" : "-";
+                    overlay_strings.emplace( player_to_screen( point( x, y ) ) + quarter_tile,
+                                             formatted_text( visibility_str, catacurses::black,
+                                                     direction::NORTH ) );
+                }
 
-            if( g->display_overlay_state( ACTION_DISPLAY_LIGHTING ) ) {
-                static std::vector<SDL_Color> lighting_colors;
-                if( g->displaying_lighting_condition == 0 ) {
-                    if( lighting_colors.empty() ) {
-                        SDL_Color white = { 255, 255, 255, 255 };
-                        SDL_Color blue = { 0, 0, 255, 255 };
-                        lighting_colors = color_linear_interpolate( white, blue, 9 );
-                    }
+                if( g->display_overlay_state( ACTION_DISPLAY_LIGHTING ) ) {
+                    static std::vector<SDL_Color> lighting_colors;
+                    if( g->displaying_lighting_condition == 0 ) {
+                        if( lighting_colors.empty() ) {
+                            SDL_Color white = { 255, 255, 255, 255 };
+                            SDL_Color blue = { 0, 0, 255, 255 };
+                            lighting_colors = color_linear_interpolate( white, blue, 9 );
+                        }
 
-                    // note: lighting will be constrained in the [1.0, 11.0] range.
-                    float ambient = here.ambient_light_at( {x, y, center.z} );
-                    float lighting = std::max( 1.0, LIGHT_AMBIENT_LIT - ambient + 1.0 );
+                        // note: lighting will be constrained in the [1.0, 11.0] range.
+                        float ambient = here.ambient_light_at( {x, y, center.z} );
+                        float lighting = std::max( 1.0, LIGHT_AMBIENT_LIT - ambient + 1.0 );
 
-                    auto tile_pos = player_to_screen( point( x, y ) );
+                        auto tile_pos = player_to_screen( point( x, y ) );
 
-                    // color overlay
-                    auto color = lighting_colors[static_cast<int>( lighting ) - 1];
-                    color.a = 100;
-                    color_blocks.first = SDL_BLENDMODE_BLEND;
-                    color_blocks.second.emplace( tile_pos, color );
+                        // color overlay
+                        auto color = lighting_colors[static_cast<int>( lighting ) - 1];
+                        color.a = 100;
+                        color_blocks.first = SDL_BLENDMODE_BLEND;
+                        color_blocks.second.emplace( tile_pos, color );
 
-                    // string overlay
-                    overlay_strings.emplace( tile_pos + quarter_tile,
-                                             formatted_text( string_format( "%.1f", ambient ),
-                                                     catacurses::black,
-                                                     direction::NORTH ) );
+                        // string overlay
+                        overlay_strings.emplace( tile_pos + quarter_tile,
+                                                 formatted_text( string_format( "%.1f", ambient ),
+                                                         catacurses::black,
+                                                         direction::NORTH ) );
+                    }
                 }
-            }
 
-            if( !invisible[0] && apply_vision_effects( pos, here.get_visibility( ll, cache ) ) ) {
-                const Creature *critter = g->critter_at( pos, true );
-                if( has_draw_override( pos ) || has_memory_at( pos ) ||
-                    ( critter && ( you.sees_with_infrared( *critter ) ||
-                                   you.sees_with_specials( *critter ) ) ) ) {
+                if( !invisible[0] &&
+                    apply_vision_effects( pos, here.get_visibility( ll, cache ) ) ) {
+                    const Creature *critter = g->critter_at( pos, true );
+                    if( has_draw_override( pos ) || has_memory_at( pos ) ||
+                        ( critter && ( you.sees_with_infrared( *critter ) ||
+                                       you.sees_with_specials( *critter ) ) ) ) {
 
-                    invisible[0] = true;
-                } else {
-                    continue;
+                        invisible[0] = true;
+                    } else {
+                        continue;
+                    }
+                }
+                for( int i = 0; i < 4; i++ ) {
+                    const tripoint np = pos + neighborhood[i];
+                    invisible[1 + i] = apply_visible( np, ch, here );
                 }
-            }
-            for( int i = 0; i < 4; i++ ) {
-                const tripoint np = pos + neighborhood[i];
-                invisible[1 + i] = apply_visible( np, ch, here );
-            }
 
-            int height_3d = 0;
+                int height_3d = 0;
 
-            // light level is now used for choosing between grayscale filter and normal lit tiles.
-            draw_terrain( pos, ll, height_3d, invisible );
+                // light level is now used for choosing between grayscale filter and normal
+                // lit tiles.
+                draw_terrain( pos, ll, height_3d, invisible );
 
-            draw_points.emplace_back( pos, height_3d, ll, invisible );
+                draw_points.emplace_back( pos, height_3d, ll, invisible );
+            }
+            const std::array<decltype( &cata_tiles::draw_furniture ), 11> drawing_layers = {{
+                    &cata_tiles::draw_furniture, &cata_tiles::draw_graffiti, &cata_tiles::draw_trap,
+                    &cata_tiles::draw_field_or_item, &cata_tiles::draw_vpart_below,
+                    &cata_tiles::draw_critter_at_below, &cata_tiles::draw_terrain_below,
+                    &cata_tiles::draw_vpart, &cata_tiles::draw_critter_at,
+                    &cata_tiles::draw_zone_mark, &cata_tiles::draw_zombie_revival_indicators
+                }
+            };
+            // for each of the drawing layers in order, back to front ...
+            for( auto f : drawing_layers ) {
+                // ... draw all the points we drew terrain for, in the same order
+                for( auto &p : draw_points ) {
+                    ( this->*f )( p.pos, p.ll, p.height_3d, p.invisible );
+                }
+            }
+            // display number of monsters to spawn in mapgen preview
+            for( const auto &p : draw_points ) {
+                const auto mon_override = monster_override.find( p.pos );
+                if( mon_override != monster_override.end() ) {
+                    const int count = std::get<1>( mon_override->second );
+                    const bool more = std::get<2>( mon_override->second );
+                    if( count > 1 || more ) {
+                        std::string text = "x" + std::to_string( count );
+                        if( more ) {
+                            text += "+";
+                        }
+                        overlay_strings.emplace( player_to_screen( p.pos.xy() ) + half_tile,
+                                                 formatted_text( text, catacurses::red,
+                                                         direction::NORTH ) );
+                    }
+                }
+            }
         }
-        const std::array<decltype( &cata_tiles::draw_furniture ), 11> drawing_layers = {{
-                &cata_tiles::draw_furniture, &cata_tiles::draw_graffiti, &cata_tiles::draw_trap,
-                &cata_tiles::draw_field_or_item, &cata_tiles::draw_vpart_below,
-                &cata_tiles::draw_critter_at_below, &cata_tiles::draw_terrain_below,
-                &cata_tiles::draw_vpart, &cata_tiles::draw_critter_at,
-                &cata_tiles::draw_zone_mark, &cata_tiles::draw_zombie_revival_indicators
+    };
+    const half_open_rectangle<point> screen_tiles( point( min_col, min_row ),
+            point( max_col, max_row ) );
+    if( !use_frame_cache ) {
+        //fill render area with black to prevent artifacts where no new pixels are drawn
+        geometry->rect( renderer, target_rect, SDL_Color() );
+        draw_tiles( screen_tiles.p_min, screen_tiles.p_max );
+    } else {
+        const size_t tile_count = static_cast<size_t>( max_col ) * max_row;
+        std::vector<std::size_t> signatures( tile_count );
+        std::vector<bool> always_redraw( tile_count );
+        for( int row = min_row; row < max_row; row++ ) {
+            for( int col = min_col; col < max_col; col++ ) {
+                const tripoint pos( col + o.x, row + o.y, center.z );
+                const bool in_view = pos.x >= min_visible_x && pos.x <= max_visible_x &&
+                                     pos.y >= min_visible_y && pos.y <= max_visible_y;
+                const lit_level ll = in_view ? ch.visibility_cache[pos.x][pos.y] :
+                                     lit_level::MEMORIZED;
+                const visibility_type visibility = in_view ? here.get_visibility( ll, cache ) :
+                                                   offscreen_type;
+                bool redraw = false;
+                signatures[row * max_col + col] = tile_signature( pos, visibility, ll, redraw );
+                always_redraw[row * max_col + col] = redraw;
             }
+        }
+
+        const auto clamp_to_screen = [&]( const point & min, const point & max ) {
+            return half_open_rectangle<point>(
+                       point( std::max( min.x, min_col ), std::max( min.y, min_row ) ),
+                       point( std::min( max.x, max_col ), std::min( max.y, max_row ) ) );
         };
-        // for each of the drawing layers in order, back to front ...
-        for( auto f : drawing_layers ) {
-            // ... draw all the points we drew terrain for, in the same order
-            for( auto &p : draw_points ) {
-                ( this->*f )( p.pos, p.ll, p.height_3d, p.invisible );
+
+        // Tiles are drawn depending on their neighbors, those are redrawn along with them.
+        std::vector<bool> changed( tile_count, !frame_cache.valid );
+        if( frame_cache.valid ) {
+            for( int row = min_row; row < max_row; row++ ) {
+                for( int col = min_col; col < max_col; col++ ) {
+                    const size_t i = row * max_col + col;
+                    if( signatures[i] == frame_cache.signatures[i] && !always_redraw[i] &&
+                        !frame_cache.always_redraw[i] ) {
+                        continue;
+                    }
+                    const half_open_rectangle<point> neighbors = clamp_to_screen(
+                                point( col - 1, row - 1 ), point( col + 2, row + 2 ) );
+                    for( int y = neighbors.p_min.y; y < neighbors.p_max.y; y++ ) {
+                        for( int x = neighbors.p_min.x; x < neighbors.p_max.x; x++ ) {
+                            changed[y * max_col + x] = true;
+                        }
+                    }
+                }
             }
         }
-        // display number of monsters to spawn in mapgen preview
-        for( const auto &p : draw_points ) {
-            const auto mon_override = monster_override.find( p.pos );
-            if( mon_override != monster_override.end() ) {
-                const int count = std::get<1>( mon_override->second );
-                const bool more = std::get<2>( mon_override->second );
-                if( count > 1 || more ) {
-                    std::string text = "x" + std::to_string( count );
-                    if( more ) {
-                        text += "+";
-                    }
-                    overlay_strings.emplace( player_to_screen( p.pos.xy() ) + half_tile,
-                                             formatted_text( text, catacurses::red,
-                                                     direction::NORTH ) );
+        // Each run of changed tiles in a row is cleared together with the tiles the sprites
+        // can reach, and drawn again together with the tiles whose sprites reach into it.
+        const int reach = frame_cache.overhang;
+        std::vector<half_open_rectangle<point>> changed_runs;
+        size_t redrawn_tiles = 0;
+        for( int row = min_row; row < max_row; row++ ) {
+            for( int col = min_col; col < max_col; col++ ) {
+                if( !changed[row * max_col + col] ) {
+                    continue;
                 }
+                const int begin = col;
+                while( col < max_col && changed[row * max_col + col] ) {
+                    col++;
+                }
+                changed_runs.emplace_back( point( begin, row ), point( col, row + 1 ) );
+                const half_open_rectangle<point> drawn = clamp_to_screen(
+                            point( begin - 2 * reach, row - 2 * reach ),
+                            point( col + 2 * reach, row + 1 + 2 * reach ) );
+                redrawn_tiles += ( drawn.p_max.x - drawn.p_min.x ) *
+                                 ( drawn.p_max.y - drawn.p_min.y );
             }
         }
+        // Past a point, redrawing scattered tiles costs more than drawing them all.
+        if( redrawn_tiles * 2 > tile_count ) {
+            geometry->rect( renderer, target_rect, SDL_Color() );
+            draw_tiles( screen_tiles.p_min, screen_tiles.p_max );
+        } else {
+            for( const half_open_rectangle<point> &run : changed_runs ) {
+                const half_open_rectangle<point> cleared = clamp_to_screen(
+                            run.p_min - point( reach, reach ), run.p_max + point( reach, reach ) );
+                const SDL_Rect clip_rect{
+                    cleared.p_min.x * tile_width, cleared.p_min.y * tile_height,
+                    ( cleared.p_max.x - cleared.p_min.x ) * tile_width,
+                    ( cleared.p_max.y - cleared.p_min.y ) * tile_height
+                };
+                printErrorIf( SDL_RenderSetClipRect( renderer.get(), &clip_rect ) != 0,
+                              "SDL_RenderSetClipRect failed" );
+                geometry->rect( renderer, clip_rect, SDL_Color() );
+                const half_open_rectangle<point> drawn = clamp_to_screen(
+                            cleared.p_min - point( reach, reach ),
+                            cleared.p_max + point( reach, reach ) );
+                draw_tiles( drawn.p_min, drawn.p_max );
+            }
+            printErrorIf( SDL_RenderSetClipRect( renderer.get(), &target_rect ) != 0,
+                          "SDL_RenderSetClipRect failed" );
+        }
+
+        for( const point &p : frame_cache.animated ) {
+            const point screen_pos = p - o;
+            if( screen_tiles.contains( screen_pos ) ) {
+                always_redraw[screen_pos.y * max_col + screen_pos.x] = true;
+            }
+        }
+        frame_cache.signatures = std::move( signatures );
+        frame_cache.always_redraw = std::move( always_redraw );
+        // A sprite reaching further than before may have been cut off.
+        frame_cache.valid = reach == frame_cache.overhang;
     }
     // tile overrides are already drawn in the previous code
     void_radiation_override();
@@ -1388,6 +1539,15 @@ void cata_tiles::draw( const point &dest, const tripoint &center, int width, int
         }
     }
 
+    if( use_frame_cache ) {
+        set_displaybuffer_rendertarget();
+        op = dest;
+        const SDL_Rect dest_rect{ dest.x, dest.y, width, height };
+        printErrorIf( SDL_RenderSetClipRect( renderer.get(), &dest_rect ) != 0,
+                      "SDL_RenderSetClipRect failed" );
+        RenderCopy( renderer, frame_cache.texture, nullptr, &dest_rect );
+    }
+
     in_animation = do_draw_explosion || do_draw_custom_explosion ||
                    do_draw_bullet || do_draw_hit || do_draw_line ||
                    do_draw_cursor || do_draw_highlight || do_draw_weather ||
@@ -1452,6 +1612,85 @@ void cata_tiles::draw( const point &dest, const tripoint &center, int width, int
                   "SDL_RenderSetClipRect failed" );
 }
 
+bool cata_tiles::can_use_frame_cache() const
+{
+    // Isometric tiles overlap in too many ways to redraw single ones.
+    if( tile_iso ) {
+        return false;
+    }
+    // Overrides, overlays and zone marks are not part of the tile signatures.
+    if( !radiation_override.empty() || !terrain_override.empty() ||
+        !furniture_override.empty() || !graffiti_override.empty() || !trap_override.empty() ||
+        !field_override.empty() || !item_override.empty() || !vpart_override.empty() ||
+        !draw_below_override.empty() || !monster_override.empty() ) {
+        return false;
+    }
+    for( const action_id overlay : {
+             ACTION_DISPLAY_SCENT, ACTION_DISPLAY_SCENT_TYPE, ACTION_DISPLAY_TEMPERATURE,
+             ACTION_DISPLAY_VEHICLE_AI, ACTION_DISPLAY_VISIBILITY, ACTION_DISPLAY_LIGHTING,
+             ACTION_DISPLAY_RADIATION
+         } ) {
+        if( g->display_overlay_state( overlay ) ) {
+            return false;
+        }
+    }
+    return !g->is_zones_manager_open();
+}
+
+std::size_t cata_tiles::tile_signature( const tripoint &p, const visibility_type visibility,
+                                        const lit_level ll, bool &always_redraw )
+{
+    std::size_t ret = 0;
+    cata::hash_combine( ret, static_cast<int>( visibility ) );
+    cata::hash_combine( ret, static_cast<int>( ll ) );
+    // Creatures are drawn with what they wear and how they feel about the player,
+    // it's cheaper to always redraw them than to check all of that.
+    always_redraw = g->critter_at( p, true ) != nullptr;
+
+    map &here = get_map();
+    avatar &you = get_avatar();
+    if( would_apply_vision_effects( visibility ) ) {
+        if( you.should_show_map_memory() ) {
+            const memorized_terrain_tile memory = you.get_memorized_tile( here.getabs( p ) );
+            cata::hash_combine( ret, memory.tile );
+            cata::hash_combine( ret, memory.subtile );
+            cata::hash_combine( ret, memory.rotation );
+        }
+        return ret;
+    }
+
+    cata::hash_combine( ret, here.ter( p ).to_i() );
+    cata::hash_combine( ret, here.furn( p ).to_i() );
+    const trap &tr = here.tr_at( p );
+    cata::hash_combine( ret, tr.can_see( p, you ) ? tr.loadid.to_i() : 0 );
+    cata::hash_combine( ret, here.has_graffiti_at( p ) );
+    cata::hash_combine( ret, here.field_at( p ).displayed_field_type().to_i() );
+    if( here.sees_some_items( p, you ) ) {
+        const maptile &tile = here.maptile_at( p );
+        const item &itm = tile.get_uppermost_item();
+        cata::hash_combine( ret, itm.type );
+        cata::hash_combine( ret, itm.get_mtype() );
+        // Also covers the revival indicators of corpses further down the pile.
+        cata::hash_combine( ret, tile.get_item_count() );
+    }
+    if( const optional_vpart_position vp = here.veh_at( p ) ) {
+        const vehicle &veh = vp->vehicle();
+        char part_mod = 0;
+        cata::hash_combine( ret, veh.part_id_string( vp->part_index(), part_mod ).str() );
+        cata::hash_combine( ret, part_mod );
+        cata::hash_combine( ret, veh.face.dir() );
+        const cata::optional<vpart_reference> cargo = vp.part_with_feature( "CARGO", true );
+        cata::hash_combine( ret, cargo && !veh.get_items( cargo->part_index() ).empty() );
+    }
+    if( !here.dont_draw_lower_floor( p ) ) {
+        const tripoint below( p.xy(), p.z - 1 );
+        cata::hash_combine( ret, here.ter( below ).to_i() );
+        cata::hash_combine( ret, here.furn( below ).to_i() );
+        always_redraw = always_redraw || here.veh_at( below ) || g->critter_at( below, true );
+    }
+    return ret;
+}
+
 void cata_tiles::draw_minimap( const point &dest, const tripoint &center, int width, int height )
 {
     minimap->draw( SDL_Rect{ dest.x, dest.y, width, height }, center );
@@ -1811,6 +2050,104 @@ bool cata_tiles::draw_from_id_string( std::string id, TILE_CATEGORY category,
         }
     }
 
+    return draw_found_tile( make_lookup_res( std::move( id ), tt, category ), category, pos, rota, ll,
+                            apply_night_vision_goggles, height_3d );
+}
+
+tile_lookup_res cata_tiles::make_lookup_res( std::string &&id, const tile_type *tt,
+        const TILE_CATEGORY category ) const
+{
+    tile_lookup_res res;
+    res.tt = tt;
+    if( category == C_FURNITURE ) {
+        // If the furniture is not movable, we'll allow seeding by the position
+        // since we won't get the behavior that occurs where the tile constantly
+        // changes when the player grabs the furniture and drags it, causing the
+        // seed to change.
+        const furn_str_id fid( id );
+        res.seed_by_position = fid.is_valid() && !fid.obj().is_movable();
+    }
+    res.id = std::move( id );
+    return res;
+}
+
+void cata_tiles::resolve_cached_tile( cached_tile &entry, const std::string &id,
+                                      const TILE_CATEGORY category )
+{
+    entry.resolved = true;
+    std::string found_id = id;
+    const tile_type *tt = find_tile_looks_like( found_id, category );
+    entry.res = make_lookup_res( std::move( found_id ), tt, category );
+    entry.subtiles.fill( cata::nullopt );
+    if( !tt || !tt->multitile ) {
+        return;
+    }
+    const auto &available = tt->available_subtiles;
+    for( size_t i = 0; i < multitile_keys.size(); ++i ) {
+        if( std::find( available.begin(), available.end(), multitile_keys[i] ) != available.end() ) {
+            std::string sub_id = entry.res.id + "_" + multitile_keys[i];
+            const tile_type *sub_tt = find_tile_looks_like( sub_id, category );
+            entry.subtiles[i] = make_lookup_res( std::move( sub_id ), sub_tt, category );
+        }
+    }
+}
+
+cached_tile &cata_tiles::get_cached_tile( std::vector<cached_tile> &cache, const int index )
+{
+    if( static_cast<size_t>( index ) >= cache.size() ) {
+        cache.resize( index + 1 );
+    }
+    return cache[index];
+}
+
+void cata_tiles::clear_tile_lookups()
+{
+    cached_terrain.clear();
+    cached_furniture.clear();
+    cached_traps.clear();
+    cached_fields.clear();
+    cached_items.clear();
+    cached_tiles_season = season_of_year( calendar::turn );
+    invalidate_frame_cache();
+}
+
+void cata_tiles::invalidate_frame_cache()
+{
+    frame_cache.valid = false;
+    frame_cache.overhang = 0;
+}
+
+bool cata_tiles::draw_cached_tile( cached_tile &entry, const std::string &id,
+                                   const TILE_CATEGORY category, const std::string &subcategory,
+                                   const tripoint &pos, int subtile, const int rota, const lit_level ll,
+                                   const bool apply_night_vision_goggles, int &height_3d )
+{
+    half_open_rectangle<point> screen_bounds( o, o + point( screentile_width, screentile_height ) );
+    if( !tile_iso &&
+        !screen_bounds.contains( pos.xy() ) ) {
+        return false;
+    }
+    if( !entry.resolved ) {
+        resolve_cached_tile( entry, id, category );
+    }
+    const tile_lookup_res *res = &entry.res;
+    if( res->tt && subtile != -1 && res->tt->multitile && entry.subtiles[subtile] ) {
+        res = &*entry.subtiles[subtile];
+        subtile = -1;
+    }
+    if( !res->tt ) {
+        // Fall back to symbols and unknown tiles, which isn't worth caching.
+        return draw_from_id_string( res->id, category, subcategory, pos, subtile, rota, ll,
+                                    apply_night_vision_goggles, height_3d );
+    }
+    return draw_found_tile( *res, category, pos, rota, ll, apply_night_vision_goggles, height_3d );
+}
+
+bool cata_tiles::draw_found_tile( const tile_lookup_res &res, const TILE_CATEGORY category,
+                                  const tripoint &pos, int rota, const lit_level ll,
+                                  const bool apply_night_vision_goggles, int &height_3d )
+{
+    const tile_type &display_tile = *res.tt;
     // translate from player-relative to screen relative tile position
     const point screen_pos = player_to_screen( pos.xy() );
 
@@ -1853,20 +2190,11 @@ bool cata_tiles::draw_from_id_string( std::string id, TILE_CATEGORY category,
 
         }
         break;
-        case C_FURNITURE: {
-            // If the furniture is not movable, we'll allow seeding by the position
-            // since we won't get the behavior that occurs where the tile constantly
-            // changes when the player grabs the furniture and drags it, causing the
-            // seed to change.
-            const furn_str_id fid( id );
-            if( fid.is_valid() ) {
-                const furn_t &f = fid.obj();
-                if( !f.is_movable() ) {
-                    seed = here.getabs( pos ).x + here.getabs( pos ).y * 65536;
-                }
+        case C_FURNITURE:
+            if( res.seed_by_position ) {
+                seed = here.getabs( pos ).x + here.getabs( pos ).y * 65536;
             }
-        }
-        break;
+            break;
         case C_ITEM:
         case C_TRAP:
         case C_NONE:
@@ -1883,12 +2211,12 @@ bool cata_tiles::draw_from_id_string( std::string id, TILE_CATEGORY category,
             break;
         default:
             // player
-            if( id.substr( 7 ) == "player_" ) {
+            if( res.id.substr( 7 ) == "player_" ) {
                 seed = get_player_character().name[0];
                 break;
             }
             // NPC
-            if( id.substr( 4 ) == "npc_" ) {
+            if( res.id.substr( 4 ) == "npc_" ) {
                 if( npc *const guy = g->critter_at<npc>( pos ) ) {
                     seed = guy->getID().get_value();
                     break;
@@ -1929,6 +2257,7 @@ bool cata_tiles::draw_from_id_string( std::string id, TILE_CATEGORY category,
 
         // idle tile animations:
         if( display_tile.animated ) {
+            frame_cache.animated.push_back( pos.xy() );
             // idle animations run during the user's turn, and the animation speed
             // needs to be defined by the tileset to look good, so we use system clock:
             auto now = std::chrono::system_clock::now();
@@ -2033,6 +2362,16 @@ bool cata_tiles::draw_sprite_at(
     destination.w = width * tile_width / tileset_ptr->get_tile_width();
     destination.h = height * tile_height / tileset_ptr->get_tile_height();
 
+    // Sprites reaching into other tiles have to be redrawn together with those.
+    const int reach_x = std::max( p.x - destination.x,
+                                  destination.x + destination.w - p.x - tile_width );
+    const int reach_y = std::max( p.y - destination.y,
+                                  destination.y + destination.h - p.y - tile_height );
+    frame_cache.overhang = std::max( { frame_cache.overhang,
+                                       divide_round_up( std::max( reach_x, 0 ), tile_width ),
+                                       divide_round_up( std::max( reach_y, 0 ), tile_height )
+                                     } );
+
     if( rotate_sprite ) {
         switch( rota ) {
             default:
@@ -2254,8 +2593,8 @@ bool cata_tiles::draw_terrain( const tripoint &p, const lit_level ll, int &heigh
         }
         // draw the actual terrain if there's no override
         if( !neighborhood_overridden ) {
-            return draw_from_id_string( tname, C_TERRAIN, empty_string, p, subtile, rotation, ll,
-                                        nv_goggles_activated, height_3d );
+            return draw_cached_tile( get_cached_tile( cached_terrain, t.to_i() ), tname, C_TERRAIN,
+                                     empty_string, p, subtile, rotation, ll, nv_goggles_activated, height_3d );
         }
     }
     if( invisible[0] ? overridden : neighborhood_overridden ) {
@@ -2277,8 +2616,8 @@ bool cata_tiles::draw_terrain( const tripoint &p, const lit_level ll, int &heigh
             // tile overrides are always shown with full visibility
             const lit_level lit = overridden ? lit_level::LIT : ll;
             const bool nv = overridden ? false : nv_goggles_activated;
-            return draw_from_id_string( tname, C_TERRAIN, empty_string, p, subtile, rotation,
-                                        lit, nv, height_3d );
+            return draw_cached_tile( get_cached_tile( cached_terrain, t2.to_i() ), tname, C_TERRAIN,
+                                     empty_string, p, subtile, rotation, lit, nv, height_3d );
         }
     } else if( invisible[0] && has_terrain_memory_at( p ) ) {
         // try drawing memory if invisible and not overridden
@@ -2434,8 +2773,8 @@ bool cata_tiles::draw_furniture( const tripoint &p, const lit_level ll, int &hei
         }
         // draw the actual furniture if there's no override
         if( !neighborhood_overridden ) {
-            return draw_from_id_string( fname, C_FURNITURE, empty_string, p, subtile, rotation, ll,
-                                        nv_goggles_activated, height_3d );
+            return draw_cached_tile( get_cached_tile( cached_furniture, f.to_i() ), fname, C_FURNITURE,
+                                     empty_string, p, subtile, rotation, ll, nv_goggles_activated, height_3d );
         }
     }
     if( invisible[0] ? overridden : neighborhood_overridden ) {
@@ -2469,8 +2808,8 @@ bool cata_tiles::draw_furniture( const tripoint &p, const lit_level ll, int &hei
             // tile overrides are always shown with full visibility
             const lit_level lit = overridden ? lit_level::LIT : ll;
             const bool nv = overridden ? false : nv_goggles_activated;
-            return draw_from_id_string( fname, C_FURNITURE, empty_string, p, subtile, rotation,
-                                        lit, nv, height_3d );
+            return draw_cached_tile( get_cached_tile( cached_furniture, f2.to_i() ), fname, C_FURNITURE,
+                                     empty_string, p, subtile, rotation, lit, nv, height_3d );
         }
     } else if( invisible[0] && has_furniture_memory_at( p ) ) {
         // try drawing memory if invisible and not overridden
@@ -2516,8 +2855,8 @@ bool cata_tiles::draw_trap( const tripoint &p, const lit_level ll, int &height_3
         }
         // draw the actual trap if there's no override
         if( !neighborhood_overridden ) {
-            return draw_from_id_string( trname, C_TRAP, empty_string, p, subtile, rotation, ll,
-                                        nv_goggles_activated, height_3d );
+            return draw_cached_tile( get_cached_tile( cached_traps, tr.loadid.to_i() ), trname, C_TRAP,
+                                     empty_string, p, subtile, rotation, ll, nv_goggles_activated, height_3d );
         }
     }
     if( overridden || ( !invisible[0] && neighborhood_overridden &&
@@ -2546,8 +2885,8 @@ bool cata_tiles::draw_trap( const tripoint &p, const lit_level ll, int &height_3
             // tile overrides are always shown with full visibility
             const lit_level lit = overridden ? lit_level::LIT : ll;
             const bool nv = overridden ? false : nv_goggles_activated;
-            return draw_from_id_string( trname, C_TRAP, empty_string, p, subtile, rotation,
-                                        lit, nv, height_3d );
+            return draw_cached_tile( get_cached_tile( cached_traps, tr2.to_i() ), trname, C_TRAP,
+                                     empty_string, p, subtile, rotation, lit, nv, height_3d );
         }
     } else if( invisible[0] && has_trap_memory_at( p ) ) {
         // try drawing memory if invisible and not overridden
@@ -2601,8 +2940,9 @@ bool cata_tiles::draw_field_or_item( const tripoint &p, const lit_level ll, int
         int rotation = 0;
         get_tile_values( fld.to_i(), neighborhood, subtile, rotation );
 
-        ret_draw_field = draw_from_id_string( fld.id().str(), C_FIELD, empty_string, p, subtile,
-                                              rotation, lit, nv );
+        int height_3d_field = 0;
+        ret_draw_field = draw_cached_tile( get_cached_tile( cached_fields, fld.to_i() ), fld.id().str(),
+                                           C_FIELD, empty_string, p, subtile, rotation, lit, nv, height_3d_field );
     }
     if( fld.obj().display_items ) {
         const auto it_override = item_override.find( p );
@@ -2635,8 +2975,11 @@ bool cata_tiles::draw_field_or_item( const tripoint &p, const lit_level ll, int
             const lit_level lit = it_overridden ? lit_level::LIT : ll;
             const bool nv = it_overridden ? false : nv_goggles_activated;
 
-            ret_draw_items = draw_from_id_string( disp_id, C_ITEM, it_category, p, 0, 0, lit,
-                                                  nv, height_3d );
+            // Corpses look like their monster, so they can't be cached by item type.
+            ret_draw_items = it_id == itype_corpse ?
+                             draw_from_id_string( disp_id, C_ITEM, it_category, p, 0, 0, lit, nv, height_3d ) :
+                             draw_cached_tile( cached_items[it_type], disp_id, C_ITEM, it_category, p, 0, 0, lit,
+                                               nv, height_3d );
             if( ret_draw_items && hilite ) {
                 draw_item_highlight( p );
             }
@@ -2,6 +2,7 @@
 #ifndef CATA_SRC_CATA_TILES_H
 #define CATA_SRC_CATA_TILES_H
 
+#include <array>
 #include <cstddef>
 #include <map>
 #include <memory>
@@ -12,11 +13,13 @@
 #include <vector>
 
 #include "animation.h"
+#include "calendar.h"
 #include "creature.h"
 #include "enums.h"
 #include "lightmap.h"
 #include "line.h"
 #include "map_memory.h"
+#include "optional.h"
 #include "options.h"
 #include "pimpl.h"
 #include "point.h"
@@ -28,6 +31,7 @@
 
 class Character;
 class JsonObject;
+struct itype;
 class pixel_minimap;
 
 extern void set_displaybuffer_rendertarget();
@@ -57,6 +61,26 @@ enum MULTITILE_TYPE {
     broken,
     num_multitile_types
 };
+/** Tile found for an id, after following looks_like and picking the tile for the season. */
+struct tile_lookup_res {
+    // The id of the tile, or the id that was looked for if there is no tile.
+    std::string id;
+    const tile_type *tt = nullptr;
+    // Furniture that can't be moved picks its random sprite by position.
+    bool seed_by_position = false;
+};
+
+/**
+ * Lookup of the tile of a terrain, furniture, trap, field or item type, done once and kept
+ * together with the tiles of its subtiles, so drawing them needs no string lookups.
+ */
+struct cached_tile {
+    bool resolved = false;
+    tile_lookup_res res;
+    // Only set for the subtiles the tile has.
+    std::array<cata::optional<tile_lookup_res>, num_multitile_types> subtiles;
+};
+
 // Make sure to change TILE_CATEGORY_IDS if this changes!
 enum TILE_CATEGORY {
     C_NONE,
@@ -264,6 +288,34 @@ struct formatted_text {
  */
 using color_block_overlay_container = std::pair<SDL_BlendMode, std::multimap<point, SDL_Color>>;
 
+/**
+ * The terrain window as it was drawn in the last frame, kept in a texture together with
+ * what each tile was drawn from, so a frame in which little changed only redraws the tiles
+ * that did.
+ */
+struct tile_frame_cache {
+    SDL_Texture_Ptr texture;
+    bool valid = false;
+    // A change of any of these moves or rescales all the tiles.
+    point dest;
+    point size;
+    point o;
+    int zlev = 0;
+    int tile_width = 0;
+    int tile_height = 0;
+    bool nv_goggles = false;
+    bool show_memory = false;
+    // Indexed by row * columns + column.
+    std::vector<std::size_t> signatures;
+    // Tiles that are redrawn in the next frame even if their signature stays the same,
+    // like those with creatures or animated sprites.
+    std::vector<bool> always_redraw;
+    // Positions of the animated sprites drawn in this frame.
+    std::vector<point> animated;
+    // How many tiles the sprites drawn so far reached beyond their own tile.
+    int overhang = 0;
+};
+
 class cata_tiles
 {
     public:
@@ -285,7 +337,19 @@ class cata_tiles
         /** Minimap functionality */
         void draw_minimap( const point &dest, const tripoint &center, int width, int height );
 
+        /** Draw all tiles in the next frame, e.g. after the render targets were lost. */
+        void invalidate_frame_cache();
+
     protected:
+        /** Whether the frame can be drawn over the last one, see @ref tile_frame_cache. */
+        bool can_use_frame_cache() const;
+        /**
+         * Hash of everything the tile at @p p is drawn from. Sets @p always_redraw for tiles
+         * whose look depends on more than that.
+         */
+        std::size_t tile_signature( const tripoint &p, visibility_type visibility, lit_level ll,
+                                    bool &always_redraw );
+
         /** How many rows and columns of tiles fit into given dimensions **/
         void get_window_tile_counts( int width, int height, int &columns, int &rows ) const;
 
@@ -303,6 +367,16 @@ class cata_tiles
         bool draw_from_id_string( std::string id, TILE_CATEGORY category,
                                   const std::string &subcategory, const tripoint &pos, int subtile, int rota,
                                   lit_level ll, bool apply_night_vision_goggles, int &height_3d );
+        /** Like @ref draw_from_id_string, but looks up the tile only the first time. */
+        bool draw_cached_tile( cached_tile &entry, const std::string &id, TILE_CATEGORY category,
+                               const std::string &subcategory, const tripoint &pos, int subtile, int rota,
+                               lit_level ll, bool apply_night_vision_goggles, int &height_3d );
+        void resolve_cached_tile( cached_tile &entry, const std::string &id, TILE_CATEGORY category );
+        tile_lookup_res make_lookup_res( std::string &&id, const tile_type *tt,
+                                         TILE_CATEGORY category ) const;
+        // Draws a tile that was found, after the subtile was picked.
+        bool draw_found_tile( const tile_lookup_res &res, TILE_CATEGORY category, const tripoint &pos,
+                              int rota, lit_level ll, bool apply_night_vision_goggles, int &height_3d );
         bool draw_sprite_at(
             const tile_type &tile, const weighted_int_list<std::vector<int>> &svlist,
             const point &, unsigned int loc_rand, bool rota_fg, int rota, lit_level ll,
@@ -503,11 +577,25 @@ class cata_tiles
         /** Lighting */
         void init_light();
 
+        cached_tile &get_cached_tile( std::vector<cached_tile> &cache, int index );
+        // Drops the cached tile lookups, they depend on the tileset, the game data and the season.
+        void clear_tile_lookups();
+
         /** Variables */
         const SDL_Renderer_Ptr &renderer;
         const GeometryRenderer_Ptr &geometry;
         std::unique_ptr<tileset> tileset_ptr;
 
+        // Indexed by ter_id, furn_id, trap_id and field_type_id.
+        std::vector<cached_tile> cached_terrain;
+        std::vector<cached_tile> cached_furniture;
+        std::vector<cached_tile> cached_traps;
+        std::vector<cached_tile> cached_fields;
+        std::unordered_map<const itype *, cached_tile> cached_items;
+        season_type cached_tiles_season = SPRING;
+
+        tile_frame_cache frame_cache;
+
         int tile_height = 0;
         int tile_width = 0;
         // The width and height of the area we can draw in,
@@ -3601,23 +3601,26 @@ bool Character::is_wearing_on_bp( const itype_id &it, const bodypart_id &bp ) co
 
 bool Character::worn_with_flag( const std::string &flag, const bodypart_id &bp ) const
 {
-    return std::any_of( worn.begin(), worn.end(), [&flag, bp]( const item & it ) {
-        return it.has_flag( flag ) && ( bp == bodypart_id( "bp_null" ) || it.covers( bp ) );
+    const flag_id id( flag );
+    return std::any_of( worn.begin(), worn.end(), [&id, bp]( const item & it ) {
+        return it.has_flag( id ) && ( bp == bodypart_id( "bp_null" ) || it.covers( bp ) );
     } );
 }
 
 bool Character::worn_with_flag( const std::string &flag ) const
 {
-    return std::any_of( worn.begin(), worn.end(), [&flag]( const item & it ) {
-        return it.has_flag( flag ) ;
+    const flag_id id( flag );
+    return std::any_of( worn.begin(), worn.end(), [&id]( const item & it ) {
+        return it.has_flag( id ) ;
     } );
 }
 
 item Character::item_worn_with_flag( const std::string &flag, const bodypart_id &bp ) const
 {
+    const flag_id id( flag );
     item it_with_flag;
     for( const item &it : worn ) {
-        if( it.has_flag( flag ) && ( bp == bodypart_id( "bp_null" ) || it.covers( bp ) ) ) {
+        if( it.has_flag( id ) && ( bp == bodypart_id( "bp_null" ) || it.covers( bp ) ) ) {
             it_with_flag = it;
             break;
         }
@@ -3627,9 +3630,10 @@ item Character::item_worn_with_flag( const std::string &flag, const bodypart_id
 
 item Character::item_worn_with_flag( const std::string &flag ) const
 {
+    const flag_id id( flag );
     item it_with_flag;
     for( const item &it : worn ) {
-        if( it.has_flag( flag ) ) {
+        if( it.has_flag( id ) ) {
             it_with_flag = it;
             break;
         }
@@ -4373,11 +4377,12 @@ void Character::mut_cbm_encumb( std::map<bodypart_id, encumbrance_data> &vals )
 
 body_part_set Character::exclusive_flag_coverage( const std::string &flag ) const
 {
+    const flag_id id( flag );
     body_part_set ret;
     ret.fill( get_all_body_parts() );
 
     for( const item &elem : worn ) {
-        if( !elem.has_flag( flag ) ) {
+        if( !elem.has_flag( id ) ) {
             // Unset the parts covered by this item
             ret.substract_set( elem.get_covered_body_parts() );
         }
@@ -9721,6 +9726,7 @@ std::vector<item *> Character::inv_dump()
 
 bool Character::covered_with_flag( const std::string &flag, const body_part_set &parts ) const
 {
+    const flag_id id( flag );
     if( parts.none() ) {
         return true;
     }
@@ -9728,7 +9734,7 @@ bool Character::covered_with_flag( const std::string &flag, const body_part_set
     body_part_set to_cover( parts );
 
     for( const auto &elem : worn ) {
-        if( !elem.has_flag( flag ) ) {
+        if( !elem.has_flag( id ) ) {
             continue;
         }
 
@@ -10205,9 +10211,10 @@ int Character::warmth( const bodypart_id &bp ) const
 
 static int bestwarmth( const std::list< item > &its, const std::string &flag )
 {
+    const flag_id id( flag );
     int best = 0;
     for( const item &w : its ) {
-        if( w.has_flag( flag ) && w.get_warmth() > best ) {
+        if( w.has_flag( id ) && w.get_warmth() > best ) {
             best = w.get_warmth();
         }
     }
@@ -10376,18 +10383,20 @@ bool Character::in_sleep_state() const
 
 bool Character::has_item_with_flag( const std::string &flag, bool need_charges ) const
 {
-    return has_item_with( [&flag, &need_charges]( const item & it ) {
+    const flag_id id( flag );
+    return has_item_with( [&id, &need_charges]( const item & it ) {
         if( it.is_tool() && need_charges ) {
-            return it.has_flag( flag ) && it.type->tool->max_charges ? it.charges > 0 : it.has_flag( flag );
+            return it.has_flag( id ) && it.type->tool->max_charges ? it.charges > 0 : it.has_flag( id );
         }
-        return it.has_flag( flag );
+        return it.has_flag( id );
     } );
 }
 
 std::vector<const item *> Character::all_items_with_flag( const std::string &flag ) const
 {
-    return items_with( [&flag]( const item & it ) {
-        return it.has_flag( flag );
+    const flag_id id( flag );
+    return items_with( [&id]( const item & it ) {
+        return it.has_flag( id );
     } );
 }
 
@@ -7,6 +7,7 @@
 #include <utility>
 
 #include "debug.h"
+#include "monfaction.h"
 #include "mongroup.h"
 #include "monster.h"
 #include "mtype.h"
@@ -15,22 +16,187 @@
 
 #define dbg(x) DebugLog((x),D_GAME) << __FILE__ << ":" << __LINE__ << ": "
 
+static const mfaction_str_id monfaction_player( "player" );
+
+monster_location_index::monster_location_index() : buckets( MAPSIZE * MAPSIZE * OVERMAP_LAYERS )
+{
+}
+
+const shared_ptr_fast<monster> *monster_location_index::find( const tripoint &pos ) const
+{
+    if( !in_bubble( pos ) ) {
+        const auto iter = outside.find( pos );
+        return iter == outside.end() ? nullptr : &iter->second;
+    }
+    for( const entry &e : buckets[bucket_index( pos )] ) {
+        if( e.pos == pos ) {
+            return &e.critter;
+        }
+    }
+    return nullptr;
+}
+
+void monster_location_index::insert( const tripoint &pos, const shared_ptr_fast<monster> &critter )
+{
+    if( !in_bubble( pos ) ) {
+        outside[pos] = critter;
+        return;
+    }
+    std::vector<entry> &bucket = buckets[bucket_index( pos )];
+    for( entry &e : bucket ) {
+        if( e.pos == pos ) {
+            e.critter = critter;
+            return;
+        }
+    }
+    bucket.push_back( entry{ pos, critter } );
+}
+
+shared_ptr_fast<monster> monster_location_index::erase( const tripoint &pos )
+{
+    shared_ptr_fast<monster> ret;
+    if( !in_bubble( pos ) ) {
+        const auto iter = outside.find( pos );
+        if( iter != outside.end() ) {
+            ret = std::move( iter->second );
+            outside.erase( iter );
+        }
+        return ret;
+    }
+    std::vector<entry> &bucket = buckets[bucket_index( pos )];
+    for( entry &e : bucket ) {
+        if( e.pos == pos ) {
+            ret = std::move( e.critter );
+            e = std::move( bucket.back() );
+            bucket.pop_back();
+            break;
+        }
+    }
+    return ret;
+}
+
+void monster_location_index::erase( const monster &critter, const tripoint &pos )
+{
+    const shared_ptr_fast<monster> *at_pos = find( pos );
+    if( at_pos && at_pos->get() == &critter ) {
+        erase( pos );
+        return;
+    }
+
+    // When it's not in the index at its current location, it might still be there under
+    // another location, so look for it.
+    for( std::vector<entry> &bucket : buckets ) {
+        const auto iter = std::find_if( bucket.begin(), bucket.end(), [&]( const entry & e ) {
+            return e.critter.get() == &critter;
+        } );
+        if( iter != bucket.end() ) {
+            *iter = std::move( bucket.back() );
+            bucket.pop_back();
+            return;
+        }
+    }
+    const auto iter = std::find_if( outside.begin(), outside.end(),
+    [&]( const decltype( outside )::value_type & v ) {
+        return v.second.get() == &critter;
+    } );
+    if( iter != outside.end() ) {
+        outside.erase( iter );
+    }
+}
+
+void monster_location_index::clear()
+{
+    for( std::vector<entry> &bucket : buckets ) {
+        bucket.clear();
+    }
+    outside.clear();
+}
+
 Creature_tracker::Creature_tracker() = default;
 
 Creature_tracker::~Creature_tracker() = default;
 
 shared_ptr_fast<monster> Creature_tracker::find( const tripoint &pos ) const
 {
-    const auto iter = monsters_by_location.find( pos );
-    if( iter != monsters_by_location.end() ) {
-        const shared_ptr_fast<monster> &mon_ptr = iter->second;
-        if( !mon_ptr->is_dead() ) {
-            return mon_ptr;
-        }
+    const shared_ptr_fast<monster> *mon_ptr = monsters_by_location.find( pos );
+    if( mon_ptr && !( *mon_ptr )->is_dead() ) {
+        return *mon_ptr;
     }
     return nullptr;
 }
 
+std::vector<monster *> Creature_tracker::find_all_near( const tripoint &center, const int radius,
+        const int radiusz ) const
+{
+    std::vector<monster *> ret;
+    monsters_by_location.for_each_near( center, radius, radiusz,
+    [&ret]( const monster_location_index::entry & e ) {
+        if( !e.critter->is_dead() ) {
+            ret.push_back( e.critter.get() );
+        }
+    } );
+    return ret;
+}
+
+std::vector<monster *> Creature_tracker::find_hostile_near( const mfaction_id &faction,
+        const tripoint &center, const int radius ) const
+{
+    const monfaction &fac = faction.obj();
+    // There are only a few factions around, so their attitudes are looked up once each.
+    std::vector<std::pair<mfaction_id, bool>> hostile;
+    std::vector<monster *> ret;
+    monsters_by_location.for_each_near( center, radius, radius,
+    [&]( const monster_location_index::entry & e ) {
+        monster &critter = *e.critter;
+        if( critter.is_dead() ) {
+            return;
+        }
+        const mfaction_id other = critter.friendly == 0 ? critter.faction : monfaction_player.id();
+        auto iter = std::find_if( hostile.begin(), hostile.end(),
+        [&other]( const std::pair<mfaction_id, bool> &h ) {
+            return h.first == other;
+        } );
+        if( iter == hostile.end() ) {
+            const mf_attitude att = fac.attitude( other );
+            hostile.emplace_back( other, att != MFA_NEUTRAL && att != MFA_FRIENDLY );
+            iter = hostile.end() - 1;
+        }
+        if( iter->second ) {
+            ret.push_back( &critter );
+        }
+    } );
+    return ret;
+}
+
+std::vector<monster *> Creature_tracker::find_faction_near( const mfaction_id &faction,
+        const tripoint &center, const int radius ) const
+{
+    std::vector<monster *> ret;
+    monsters_by_location.for_each_near( center, radius, radius,
+    [&]( const monster_location_index::entry & e ) {
+        monster &critter = *e.critter;
+        if( !critter.is_dead() &&
+            ( critter.friendly == 0 ? critter.faction : monfaction_player.id() ) == faction ) {
+            ret.push_back( &critter );
+        }
+    } );
+    return ret;
+}
+
+const std::vector<monster *> &Creature_tracker::find_all_of_type( const mtype_id &type )
+{
+    if( !monsters_by_type_valid ) {
+        monsters_by_type.clear();
+        for( const shared_ptr_fast<monster> &mon_ptr : monsters_list ) {
+            monsters_by_type[mon_ptr->type->id].push_back( mon_ptr.get() );
+        }
+        monsters_by_type_valid = true;
+    }
+    static const std::vector<monster *> none;
+    const auto iter = monsters_by_type.find( type );
+    return iter == monsters_by_type.end() ? none : iter->second;
+}
+
 int Creature_tracker::temporary_id( const monster &critter ) const
 {
     const auto iter = std::find_if( monsters_list.begin(), monsters_list.end(),
@@ -85,7 +251,8 @@ bool Creature_tracker::add( const shared_ptr_fast<monster> &critter_ptr )
     }
 
     monsters_list.emplace_back( critter_ptr );
-    monsters_by_location[critter.pos()] = critter_ptr;
+    monsters_by_type_valid = false;
+    monsters_by_location.insert( critter.pos(), critter_ptr );
     add_to_faction_map( critter_ptr );
     return true;
 }
@@ -97,10 +264,24 @@ void Creature_tracker::add_to_faction_map( const shared_ptr_fast<monster> &critt
 
     // Only 1 faction per mon at the moment.
     if( critter.friendly == 0 ) {
-        monster_faction_map_[ critter.faction ].insert( critter_ptr );
+        monster_faction_map_[ critter.faction ].push_back( critter_ptr );
     } else {
-        static const mfaction_str_id playerfaction( "player" );
-        monster_faction_map_[ playerfaction ].insert( critter_ptr );
+        monster_faction_map_[ monfaction_player ].push_back( critter_ptr );
+    }
+}
+
+void Creature_tracker::remove_from_faction_map( const monster &critter )
+{
+    for( auto &pair : monster_faction_map_ ) {
+        std::vector<shared_ptr_fast<monster>> &members = pair.second;
+        const auto iter = std::find_if( members.begin(), members.end(),
+        [&]( const shared_ptr_fast<monster> &ptr ) {
+            return ptr.get() == &critter;
+        } );
+        if( iter != members.end() ) {
+            members.erase( iter );
+            return;
+        }
     }
 }
 
@@ -136,7 +317,7 @@ bool Creature_tracker::update_pos( const monster &critter, const tripoint &new_p
     } );
     if( iter != monsters_list.end() ) {
         monsters_by_location.erase( critter.pos() );
-        monsters_by_location[new_pos] = *iter;
+        monsters_by_location.insert( new_pos, *iter );
         return true;
     } else {
         const tripoint &old_pos = critter.pos();
@@ -153,21 +334,7 @@ bool Creature_tracker::update_pos( const monster &critter, const tripoint &new_p
 
 void Creature_tracker::remove_from_location_map( const monster &critter )
 {
-    const auto pos_iter = monsters_by_location.find( critter.pos() );
-    if( pos_iter != monsters_by_location.end() && pos_iter->second.get() == &critter ) {
-        monsters_by_location.erase( pos_iter );
-        return;
-    }
-
-    // When it's not in the map at its current location, it might still be there under,
-    // another location, so look for it.
-    const auto iter = std::find_if( monsters_by_location.begin(), monsters_by_location.end(),
-    [&]( const decltype( monsters_by_location )::value_type & v ) {
-        return v.second.get() == &critter;
-    } );
-    if( iter != monsters_by_location.end() ) {
-        monsters_by_location.erase( iter );
-    }
+    monsters_by_location.erase( critter, critter.pos() );
 }
 
 void Creature_tracker::remove( const monster &critter )
@@ -181,18 +348,11 @@ void Creature_tracker::remove( const monster &critter )
         return;
     }
 
-    for( auto &pair : monster_faction_map_ ) {
-        const auto fac_iter = pair.second.find( *iter );
-        if( fac_iter != pair.second.end() ) {
-            // Need to do this manually because the shared pointer containing critter is kept valid
-            // within removed_ and so the weak pointer in monster_faction_map_ is also valid.
-            pair.second.erase( fac_iter );
-            break;
-        }
-    }
+    remove_from_faction_map( critter );
     remove_from_location_map( critter );
     removed_.push_back( *iter );
     monsters_list.erase( iter );
+    monsters_by_type_valid = false;
 }
 
 void Creature_tracker::clear()
@@ -200,6 +360,7 @@ void Creature_tracker::clear()
     monsters_list.clear();
     monsters_by_location.clear();
     monster_faction_map_.clear();
+    monsters_by_type_valid = false;
     removed_.clear();
 }
 
@@ -207,8 +368,9 @@ void Creature_tracker::rebuild_cache()
 {
     monsters_by_location.clear();
     monster_faction_map_.clear();
+    monsters_by_type_valid = false;
     for( const shared_ptr_fast<monster> &mon_ptr : monsters_list ) {
-        monsters_by_location[mon_ptr->pos()] = mon_ptr;
+        monsters_by_location.insert( mon_ptr->pos(), mon_ptr );
         add_to_faction_map( mon_ptr );
     }
 }
@@ -220,21 +382,8 @@ void Creature_tracker::swap_positions( monster &first, monster &second )
     }
 
     // Either of them may be invalid!
-    const auto first_iter = monsters_by_location.find( first.pos() );
-    const auto second_iter = monsters_by_location.find( second.pos() );
-    // implied: first_iter != second_iter
-
-    shared_ptr_fast<monster> first_ptr;
-    if( first_iter != monsters_by_location.end() ) {
-        first_ptr = first_iter->second;
-        monsters_by_location.erase( first_iter );
-    }
-
-    shared_ptr_fast<monster> second_ptr;
-    if( second_iter != monsters_by_location.end() ) {
-        second_ptr = second_iter->second;
-        monsters_by_location.erase( second_iter );
-    }
+    const shared_ptr_fast<monster> first_ptr = monsters_by_location.erase( first.pos() );
+    const shared_ptr_fast<monster> second_ptr = monsters_by_location.erase( second.pos() );
     // implied: (first_ptr != second_ptr) or (first_ptr == nullptr && second_ptr == nullptr)
 
     tripoint temp = second.pos();
@@ -243,10 +392,10 @@ void Creature_tracker::swap_positions( monster &first, monster &second )
 
     // If the pointers have been taken out of the list, put them back in.
     if( first_ptr ) {
-        monsters_by_location[first.pos()] = first_ptr;
+        monsters_by_location.insert( first.pos(), first_ptr );
     }
     if( second_ptr ) {
-        monsters_by_location[second.pos()] = second_ptr;
+        monsters_by_location.insert( second.pos(), second_ptr );
     }
 }
 
@@ -280,12 +429,15 @@ void Creature_tracker::remove_dead()
     for( auto iter = monsters_list.begin(); iter != monsters_list.end(); ) {
         const monster &critter = **iter;
         if( critter.is_dead() ) {
+            remove_from_faction_map( critter );
             remove_from_location_map( critter );
             iter = monsters_list.erase( iter );
         } else {
             ++iter;
         }
     }
+    // Monsters may also have changed their type.
+    monsters_by_type_valid = false;
 
     removed_.clear();
 }
@@ -2,12 +2,14 @@
 #ifndef CATA_SRC_CREATURE_TRACKER_H
 #define CATA_SRC_CREATURE_TRACKER_H
 
+#include <algorithm>
 #include <cstddef>
+#include <cstdlib>
 #include <memory>
 #include <unordered_map>
-#include <set>
 #include <vector>
 
+#include "game_constants.h"
 #include "point.h"
 #include "type_id.h"
 #include "memory_fast.h"
@@ -16,23 +18,93 @@ class monster;
 class JsonIn;
 class JsonOut;
 
+/**
+ * Monsters of the reality bubble by their position. The positions are put into one
+ * bucket per submap and z-level, kept in a flat array, so finding the monster on a tile
+ * only looks at the few monsters of that submap, and area queries only visit the submaps
+ * they overlap. Positions outside of the reality bubble (which monsters only have while
+ * the map is shifted) are kept in a separate map.
+ */
+class monster_location_index
+{
+    public:
+        struct entry {
+            tripoint pos;
+            shared_ptr_fast<monster> critter;
+        };
+
+        monster_location_index();
+
+        /** The monster at the position, dead or alive, or nullptr if there is none. */
+        const shared_ptr_fast<monster> *find( const tripoint &pos ) const;
+        /** Puts the monster at the position, replacing any other monster there. */
+        void insert( const tripoint &pos, const shared_ptr_fast<monster> &critter );
+        /** Removes and returns the monster at the position (nullptr if there is none). */
+        shared_ptr_fast<monster> erase( const tripoint &pos );
+        /**
+         * Removes the monster, looking for it at @p pos first and everywhere else if
+         * it's not there.
+         */
+        void erase( const monster &critter, const tripoint &pos );
+        void clear();
+
+        /**
+         * Calls @p f with each @ref entry no further than @p radius away from @p center
+         * horizontally and @p radiusz vertically (in a box, not a circle).
+         */
+        template<typename F>
+        void for_each_near( const tripoint &center, int radius, int radiusz, F &&f ) const {
+            const tripoint lo = clamp_to_bubble( center - tripoint( radius, radius, radiusz ) );
+            const tripoint hi = clamp_to_bubble( center + tripoint( radius, radius, radiusz ) );
+            const auto in_range = [&]( const tripoint & p ) {
+                return std::abs( p.x - center.x ) <= radius && std::abs( p.y - center.y ) <= radius &&
+                       std::abs( p.z - center.z ) <= radiusz;
+            };
+            for( int z = lo.z; z <= hi.z; z++ ) {
+                for( int y = lo.y / SEEY; y <= hi.y / SEEY; y++ ) {
+                    for( int x = lo.x / SEEX; x <= hi.x / SEEX; x++ ) {
+                        for( const entry &e : buckets[bucket_index( tripoint( x * SEEX, y * SEEY, z ) )] ) {
+                            if( in_range( e.pos ) ) {
+                                f( e );
+                            }
+                        }
+                    }
+                }
+            }
+            for( const auto &elem : outside ) {
+                if( in_range( elem.first ) ) {
+                    f( entry{ elem.first, elem.second } );
+                }
+            }
+        }
+
+    private:
+        static bool in_bubble( const tripoint &pos ) {
+            return pos.x >= 0 && pos.x < MAPSIZE_X && pos.y >= 0 && pos.y < MAPSIZE_Y &&
+                   pos.z >= -OVERMAP_DEPTH && pos.z <= OVERMAP_HEIGHT;
+        }
+        static tripoint clamp_to_bubble( const tripoint &pos ) {
+            return tripoint( std::max( 0, std::min( pos.x, MAPSIZE_X - 1 ) ),
+                             std::max( 0, std::min( pos.y, MAPSIZE_Y - 1 ) ),
+                             std::max( -OVERMAP_DEPTH, std::min( pos.z, OVERMAP_HEIGHT ) ) );
+        }
+        // Only for positions in the bubble.
+        static size_t bucket_index( const tripoint &pos ) {
+            return ( ( pos.z + OVERMAP_DEPTH ) * MAPSIZE + pos.y / SEEY ) * MAPSIZE + pos.x / SEEX;
+        }
+
+        std::vector<std::vector<entry>> buckets;
+        std::unordered_map<tripoint, shared_ptr_fast<monster>> outside;
+};
+
 class Creature_tracker
 {
     private:
 
         void add_to_faction_map( const shared_ptr_fast<monster> &critter );
+        void remove_from_faction_map( const monster &critter );
 
-        class weak_ptr_comparator
-        {
-            public:
-                bool operator()( const weak_ptr_fast<monster> &lhs,
-                                 const weak_ptr_fast<monster> &rhs ) const {
-                    return lhs.lock().get() < rhs.lock().get();
-                }
-        };
-
-        std::unordered_map<mfaction_id, std::set<weak_ptr_fast<monster>, weak_ptr_comparator>>
-                monster_faction_map_;
+        std::unordered_map<mfaction_id, std::vector<shared_ptr_fast<monster>>> monster_faction_map_;
 
         /**
          * Creatures that get removed via @ref remove are stored here until the end of the turn.
@@ -84,6 +156,30 @@ class Creature_tracker
             return monsters_list;
         }
 
+        /**
+         * Living monsters no further than @p radius away from @p center horizontally and
+         * @p radiusz vertically, measured as a box. Callers check the exact distance.
+         */
+        std::vector<monster *> find_all_near( const tripoint &center, int radius, int radiusz ) const;
+        /**
+         * Like @ref find_all_near (with the same radius vertically), but only monsters
+         * that @p faction is hostile to, i.e. neither neutral nor friendly.
+         */
+        std::vector<monster *> find_hostile_near( const mfaction_id &faction, const tripoint &center,
+                int radius ) const;
+        /**
+         * Like @ref find_hostile_near, but only monsters of @p faction (friendly monsters
+         * count as the player's faction).
+         */
+        std::vector<monster *> find_faction_near( const mfaction_id &faction, const tripoint &center,
+                int radius ) const;
+        /**
+         * Monsters of the given type, in the order of the monster list. Dead monsters may be
+         * among them. The lists are gathered at most once per change of the monster list,
+         * which happens a few times per turn at most, instead of every time a monster plans.
+         */
+        const std::vector<monster *> &find_all_of_type( const mtype_id &type );
+
         void serialize( JsonOut &jsout ) const;
         void deserialize( JsonIn &jsin );
 
@@ -93,7 +189,10 @@ class Creature_tracker
 
     private:
         std::vector<shared_ptr_fast<monster>> monsters_list;
-        std::unordered_map<tripoint, shared_ptr_fast<monster>> monsters_by_location;
+        monster_location_index monsters_by_location;
+        /** See @ref find_all_of_type, only valid while @ref monsters_by_type_valid is set. */
+        std::unordered_map<mtype_id, std::vector<monster *>> monsters_by_type;
+        bool monsters_by_type_valid = false;
         /** Remove the monsters entry in @ref monsters_by_location */
         void remove_from_location_map( const monster &critter );
 };
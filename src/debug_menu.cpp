@@ -55,6 +55,7 @@
 #include "item_location.h"
 #include "magic.h"
 #include "map.h"
+#include "map_iterator.h"
 #include "map_extras.h"
 #include "mapgen.h"
 #include "mapgendata.h"
@@ -80,6 +81,7 @@
 #include "player.h"
 #include "pldata.h"
 #include "point.h"
+#include "pool_allocator.h"
 #include "popup.h"
 #include "recipe_dictionary.h"
 #include "rng.h"
@@ -90,6 +92,7 @@
 #include "string_input_popup.h"
 #include "trait_group.h"
 #include "translations.h"
+#include "turn_profiler.h"
 #include "type_id.h"
 #include "ui.h"
 #include "ui_manager.h"
@@ -98,6 +101,7 @@
 #include "veh_type.h"
 #include "vitamin.h"
 #include "vpart_position.h"
+#include "vpart_range.h"
 #include "weather.h"
 #include "weather_gen.h"
 
@@ -183,6 +187,8 @@ std::string enum_to_string<debug_menu::debug_menu_index>( debug_menu::debug_menu
         case debug_menu::debug_menu_index::TEST_MAP_EXTRA_DISTRIBUTION: return "TEST_MAP_EXTRA_DISTRIBUTION";
         case debug_menu::debug_menu_index::NESTED_MAPGEN: return "NESTED_MAPGEN";
         case debug_menu::debug_menu_index::VEHICLE_BATTERY_CHARGE: return "VEHICLE_BATTERY_CHARGE";
+        case debug_menu::debug_menu_index::TURN_PROFILER: return "TURN_PROFILER";
+        case debug_menu::debug_menu_index::ITEM_MEMORY: return "ITEM_MEMORY";
         // *INDENT-ON*
         case debug_menu::debug_menu_index::last:
             break;
@@ -256,6 +262,8 @@ static int info_uilist( bool display_all_entries = true )
             { uilist_entry( debug_menu_index::DISPLAY_RADIATION, true, 'R', _( "Toggle display radiation" ) ) },
             { uilist_entry( debug_menu_index::SHOW_MUT_CAT, true, 'm', _( "Show mutation category levels" ) ) },
             { uilist_entry( debug_menu_index::BENCHMARK, true, 'b', _( "Draw benchmark (X seconds)" ) ) },
+            { uilist_entry( debug_menu_index::TURN_PROFILER, true, 'p', _( "Turn profiler" ) ) },
+            { uilist_entry( debug_menu_index::ITEM_MEMORY, true, 'I', _( "Item memory report" ) ) },
             { uilist_entry( debug_menu_index::TRAIT_GROUP, true, 't', _( "Test trait group" ) ) },
             { uilist_entry( debug_menu_index::DISPLAY_NPC_PATH, true, 'n', _( "Toggle NPC pathfinding on map" ) ) },
             { uilist_entry( debug_menu_index::PRINT_FACTION_INFO, true, 'f', _( "Print faction info to console" ) ) },
@@ -1212,6 +1220,131 @@ void draw_benchmark( const int max_difference )
              difference / 1000.0, 1000.0 * draw_counter / static_cast<double>( difference ) );
 }
 
+void turn_profiler_menu()
+{
+    enum {
+        PROFILER_TOGGLE,
+        PROFILER_SHOW,
+        PROFILER_RESET,
+        PROFILER_JSON,
+        PROFILER_CSV,
+    };
+    uilist pmenu;
+    pmenu.text = string_format( _( "Turn profiler is %s, %d turns recorded." ),
+                                turn_profiler::enabled() ? _( "enabled" ) : _( "disabled" ),
+                                turn_profiler::recorded_turns() );
+    pmenu.addentry( PROFILER_TOGGLE, true, 'e', turn_profiler::enabled() ?
+                    _( "Disable profiling" ) : _( "Enable profiling" ) );
+    pmenu.addentry( PROFILER_SHOW, true, 's', _( "Show per-phase turn times" ) );
+    pmenu.addentry( PROFILER_RESET, true, 'r', _( "Reset collected data" ) );
+    pmenu.addentry( PROFILER_JSON, true, 'j', _( "Export to JSON" ) );
+    pmenu.addentry( PROFILER_CSV, true, 'c', _( "Export to CSV" ) );
+    pmenu.query();
+
+    switch( pmenu.ret ) {
+        case PROFILER_TOGGLE:
+            turn_profiler::set_enabled( !turn_profiler::enabled() );
+            break;
+        case PROFILER_SHOW: {
+            const auto new_win = []() {
+                return catacurses::newwin( FULL_SCREEN_HEIGHT, FULL_SCREEN_WIDTH,
+                                           point( std::max( 0, ( TERMX - FULL_SCREEN_WIDTH ) / 2 ),
+                                                  std::max( 0, ( TERMY - FULL_SCREEN_HEIGHT ) / 2 ) ) );
+            };
+            const los_cache::statistics &los = get_map().sees_cache_stats();
+            const std::string los_report = string_format(
+                                               _( "Line of sight cache: %llu lookups, %.1f%% hits, %llu stored, %llu evicted" ),
+                                               static_cast<unsigned long long>( los.lookups ),
+                                               los.lookups == 0 ? 0.0 : 100.0 * los.hits / los.lookups,
+                                               static_cast<unsigned long long>( los.stores ),
+                                               static_cast<unsigned long long>( los.evictions ) );
+            scrollable_text( new_win, _( "Turn profile" ),
+                             turn_profiler::format_report() + "\n" + los_report );
+            break;
+        }
+        case PROFILER_RESET:
+            turn_profiler::reset();
+            get_map().reset_sees_cache_stats();
+            break;
+        case PROFILER_JSON:
+        case PROFILER_CSV: {
+            const bool json = pmenu.ret == PROFILER_JSON;
+            const std::string path = PATH_INFO::config_dir() +
+                                     ( json ? "turn_profile.json" : "turn_profile.csv" );
+            const bool written = write_to_file( path, [&]( std::ostream & fout ) {
+                if( json ) {
+                    turn_profiler::write_json( fout );
+                } else {
+                    turn_profiler::write_csv( fout );
+                }
+            }, _( "turn profile" ) );
+            if( written ) {
+                popup( _( "Turn profile written to %s" ), path );
+            }
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+void item_memory_report()
+{
+    int items = 0;
+    int with_extra = 0;
+    // Every item adds its share of the block it uses.
+    double extra_blocks = 0;
+    const auto count = [&]( const item * it ) {
+        ++items;
+        if( const long users = it->extra_data_use_count() ) {
+            ++with_extra;
+            extra_blocks += 1.0 / users;
+        }
+        return VisitResponse::NEXT;
+    };
+
+    map &here = get_map();
+    for( const tripoint &p : here.points_on_zlevel() ) {
+        for( const item &it : here.i_at( p ) ) {
+            it.visit_items( count );
+        }
+    }
+    for( wrapped_vehicle &veh : here.get_vehicles() ) {
+        for( const vpart_reference &vp : veh.v->get_any_parts( VPFLAG_CARGO ) ) {
+            for( const item &it : veh.v->get_items( vp.part_index() ) ) {
+                it.visit_items( count );
+            }
+        }
+    }
+    get_avatar().visit_items( count );
+
+    const size_t kib = 1024;
+    const size_t items_size = items * sizeof( item );
+    const size_t extra_size = static_cast<size_t>( extra_blocks + 0.5 ) * item::extra_data_size();
+    const size_t inline_size = items * ( item::extra_data_size() - sizeof( std::shared_ptr<void> ) );
+    std::string report = string_format( _( "Items on the map, in vehicles and on you: %d\n" ), items );
+    report += string_format( _( "Item size: %d bytes, %d KiB in total\n" ), sizeof( item ),
+                             items_size / kib );
+    report += string_format( _( "Items with item specific state: %d, sharing %d blocks of %d bytes, "
+                                "%d KiB in total\n" ), with_extra, static_cast<int>( extra_blocks + 0.5 ),
+                             item::extra_data_size(), extra_size / kib );
+    report += string_format( _( "Kept inline, that state would take another %d KiB\n" ),
+                             inline_size / kib );
+
+    const cata::memory_pool::statistics &pool = cata::memory_pool::stats();
+    report += string_format( _( "\nItem storage pool: %d KiB in use, %d KiB kept for reuse\n" ),
+                             pool.bytes_in_use / kib, pool.bytes_pooled / kib );
+    report += string_format( _( "%d blocks allocated, %d of them reused, %d given back\n" ),
+                             pool.allocations, pool.reused, pool.deallocations );
+
+    const auto new_win = []() {
+        return catacurses::newwin( FULL_SCREEN_HEIGHT, FULL_SCREEN_WIDTH,
+                                   point( std::max( 0, ( TERMX - FULL_SCREEN_WIDTH ) / 2 ),
+                                          std::max( 0, ( TERMY - FULL_SCREEN_HEIGHT ) / 2 ) ) );
+    };
+    scrollable_text( new_win, _( "Item memory" ), report );
+}
+
 void debug()
 {
     bool debug_menu_has_hotkey = hotkey_for_action( ACTION_DEBUG, false ) != -1;
@@ -1224,6 +1357,8 @@ void debug()
         debug_menu_index::GAME_REPORT,
         debug_menu_index::ENABLE_ACHIEVEMENTS,
         debug_menu_index::BENCHMARK,
+        debug_menu_index::TURN_PROFILER,
+        debug_menu_index::ITEM_MEMORY,
         debug_menu_index::SHOW_MSG,
     };
     bool should_disable_achievements = action && !non_cheaty_options.count( *action );
@@ -1796,6 +1931,13 @@ void debug()
         }
         break;
 
+        case debug_menu_index::TURN_PROFILER:
+            debug_menu::turn_profiler_menu();
+            break;
+        case debug_menu_index::ITEM_MEMORY:
+            debug_menu::item_memory_report();
+            break;
+
         case debug_menu_index::OM_TELEPORT:
             debug_menu::teleport_overmap();
             break;
@@ -78,6 +78,8 @@ enum class debug_menu_index : int {
     TEST_MAP_EXTRA_DISTRIBUTION,
     NESTED_MAPGEN,
     VEHICLE_BATTERY_CHARGE,
+    TURN_PROFILER,
+    ITEM_MEMORY,
     last
 };
 
@@ -94,6 +96,8 @@ void wishmutate( player *p );
 void wishskill( player *p );
 void mutation_wish();
 void draw_benchmark( int max_difference );
+void turn_profiler_menu();
+void item_memory_report();
 
 void debug();
 
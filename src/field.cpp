@@ -150,6 +150,61 @@ field::field()
 {
 }
 
+field::field( const field &rhs ) : field()
+{
+    *this = rhs;
+}
+
+field::field( field &&rhs ) noexcept : field()
+{
+    *this = std::move( rhs );
+}
+
+field::~field() = default;
+
+field &field::operator=( const field &rhs )
+{
+    if( this == &rhs ) {
+        return *this;
+    }
+    clear();
+    entry_block *block = &_field_type_list;
+    size_t slot = 0;
+    for( const value_type &fld : rhs ) {
+        if( slot == slots_per_block ) {
+            block->next = std::make_unique<entry_block>();
+            block = block->next.get();
+            slot = 0;
+        }
+        block->slots[slot++].emplace( fld );
+        _field_count++;
+    }
+    _displayed_field_type = rhs._displayed_field_type;
+    return *this;
+}
+
+field &field::operator=( field &&rhs ) noexcept
+{
+    if( this == &rhs ) {
+        return *this;
+    }
+    // The first block is stored inline, its entries are copied (they are small), the
+    // other blocks are taken over.
+    clear();
+    for( size_t i = 0; i < slots_per_block; ++i ) {
+        if( rhs._field_type_list.slots[i] ) {
+            _field_type_list.slots[i].emplace( *rhs._field_type_list.slots[i] );
+            rhs._field_type_list.slots[i].reset();
+        }
+    }
+    _field_type_list.next = std::move( rhs._field_type_list.next );
+    _field_count = rhs._field_count;
+    _displayed_field_type = rhs._displayed_field_type;
+    rhs._field_count = 0;
+    rhs._displayed_field_type = fd_null;
+    return *this;
+}
+
 /*
 Function: find_field
 Returns a field entry corresponding to the field_type_id parameter passed in. If no fields are found then returns NULL.
@@ -157,18 +212,15 @@ Good for checking for existence of a field: if(myfield.find_field(fd_fire)) woul
 */
 field_entry *field::find_field( const field_type_id &field_type_to_find )
 {
-    const auto it = _field_type_list.find( field_type_to_find );
-    if( it != _field_type_list.end() ) {
-        return &it->second;
-    }
-    return nullptr;
+    return const_cast<field_entry *>( find_field_c( field_type_to_find ) );
 }
 
 const field_entry *field::find_field_c( const field_type_id &field_type_to_find ) const
 {
-    const auto it = _field_type_list.find( field_type_to_find );
-    if( it != _field_type_list.end() ) {
-        return &it->second;
+    for( const value_type &fld : *this ) {
+        if( fld.first == field_type_to_find ) {
+            return &fld.second;
+        }
     }
     return nullptr;
 }
@@ -189,40 +241,65 @@ Intensity defaults to 1, and age to 0 (permanent) if not specified.
 bool field::add_field( const field_type_id &field_type_to_add, const int new_intensity,
                        const time_duration &new_age )
 {
-    auto it = _field_type_list.find( field_type_to_add );
     if( field_type_to_add.obj().priority >= _displayed_field_type.obj().priority ) {
         _displayed_field_type = field_type_to_add;
     }
-    if( it != _field_type_list.end() ) {
+    if( field_entry *const existing = find_field( field_type_to_add ) ) {
         //Already exists, but lets update it. This is tentative.
-        it->second.set_field_intensity( it->second.get_field_intensity() + new_intensity );
+        existing->set_field_intensity( existing->get_field_intensity() + new_intensity );
         return false;
     }
-    _field_type_list[field_type_to_add] = field_entry( field_type_to_add, new_intensity, new_age );
-    return true;
+    // Take the first free slot, the entries already there must not move.
+    entry_block *block = &_field_type_list;
+    while( true ) {
+        for( cata::optional<value_type> &slot : block->slots ) {
+            if( !slot ) {
+                slot.emplace( field_type_to_add, field_entry( field_type_to_add, new_intensity, new_age ) );
+                _field_count++;
+                return true;
+            }
+        }
+        if( !block->next ) {
+            block->next = std::make_unique<entry_block>();
+        }
+        block = block->next.get();
+    }
 }
 
 bool field::remove_field( const field_type_id &field_to_remove )
 {
-    const auto it = _field_type_list.find( field_to_remove );
-    if( it == _field_type_list.end() ) {
-        return false;
+    for( iterator it = begin(); it != end(); ++it ) {
+        if( it->first == field_to_remove ) {
+            remove_field( it );
+            return true;
+        }
     }
-    remove_field( it );
-    return true;
+    return false;
 }
 
-void field::remove_field( std::map<field_type_id, field_entry>::iterator const it )
+void field::remove_field( const iterator it )
 {
-    _field_type_list.erase( it );
-    if( _field_type_list.empty() ) {
-        _displayed_field_type = fd_null;
-    } else {
-        _displayed_field_type = fd_null;
-        for( auto &fld : _field_type_list ) {
-            if( fld.first.obj().priority >= _displayed_field_type.obj().priority ) {
-                _displayed_field_type = fld.first;
-            }
+    // The slot stays where it is (and so do the blocks), so iterating on from here is fine.
+    it.block->slots[it.slot].reset();
+    _field_count--;
+    update_displayed_field_type();
+}
+
+void field::clear()
+{
+    for( cata::optional<value_type> &slot : _field_type_list.slots ) {
+        slot.reset();
+    }
+    _field_type_list.next.reset();
+    _field_count = 0;
+}
+
+void field::update_displayed_field_type()
+{
+    _displayed_field_type = fd_null;
+    for( const value_type &fld : *this ) {
+        if( fld.first.obj().priority >= _displayed_field_type.obj().priority ) {
+            _displayed_field_type = fld.first;
         }
     }
 }
@@ -233,27 +310,27 @@ Returns the number of fields existing on the current tile.
 */
 unsigned int field::field_count() const
 {
-    return _field_type_list.size();
+    return _field_count;
 }
 
-std::map<field_type_id, field_entry>::iterator field::begin()
+field::iterator field::begin()
 {
-    return _field_type_list.begin();
+    return iterator( &_field_type_list, 0 );
 }
 
-std::map<field_type_id, field_entry>::const_iterator field::begin() const
+field::const_iterator field::begin() const
 {
-    return _field_type_list.begin();
+    return const_iterator( &_field_type_list, 0 );
 }
 
-std::map<field_type_id, field_entry>::iterator field::end()
+field::iterator field::end()
 {
-    return _field_type_list.end();
+    return iterator();
 }
 
-std::map<field_type_id, field_entry>::const_iterator field::end() const
+field::const_iterator field::end() const
 {
-    return _field_type_list.end();
+    return const_iterator();
 }
 
 /*
@@ -273,7 +350,7 @@ description_affix field::displayed_description_affix() const
 int field::total_move_cost() const
 {
     int current_cost = 0;
-    for( const auto &fld : _field_type_list ) {
+    for( const value_type &fld : *this ) {
         current_cost += fld.second.move_cost();
     }
     return current_cost;
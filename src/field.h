@@ -2,14 +2,19 @@
 #ifndef CATA_SRC_FIELD_H
 #define CATA_SRC_FIELD_H
 
-#include <map>
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "calendar.h"
 #include "color.h"
 #include "enums.h"
 #include "field_type.h"
+#include "optional.h"
 #include "type_id.h"
 
 /**
@@ -127,11 +132,91 @@ class field_entry
  * Use @ref find_field to get the field entry of a specific type, or iterate over
  * all entries via @ref begin and @ref end (allows range based iteration).
  * There is @ref displayed_field_type to specific which field should be drawn on the map.
+ *
+ * The entries are stored inline in small blocks of slots, only squares with many fields
+ * allocate more blocks. Entries never move: adding or removing a field keeps pointers
+ * and iterators to all other entries valid, which the field processing relies on.
+ * Iteration is in slot order, not in order of the field types.
 */
 class field
 {
+    private:
+        struct entry_block;
+
+        template<typename Block, typename Value>
+        class iterator_impl
+        {
+            public:
+                using iterator_category = std::forward_iterator_tag;
+                using value_type = std::pair<const field_type_id, field_entry>;
+                using difference_type = std::ptrdiff_t;
+                using pointer = Value *;
+                using reference = Value &;
+
+                iterator_impl() = default;
+                iterator_impl( Block *block, size_t slot ) : block( block ), slot( slot ) {
+                    skip_empty();
+                }
+                // Allows conversion to const_iterator.
+                template<typename OtherBlock, typename OtherValue>
+                iterator_impl( const iterator_impl<OtherBlock, OtherValue> &other ) :
+                    block( other.block ), slot( other.slot ) {
+                }
+
+                reference operator*() const {
+                    return *block->slots[slot];
+                }
+                pointer operator->() const {
+                    return &**this;
+                }
+                iterator_impl &operator++() {
+                    ++slot;
+                    skip_empty();
+                    return *this;
+                }
+                iterator_impl operator++( int ) {
+                    iterator_impl ret = *this;
+                    ++*this;
+                    return ret;
+                }
+                bool operator==( const iterator_impl &rhs ) const {
+                    return block == rhs.block && ( block == nullptr || slot == rhs.slot );
+                }
+                bool operator!=( const iterator_impl &rhs ) const {
+                    return !( *this == rhs );
+                }
+            private:
+                friend class field;
+                template<typename, typename>
+                friend class iterator_impl;
+
+                void skip_empty() {
+                    while( block != nullptr ) {
+                        for( ; slot < block->slots.size(); ++slot ) {
+                            if( block->slots[slot] ) {
+                                return;
+                            }
+                        }
+                        block = block->next.get();
+                        slot = 0;
+                    }
+                }
+
+                Block *block = nullptr;
+                size_t slot = 0;
+        };
+
     public:
+        using value_type = std::pair<const field_type_id, field_entry>;
+        using iterator = iterator_impl<entry_block, value_type>;
+        using const_iterator = iterator_impl<const entry_block, const value_type>;
+
         field();
+        field( const field &rhs );
+        field( field &&rhs ) noexcept;
+        ~field();
+        field &operator=( const field &rhs );
+        field &operator=( field &&rhs ) noexcept;
 
         /**
          * Returns a field entry corresponding to the field_type_id parameter passed in.
@@ -168,9 +253,10 @@ class field
         bool remove_field( const field_type_id &field_to_remove );
         /**
          * Make sure to decrement the field counter in the submap.
-         * Removes the field entry, the iterator must point into @ref _field_type_list and must be valid.
+         * Removes the field entry, the iterator must point into this field and must be valid.
+         * Iterators to other entries stay valid.
          */
-        void remove_field( std::map<field_type_id, field_entry>::iterator );
+        void remove_field( iterator );
 
         // Returns the number of fields existing on the current tile.
         unsigned int field_count() const;
@@ -182,13 +268,13 @@ class field
 
         description_affix displayed_description_affix() const;
 
-        //Returns the vector iterator to begin searching through the list.
-        std::map<field_type_id, field_entry>::iterator begin();
-        std::map<field_type_id, field_entry>::const_iterator begin() const;
+        //Returns the iterator to begin searching through the list.
+        iterator begin();
+        const_iterator begin() const;
 
-        //Returns the vector iterator to end searching through the list.
-        std::map<field_type_id, field_entry>::iterator end();
-        std::map<field_type_id, field_entry>::const_iterator end() const;
+        //Returns the iterator to end searching through the list.
+        iterator end();
+        const_iterator end() const;
 
         /**
          * Returns the total move cost from all fields.
@@ -196,8 +282,19 @@ class field
         int total_move_cost() const;
 
     private:
-        // A pointer lookup table of all field effects on the current tile.
-        std::map<field_type_id, field_entry> _field_type_list;
+        // Most squares have one or two fields at most.
+        static constexpr size_t slots_per_block = 2;
+        struct entry_block {
+            std::array<cata::optional<value_type>, slots_per_block> slots;
+            std::unique_ptr<entry_block> next;
+        };
+
+        void clear();
+        void update_displayed_field_type();
+
+        // All field effects on the current tile.
+        entry_block _field_type_list;
+        unsigned int _field_count = 0;
         //_displayed_field_type currently is equal to the last field added to the square. You can modify this behavior in the class functions if you wish.
         field_type_id _displayed_field_type;
 };
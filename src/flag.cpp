@@ -1,12 +1,83 @@
 #include "flag.h"
 
+#include <deque>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "debug.h"
 #include "json.h"
 
 static std::unordered_map<std::string, json_flag> json_flags_all;
+// Same flags indexed by flag_id, null where a flag has no definition.
+static std::vector<const json_flag *> json_flags_by_index;
+
+namespace
+{
+struct flag_names {
+    std::unordered_map<std::string, int> index;
+    // deque, so the names returned by flag_id::str stay where they are
+    std::deque<std::string> names;
+};
+} // namespace
+
+// Function local, flag_ids are created during static initialization.
+static flag_names &get_flag_names()
+{
+    static flag_names names;
+    if( names.names.empty() ) {
+        names.names.emplace_back();
+        names.index.emplace( std::string(), 0 );
+    }
+    return names;
+}
+
+flag_id::flag_id( const std::string &name )
+{
+    flag_names &all = get_flag_names();
+    const auto iter = all.index.find( name );
+    if( iter != all.index.end() ) {
+        index_ = iter->second;
+        return;
+    }
+    index_ = static_cast<int>( all.names.size() );
+    all.names.push_back( name );
+    all.index.emplace( name, index_ );
+}
+
+const std::string &flag_id::str() const
+{
+    return get_flag_names().names[index_];
+}
+
+const json_flag &flag_id::obj() const
+{
+    return json_flag::get( *this );
+}
+
+std::pair<flag_set::iterator, bool> flag_set::insert( const std::string &name )
+{
+    const std::pair<iterator, bool> ret = names.insert( name );
+    if( ret.second ) {
+        const int index = flag_id( name ).index();
+        const size_t word = index / 64;
+        if( word >= bits.size() ) {
+            bits.resize( word + 1, 0 );
+        }
+        bits[word] |= uint64_t( 1 ) << ( index % 64 );
+    }
+    return ret;
+}
+
+flag_set::size_type flag_set::erase( const std::string &name )
+{
+    const size_type ret = names.erase( name );
+    if( ret != 0 ) {
+        const int index = flag_id( name ).index();
+        bits[index / 64] &= ~( uint64_t( 1 ) << ( index % 64 ) );
+    }
+    return ret;
+}
 
 const json_flag &json_flag::get( const std::string &id )
 {
@@ -15,10 +86,23 @@ const json_flag &json_flag::get( const std::string &id )
     return iter != json_flags_all.end() ? iter->second : null_flag;
 }
 
+const json_flag &json_flag::get( const flag_id &id )
+{
+    static json_flag null_flag;
+    const size_t index = id.index();
+    return index < json_flags_by_index.size() && json_flags_by_index[index] ?
+           *json_flags_by_index[index] : null_flag;
+}
+
 void json_flag::load( const JsonObject &jo )
 {
     auto id = jo.get_string( "id" );
     auto &f = json_flags_all.emplace( id, json_flag( id ) ).first->second;
+    const size_t index = flag_id( id ).index();
+    if( index >= json_flags_by_index.size() ) {
+        json_flags_by_index.resize( index + 1, nullptr );
+    }
+    json_flags_by_index[index] = &f;
 
     jo.read( "info", f.info_ );
     jo.read( "conflicts", f.conflicts_ );
@@ -48,4 +132,5 @@ void json_flag::check_consistency()
 void json_flag::reset()
 {
     json_flags_all.clear();
+    json_flags_by_index.clear();
 }
@@ -2,10 +2,129 @@
 #ifndef CATA_SRC_FLAG_H
 #define CATA_SRC_FLAG_H
 
+#include <algorithm>
+#include <cstdint>
 #include <set>
 #include <string>
+#include <utility>
+#include <vector>
+
+#include "flat_set.h"
 
 class JsonObject;
+class json_flag;
+
+/**
+ * Dense number of a flag name, assigned the first time the name is seen, so sets of
+ * flags can be kept as bitsets.  The numbers stay the same while the game runs, also
+ * when the flag definitions are reloaded, and flags without a definition get one too.
+ */
+class flag_id
+{
+    public:
+        /** The empty flag, never set on anything. */
+        flag_id() = default;
+        explicit flag_id( const std::string &name );
+
+        const std::string &str() const;
+        int index() const {
+            return index_;
+        }
+        /** The definition of the flag, or the null flag if there is none. */
+        const json_flag &obj() const;
+
+        bool operator==( const flag_id &rhs ) const {
+            return index_ == rhs.index_;
+        }
+        bool operator!=( const flag_id &rhs ) const {
+            return index_ != rhs.index_;
+        }
+
+    private:
+        int index_ = 0;
+};
+
+/**
+ * Sorted set of flag names that also keeps a bit per @ref flag_id, so checking for a
+ * flag is a bit test instead of string comparisons.  Otherwise it works like std::set,
+ * including the JSON (de)serialization.
+ */
+class flag_set
+{
+    public:
+        using key_type = std::string;
+        using value_type = std::string;
+        using size_type = size_t;
+        using const_iterator = cata::flat_set<std::string>::const_iterator;
+        using iterator = const_iterator;
+
+        flag_set() = default;
+        template<typename InputIt>
+        flag_set( InputIt first, InputIt last ) {
+            insert( first, last );
+        }
+        // Implicit, JsonObject::get_tags returns a std::set.
+        flag_set( const std::set<std::string> &names ) : flag_set( names.begin(), names.end() ) {}
+
+        const_iterator begin() const {
+            return names.begin();
+        }
+        const_iterator end() const {
+            return names.end();
+        }
+        bool empty() const {
+            return names.empty();
+        }
+        size_type size() const {
+            return names.size();
+        }
+
+        bool has( const flag_id &flag ) const {
+            const size_t word = flag.index() / 64;
+            return word < bits.size() && ( bits[word] >> ( flag.index() % 64 ) & 1 ) != 0;
+        }
+        size_type count( const flag_id &flag ) const {
+            return has( flag ) ? 1 : 0;
+        }
+        size_type count( const std::string &name ) const {
+            return names.count( name );
+        }
+
+        std::pair<iterator, bool> insert( const std::string &name );
+        std::pair<iterator, bool> insert( const flag_id &flag ) {
+            return insert( flag.str() );
+        }
+        iterator insert( const_iterator, const std::string &name ) {
+            return insert( name ).first;
+        }
+        template<typename InputIt>
+        void insert( InputIt first, InputIt last ) {
+            for( ; first != last; ++first ) {
+                insert( *first );
+            }
+        }
+
+        size_type erase( const std::string &name );
+        size_type erase( const flag_id &flag ) {
+            return erase( flag.str() );
+        }
+        void clear() {
+            names.clear();
+            bits.clear();
+        }
+
+        bool operator==( const flag_set &rhs ) const {
+            return names.size() == rhs.names.size() &&
+                   std::equal( names.begin(), names.end(), rhs.names.begin() );
+        }
+        bool operator!=( const flag_set &rhs ) const {
+            return !( *this == rhs );
+        }
+
+    private:
+        cata::flat_set<std::string> names;
+        std::vector<uint64_t> bits;
+};
 
 class json_flag
 {
@@ -14,6 +133,7 @@ class json_flag
     public:
         /** Fetches flag definition (or null flag if not found) */
         static const json_flag &get( const std::string &id );
+        static const json_flag &get( const flag_id &id );
 
         /** Get identifier of flag as specified in JSON */
         const std::string &id() const {
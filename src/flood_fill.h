@@ -2,6 +2,7 @@
 #ifndef CATA_SRC_FLOOD_FILL_H
 #define CATA_SRC_FLOOD_FILL_H
 
+#include <climits>
 #include <queue>
 #include <vector>
 #include <unordered_set>
@@ -50,6 +51,56 @@ std::vector<Point> point_flood_fill_4_connected( const Point &starting_point,
 
     return filled_points;
 }
+
+/**
+* Spreads out from a starting point to the 8-connected points of a size.x by size.y area, like
+* a flood that is slowed down by some points, and records how far it took to get to each point.
+* @param starting_point starting point of the fill, distance 0.
+* @param max_distance the fill stops there, points further away are left unreached.
+* @param size size of the area, points run from (0, 0) to size - (1, 1).
+* @param distances set to the distance of every point of the area, by y * size.x + x, or to
+* INT_MAX if the point was not reached.
+* @param step_cost Provided with a point, returns how far it is to enter it from a neighbor, at
+* least 1.
+*/
+template<typename StepCost>
+void point_distance_fill_8_connected( const point &starting_point, const int max_distance,
+                                      const point &size, std::vector<int> &distances, StepCost step_cost )
+{
+    distances.assign( size.x * size.y, INT_MAX );
+    if( starting_point.x < 0 || starting_point.y < 0 || starting_point.x >= size.x ||
+        starting_point.y >= size.y || max_distance < 0 ) {
+        return;
+    }
+    // Distances are small integers, so a bucket per distance does as a priority queue.
+    std::vector<std::vector<point>> buckets( max_distance + 1 );
+    distances[starting_point.y * size.x + starting_point.x] = 0;
+    buckets[0].push_back( starting_point );
+    for( int distance = 0; distance <= max_distance; ++distance ) {
+        for( const point &current_point : buckets[distance] ) {
+            if( distances[current_point.y * size.x + current_point.x] != distance ) {
+                // Reached on a shorter way after it was put here.
+                continue;
+            }
+            for( int dy = -1; dy <= 1; ++dy ) {
+                for( int dx = -1; dx <= 1; ++dx ) {
+                    const point next( current_point.x + dx, current_point.y + dy );
+                    if( ( dx == 0 && dy == 0 ) || next.x < 0 || next.y < 0 || next.x >= size.x ||
+                        next.y >= size.y ) {
+                        continue;
+                    }
+                    const int next_distance = distance + step_cost( next );
+                    int &known = distances[next.y * size.x + next.x];
+                    if( next_distance <= max_distance && next_distance < known ) {
+                        known = next_distance;
+                        buckets[next_distance].push_back( next );
+                    }
+                }
+            }
+        }
+        std::vector<point>().swap( buckets[distance] );
+    }
+}
 } // namespace ff
 
 #endif // CATA_SRC_FLOOD_FILL_H
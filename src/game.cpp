@@ -147,6 +147,7 @@
 #include "timed_event.h"
 #include "translations.h"
 #include "trap.h"
+#include "turn_profiler.h"
 #include "ui.h"
 #include "ui_manager.h"
 #include "uistate.h"
@@ -381,10 +382,11 @@ bool game::check_mod_data( const std::vector<mod_id> &opts, loading_ui &ui )
             std::cerr << "Error loading data from json: " << err.what() << std::endl;
         }
 
+        // Submaps still being written would end up in the deleted world otherwise.
+        MAPBUFFER.reset();
         std::string world_name = world_generator->active_world->world_name;
         world_generator->delete_world( world_name, true );
 
-        MAPBUFFER.reset();
         overmap_buffer.clear();
     }
 
@@ -425,10 +427,10 @@ bool game::check_mod_data( const std::vector<mod_id> &opts, loading_ui &ui )
             std::cerr << "Error loading data: " << err.what() << std::endl;
         }
 
+        MAPBUFFER.reset();
         std::string world_name = world_generator->active_world->world_name;
         world_generator->delete_world( world_name, true );
 
-        MAPBUFFER.reset();
         overmap_buffer.clear();
     }
     return true;
@@ -1222,6 +1224,8 @@ bool game::cleanup_at_end()
                 }
             }
 
+            // Let the background writes finish first, or they recreate files in the world.
+            MAPBUFFER.reset();
             if( queryDelete || get_option<std::string>( "WORLD_END" ) == "delete" ) {
                 world_generator->delete_world( world_generator->active_world->world_name, true );
 
@@ -1382,6 +1386,9 @@ void game::calc_driving_offset( vehicle *veh )
 // Returns true if game is over (death, saved, quit, etc)
 bool game::do_turn()
 {
+    // Fold the previous turn into the profile before timing this one.
+    turn_profiler::end_turn();
+    turn_profiler::scoped_timer turn_timer( turn_phase::total );
     if( is_game_over() ) {
         return cleanup_at_end();
     }
@@ -1389,19 +1396,28 @@ bool game::do_turn()
     if( new_game ) {
         new_game = false;
     } else {
-        gamemode->per_turn();
+        // Not set for worlds generated without starting a game, like in cata_bench.
+        if( gamemode ) {
+            gamemode->per_turn();
+        }
         calendar::turn += 1_turns;
     }
 
     // starting a new turn, clear out temperature cache
-    weather.temperature_cache.clear();
+    weather.clear_temp_cache();
 
     if( npcs_dirty ) {
         load_npcs();
     }
 
-    timed_events.process();
-    mission::process_all();
+    {
+        turn_profiler::scoped_timer timer( turn_phase::timed_events );
+        timed_events.process();
+    }
+    {
+        turn_profiler::scoped_timer timer( turn_phase::missions );
+        mission::process_all();
+    }
     // If controlling a vehicle that is owned by someone else
     if( u.in_vehicle && u.controlling_vehicle ) {
         vehicle *veh = veh_pointer_or_null( m.veh_at( u.pos() ) );
@@ -1414,40 +1430,55 @@ bool game::do_turn()
         u.check_mount_is_spooked();
     }
     if( calendar::once_every( 1_days ) ) {
+        turn_profiler::scoped_timer timer( turn_phase::hordes );
         overmap_buffer.process_mongroups();
     }
 
     // Move hordes every 2.5 min
     if( calendar::once_every( time_duration::from_minutes( 2.5 ) ) ) {
+        turn_profiler::scoped_timer timer( turn_phase::hordes );
         overmap_buffer.move_hordes();
         // Hordes that reached the reality bubble need to spawn,
         // make them spawn in invisible areas only.
         m.spawn_monsters( false );
     }
 
-    u.update_body();
+    {
+        turn_profiler::scoped_timer timer( turn_phase::player_body );
+        u.update_body();
+    }
 
     // Auto-save if autosave is enabled
     if( get_option<bool>( "AUTOSAVE" ) &&
         calendar::once_every( 1_turns * get_option<int>( "AUTOSAVE_TURNS" ) ) &&
         !u.is_dead_state() ) {
+        turn_profiler::scoped_timer timer( turn_phase::autosave );
         autosave();
     }
 
-    weather.update_weather();
-    reset_light_level();
+    {
+        turn_profiler::scoped_timer timer( turn_phase::weather );
+        weather.update_weather();
+        reset_light_level();
+    }
 
     perhaps_add_random_npc();
-    process_activity();
-    // Process NPC sound events before they move or they hear themselves talking
-    for( npc &guy : all_npcs() ) {
-        if( rl_dist( guy.pos(), u.pos() ) < MAX_VIEW_DISTANCE ) {
-            sounds::process_sound_markers( &guy );
-        }
+    {
+        turn_profiler::scoped_timer timer( turn_phase::activity );
+        process_activity();
     }
+    {
+        turn_profiler::scoped_timer timer( turn_phase::sound_markers );
+        // Process NPC sound events before they move or they hear themselves talking
+        for( npc &guy : all_npcs() ) {
+            if( rl_dist( guy.pos(), u.pos() ) < MAX_VIEW_DISTANCE ) {
+                sounds::process_sound_markers( &guy );
+            }
+        }
 
-    // Process sound events into sound markers for display to the player.
-    sounds::process_sound_markers( &u );
+        // Process sound events into sound markers for display to the player.
+        sounds::process_sound_markers( &u );
+    }
 
     if( u.is_deaf() ) {
         sfx::do_hearing_loss();
@@ -1455,6 +1486,7 @@ bool game::do_turn()
 
     if( !u.has_effect( efftype_id( "sleep" ) ) || uquit == QUIT_WATCH ) {
         if( u.moves > 0 || uquit == QUIT_WATCH ) {
+            turn_profiler::scoped_timer timer( turn_phase::player_input );
             while( u.moves > 0 || uquit == QUIT_WATCH ) {
                 cleanup_dead();
                 mon_info_update();
@@ -1499,7 +1531,10 @@ bool game::do_turn()
                 start = now;
             }
 
-            mon_info_update();
+            // The update at the end of the turn notices hostiles coming into view.
+            if( !is_fast_forwarding() ) {
+                mon_info_update();
+            }
 
             // If player is performing a task and a monster is dangerously close, warn them
             // regardless of previous safemode warnings
@@ -1532,29 +1567,58 @@ bool game::do_turn()
         scent.set( u.pos(), u.scent, u.get_type_of_scent() );
         overmap_buffer.set_scent( u.global_omt_location(),  u.scent );
     }
-    scent.update( u.pos(), m );
+    {
+        turn_profiler::scoped_timer timer( turn_phase::scent );
+        scent.update( u.pos(), m );
+    }
 
-    // We need floor cache before checking falling 'n stuff
-    m.build_floor_caches();
+    {
+        turn_profiler::scoped_timer timer( turn_phase::floor_caches );
+        // We need floor cache before checking falling 'n stuff
+        m.build_floor_caches();
+    }
 
-    m.process_falling();
-    autopilot_vehicles();
-    m.vehmove();
-    m.process_fields();
-    m.process_items();
+    {
+        turn_profiler::scoped_timer timer( turn_phase::falling );
+        m.process_falling();
+    }
+    {
+        turn_profiler::scoped_timer timer( turn_phase::vehicles );
+        autopilot_vehicles();
+        m.vehmove();
+    }
+    {
+        turn_profiler::scoped_timer timer( turn_phase::fields );
+        m.process_fields();
+    }
+    {
+        turn_profiler::scoped_timer timer( turn_phase::items );
+        m.process_items();
+    }
     m.creature_in_field( u );
 
-    // Apply sounds from previous turn to monster and NPC AI.
-    sounds::process_sounds();
+    {
+        turn_profiler::scoped_timer timer( turn_phase::sounds );
+        // Apply sounds from previous turn to monster and NPC AI.
+        sounds::process_sounds();
+    }
     const int levz = m.get_abs_sub().z;
-    // Update vision caches for monsters. If this turns out to be expensive,
-    // consider a stripped down cache just for monsters.
-    m.build_map_cache( levz, true );
-    monmove();
+    {
+        turn_profiler::scoped_timer timer( turn_phase::map_cache );
+        // Update vision caches for monsters. If this turns out to be expensive,
+        // consider a stripped down cache just for monsters.
+        m.build_map_cache( levz, true );
+    }
+    {
+        turn_profiler::scoped_timer timer( turn_phase::monmove );
+        monmove();
+    }
     if( calendar::once_every( 5_minutes ) ) {
+        turn_profiler::scoped_timer timer( turn_phase::npc_overmap_move );
         overmap_npc_move();
     }
     if( calendar::once_every( 10_seconds ) ) {
+        turn_profiler::scoped_timer timer( turn_phase::furniture_emissions );
         for( const tripoint elem : m.get_furn_field_locations() ) {
             const auto &furn = m.furn( elem ).obj();
             for( const emit_id &e : furn.emissions ) {
@@ -1564,8 +1628,11 @@ bool game::do_turn()
     }
     update_stair_monsters();
     mon_info_update();
-    u.process_turn();
-    if( u.moves < 0 && get_option<bool>( "FORCE_REDRAW" ) ) {
+    {
+        turn_profiler::scoped_timer timer( turn_phase::player_turn );
+        u.process_turn();
+    }
+    if( u.moves < 0 && get_option<bool>( "FORCE_REDRAW" ) && !is_fast_forwarding() ) {
         ui_manager::redraw();
         refresh_display();
     }
@@ -1594,9 +1661,20 @@ bool game::do_turn()
         wait_refresh_rate = 5_minutes;
     }
     if( wait_redraw ) {
-        if( first_redraw_since_waiting_started || calendar::once_every( 1_minutes ) ) {
-            if( first_redraw_since_waiting_started || calendar::once_every( wait_refresh_rate ) ) {
+        if( calendar::once_every( wait_refresh_rate ) ) {
+            wait_full_redraw_pending = true;
+        }
+        // Redrawing takes far longer than simulating a turn, so while fast forwarding the
+        // waiting message is updated at most 10 times a second.
+        const auto now = std::chrono::steady_clock::now();
+        const bool throttled = is_fast_forwarding() &&
+                               now - last_wait_redraw < std::chrono::milliseconds( 100 );
+        if( first_redraw_since_waiting_started ||
+            ( calendar::once_every( 1_minutes ) && !throttled ) ) {
+            turn_profiler::scoped_timer timer( turn_phase::wait_redraw );
+            if( first_redraw_since_waiting_started || wait_full_redraw_pending ) {
                 ui_manager::redraw();
+                wait_full_redraw_pending = false;
             }
 
             // Avoid redrawing the main UI every time due to invalidation
@@ -1606,6 +1684,7 @@ bool game::do_turn()
             ui_manager::redraw();
             refresh_display();
             first_redraw_since_waiting_started = false;
+            last_wait_redraw = now;
         }
     } else {
         // Nothing to wait for now
@@ -1638,6 +1717,15 @@ bool game::do_turn()
     return false;
 }
 
+bool game::is_fast_forwarding() const
+{
+    // mostseen counts the hostiles safe mode reacts to, see mon_info_update.
+    if( uquit == QUIT_WATCH || mostseen > 0 ) {
+        return false;
+    }
+    return u.has_effect( effect_sleep ) || ( u.activity && u.activity.moves_left > 0 );
+}
+
 void game::set_driving_view_offset( const point &p )
 {
     // remove the previous driving offset,
@@ -3094,7 +3182,8 @@ bool game::save_maps()
         m.save();
         overmap_buffer.save(); // can throw
         MAPBUFFER.save(); // can throw
-        return true;
+        // Only done once the submaps written in the background are on disk.
+        return MAPBUFFER.finish_writes();
     } catch( const std::exception &err ) {
         popup( _( "Failed to save the maps: %s" ), err.what() );
         return false;
@@ -11168,6 +11257,38 @@ void game::vertical_notes( int z_before, int z_after )
     }
 }
 
+void game::prefetch_submaps( const point &pos )
+{
+    // A moving vehicle reaches the edge of the map soon, look further ahead.
+    if( const optional_vpart_position vp = m.veh_at( u.pos() ) ) {
+        const vehicle &veh = vp->vehicle();
+        if( veh.velocity != 0 ) {
+            static const std::array<point, 8> dir8_offsets = { {
+                    point_east, point_south_east, point_south, point_south_west,
+                    point_west, point_north_west, point_north, point_north_east
+                }
+            };
+            const point heading = dir8_offsets[veh.move.dir8()];
+            m.prefetch_submaps( veh.velocity > 0 ? heading : -heading, 2 );
+            return;
+        }
+    }
+    // Otherwise prefetch once the player gets near the edge of the center submap, the
+    // map shifts when they leave it.
+    point heading;
+    if( pos.x < HALF_MAPSIZE_X + SEEX / 4 ) {
+        heading.x = -1;
+    } else if( pos.x >= HALF_MAPSIZE_X + SEEX * 3 / 4 ) {
+        heading.x = 1;
+    }
+    if( pos.y < HALF_MAPSIZE_Y + SEEY / 4 ) {
+        heading.y = -1;
+    } else if( pos.y >= HALF_MAPSIZE_Y + SEEY * 3 / 4 ) {
+        heading.y = 1;
+    }
+    m.prefetch_submaps( heading, 1 );
+}
+
 point game::update_map( Character &p )
 {
     point p2( p.posx(), p.posy() );
@@ -11176,6 +11297,8 @@ point game::update_map( Character &p )
 
 point game::update_map( int &x, int &y )
 {
+    prefetch_submaps( point( x, y ) );
+
     point shift;
 
     while( x < HALF_MAPSIZE_X ) {
@@ -567,6 +567,8 @@ class game
         // Helper to make calling with a player pointer less verbose.
         point update_map( Character &p );
         point update_map( int &x, int &y );
+        /** Prefetches the submaps the player at pos (in local map coordinates) is heading towards. */
+        void prefetch_submaps( const point &pos );
         void update_overmap_seen(); // Update which overmap tiles we can see
 
         void process_artifact( item &it, player &p );
@@ -828,6 +830,15 @@ class game
         void mon_info( const catacurses::window &,
                        int hor_padding = 0 ); // Prints a list of nearby monsters
         void mon_info_update( );    //Update seen monsters information
+        /**
+         * True while the player sleeps or works on an uninterrupted activity with no hostile in
+         * view. Turns then skip FORCE_REDRAW and the waiting popup is redrawn at most ten times
+         * a second. Activities also skip the mid-turn monster info update, sleeping turns never
+         * had one. The rest of the turn, including the monster info update at its end and the
+         * sound markers, runs as usual: they are what wakes the player or interrupts the
+         * activity, so this saves little more than the drawing.
+         */
+        bool is_fast_forwarding() const;
         void cleanup_dead();     // Delete any dead NPCs/monsters
         bool is_dangerous_tile( const tripoint &dest_loc ) const;
         std::vector<std::string> get_dangerous_tile( const tripoint &dest_loc ) const;
@@ -1061,6 +1072,10 @@ class game
         bool critter_died = false;
         /** Is this the first redraw since waiting (sleeping or activity) started */
         bool first_redraw_since_waiting_started = true;
+        /** Set when a full redraw was skipped while fast forwarding, it happens with the next one */
+        bool wait_full_redraw_pending = false;
+        /** Wall time of the last redraw of the waiting popup */
+        std::chrono::steady_clock::time_point last_wait_redraw;
         /** Is Zone manager open or not - changes graphics of some zone tiles */
         bool zones_manager_open = false;
 
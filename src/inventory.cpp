@@ -48,6 +48,9 @@ static const std::string flag_LEAK_DAM( "LEAK_DAM" );
 static const std::string flag_WATERPROOF( "WATERPROOF" );
 static const std::string flag_WATERPROOF_GUN( "WATERPROOF_GUN" );
 
+// Shared by all inventories, so no two states of any of them get the same revision.
+static int revisions = 0;
+
 struct itype;
 
 const invlet_wrapper
@@ -223,6 +226,7 @@ inventory inventory::operator+ ( const item &rhs )
 void inventory::unsort()
 {
     binned = false;
+    revision = ++revisions;
 }
 
 static bool stack_compare( const std::list<item> &lhs, const std::list<item> &rhs )
@@ -234,6 +238,7 @@ void inventory::clear()
 {
     items.clear();
     binned = false;
+    revision = ++revisions;
 }
 
 void inventory::push_back( const std::list<item> &newits )
@@ -281,6 +286,7 @@ char inventory::find_usable_cached_invlet( const itype_id &item_type )
 item &inventory::add_item( item newit, bool keep_invlet, bool assign_invlet, bool should_stack )
 {
     binned = false;
+    revision = ++revisions;
 
     Character &player_character = get_player_character();
     if( should_stack ) {
@@ -343,6 +349,7 @@ void inventory::restack( Character &p )
     // 3. combine matching stacks
 
     binned = false;
+    revision = ++revisions;
     std::list<item> to_restack;
     int idx = 0;
     for( invstack::iterator iter = items.begin(); iter != items.end(); ++iter, ++idx ) {
@@ -621,6 +628,7 @@ std::list<item> inventory::reduce_stack( const int position, const int quantity
     for( invstack::iterator iter = items.begin(); iter != items.end(); ++iter ) {
         if( position == pos ) {
             binned = false;
+            revision = ++revisions;
             if( quantity >= static_cast<int>( iter->size() ) || quantity < 0 ) {
                 ret = *iter;
                 items.erase( iter );
@@ -643,6 +651,7 @@ item inventory::remove_item( const item *it )
     }, 1 );
     if( !tmp.empty() ) {
         binned = false;
+        revision = ++revisions;
         return tmp.front();
     }
     debugmsg( "Tried to remove a item not in inventory." );
@@ -655,6 +664,7 @@ item inventory::remove_item( const int position )
     for( invstack::iterator iter = items.begin(); iter != items.end(); ++iter ) {
         if( position == pos ) {
             binned = false;
+            revision = ++revisions;
             if( iter->size() > 1 ) {
                 std::list<item>::iterator stack_member = iter->begin();
                 char invlet = stack_member->invlet;
@@ -700,6 +710,7 @@ std::list<item> inventory::remove_randomly_by_volume( const units::volume &volum
         }
         if( chosen_stack->empty() ) {
             binned = false;
+            revision = ++revisions;
             items.erase( chosen_stack );
         }
     }
@@ -787,6 +798,7 @@ std::list<item> inventory::use_amount( const itype_id &it, int quantity,
         }
         if( iter->empty() ) {
             binned = false;
+            revision = ++revisions;
             iter = items.erase( iter );
         } else if( iter != items.end() ) {
             ++iter;
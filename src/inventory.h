@@ -222,6 +222,11 @@ class inventory : public visitable<inventory>
          */
         const itype_bin &get_binned_items() const;
 
+        /** Changes whenever items are added or removed, for caches of values derived from them. */
+        int get_revision() const {
+            return revision;
+        }
+
         void update_cache_with_item( item &newit );
 
         void copy_invlet_of( const inventory &other );
@@ -236,6 +241,7 @@ class inventory : public visitable<inventory>
         invstack items;
 
         mutable bool binned = false;
+        int revision = 0;
         /**
          * Items binned by their type.
          * That is, item_bin["carrot"] is a list of pointers to all carrots in inventory.
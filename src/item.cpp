@@ -157,115 +157,115 @@ static const trait_id trait_SMALL2( "SMALL2" );
 static const trait_id trait_TOLERANCE( "TOLERANCE" );
 static const trait_id trait_WOOLALLERGY( "WOOLALLERGY" );
 
-static const std::string flag_ALWAYS_TWOHAND( "ALWAYS_TWOHAND" );
-static const std::string flag_AURA( "AURA" );
-static const std::string flag_BELTED( "BELTED" );
-static const std::string flag_BIPOD( "BIPOD" );
-static const std::string flag_BYPRODUCT( "BYPRODUCT" );
-static const std::string flag_CABLE_SPOOL( "CABLE_SPOOL" );
-static const std::string flag_CANNIBALISM( "CANNIBALISM" );
-static const std::string flag_CHARGEDIM( "CHARGEDIM" );
-static const std::string flag_COLD( "COLD" );
-static const std::string flag_COLLAPSIBLE_STOCK( "COLLAPSIBLE_STOCK" );
-static const std::string flag_CONDUCTIVE( "CONDUCTIVE" );
-static const std::string flag_CONSUMABLE( "CONSUMABLE" );
-static const std::string flag_CORPSE( "CORPSE" );
-static const std::string flag_DANGEROUS( "DANGEROUS" );
+static const flag_id flag_ALWAYS_TWOHAND( "ALWAYS_TWOHAND" );
+static const flag_id flag_AURA( "AURA" );
+static const flag_id flag_BELTED( "BELTED" );
+static const flag_id flag_BIPOD( "BIPOD" );
+static const flag_id flag_BYPRODUCT( "BYPRODUCT" );
+static const flag_id flag_CABLE_SPOOL( "CABLE_SPOOL" );
+static const flag_id flag_CANNIBALISM( "CANNIBALISM" );
+static const flag_id flag_CHARGEDIM( "CHARGEDIM" );
+static const flag_id flag_COLD( "COLD" );
+static const flag_id flag_COLLAPSIBLE_STOCK( "COLLAPSIBLE_STOCK" );
+static const flag_id flag_CONDUCTIVE( "CONDUCTIVE" );
+static const flag_id flag_CONSUMABLE( "CONSUMABLE" );
+static const flag_id flag_CORPSE( "CORPSE" );
+static const flag_id flag_DANGEROUS( "DANGEROUS" );
 static const std::string flag_DEEP_WATER( "DEEP_WATER" );
-static const std::string flag_DIAMOND( "DIAMOND" );
-static const std::string flag_DISABLE_SIGHTS( "DISABLE_SIGHTS" );
-static const std::string flag_ETHEREAL_ITEM( "ETHEREAL_ITEM" );
-static const std::string flag_FAKE_MILL( "FAKE_MILL" );
-static const std::string flag_FAKE_SMOKE( "FAKE_SMOKE" );
-static const std::string flag_FIELD_DRESS( "FIELD_DRESS" );
-static const std::string flag_FIELD_DRESS_FAILED( "FIELD_DRESS_FAILED" );
-static const std::string flag_FILTHY( "FILTHY" );
-static const std::string flag_FIRE_100( "FIRE_100" );
-static const std::string flag_FIRE_20( "FIRE_20" );
-static const std::string flag_FIRE_50( "FIRE_50" );
-static const std::string flag_FIRE_TWOHAND( "FIRE_TWOHAND" );
-static const std::string flag_FIT( "FIT" );
+static const flag_id flag_DIAMOND( "DIAMOND" );
+static const flag_id flag_DISABLE_SIGHTS( "DISABLE_SIGHTS" );
+static const flag_id flag_ETHEREAL_ITEM( "ETHEREAL_ITEM" );
+static const flag_id flag_FAKE_MILL( "FAKE_MILL" );
+static const flag_id flag_FAKE_SMOKE( "FAKE_SMOKE" );
+static const flag_id flag_FIELD_DRESS( "FIELD_DRESS" );
+static const flag_id flag_FIELD_DRESS_FAILED( "FIELD_DRESS_FAILED" );
+static const flag_id flag_FILTHY( "FILTHY" );
+static const flag_id flag_FIRE_100( "FIRE_100" );
+static const flag_id flag_FIRE_20( "FIRE_20" );
+static const flag_id flag_FIRE_50( "FIRE_50" );
+static const flag_id flag_FIRE_TWOHAND( "FIRE_TWOHAND" );
+static const flag_id flag_FIT( "FIT" );
 static const std::string flag_FLAMMABLE( "FLAMMABLE" );
 static const std::string flag_FLAMMABLE_ASH( "FLAMMABLE_ASH" );
-static const std::string flag_FREEZERBURN( "FREEZERBURN" );
-static const std::string flag_FROZEN( "FROZEN" );
-static const std::string flag_GIBBED( "GIBBED" );
-static const std::string flag_HELMET_COMPAT( "HELMET_COMPAT" );
-static const std::string flag_HIDDEN_HALLU( "HIDDEN_HALLU" );
-static const std::string flag_HIDDEN_POISON( "HIDDEN_POISON" );
-static const std::string flag_HOT( "HOT" );
-static const std::string flag_IRREMOVABLE( "IRREMOVABLE" );
-static const std::string flag_BURNOUT( "BURNOUT" );
-static const std::string flag_IS_ARMOR( "IS_ARMOR" );
-static const std::string flag_IS_PET_ARMOR( "IS_PET_ARMOR" );
-static const std::string flag_IS_UPS( "IS_UPS" );
-static const std::string flag_LEAK_ALWAYS( "LEAK_ALWAYS" );
-static const std::string flag_LEAK_DAM( "LEAK_DAM" );
+static const flag_id flag_FREEZERBURN( "FREEZERBURN" );
+static const flag_id flag_FROZEN( "FROZEN" );
+static const flag_id flag_GIBBED( "GIBBED" );
+static const flag_id flag_HELMET_COMPAT( "HELMET_COMPAT" );
+static const flag_id flag_HIDDEN_HALLU( "HIDDEN_HALLU" );
+static const flag_id flag_HIDDEN_POISON( "HIDDEN_POISON" );
+static const flag_id flag_HOT( "HOT" );
+static const flag_id flag_IRREMOVABLE( "IRREMOVABLE" );
+static const flag_id flag_BURNOUT( "BURNOUT" );
+static const flag_id flag_IS_ARMOR( "IS_ARMOR" );
+static const flag_id flag_IS_PET_ARMOR( "IS_PET_ARMOR" );
+static const flag_id flag_IS_UPS( "IS_UPS" );
+static const flag_id flag_LEAK_ALWAYS( "LEAK_ALWAYS" );
+static const flag_id flag_LEAK_DAM( "LEAK_DAM" );
 static const std::string flag_LIQUID( "LIQUID" );
 static const std::string flag_LIQUIDCONT( "LIQUIDCONT" );
-static const std::string flag_LITCIG( "LITCIG" );
-static const std::string flag_MAG_BELT( "MAG_BELT" );
-static const std::string flag_MELTS( "MELTS" );
-static const std::string flag_MUSHY( "MUSHY" );
-static const std::string flag_NANOFAB_TEMPLATE( "NANOFAB_TEMPLATE" );
-static const std::string flag_NEEDS_UNFOLD( "NEEDS_UNFOLD" );
-static const std::string flag_NEVER_JAMS( "NEVER_JAMS" );
-static const std::string flag_NONCONDUCTIVE( "NONCONDUCTIVE" );
+static const flag_id flag_LITCIG( "LITCIG" );
+static const flag_id flag_MAG_BELT( "MAG_BELT" );
+static const flag_id flag_MELTS( "MELTS" );
+static const flag_id flag_MUSHY( "MUSHY" );
+static const flag_id flag_NANOFAB_TEMPLATE( "NANOFAB_TEMPLATE" );
+static const flag_id flag_NEEDS_UNFOLD( "NEEDS_UNFOLD" );
+static const flag_id flag_NEVER_JAMS( "NEVER_JAMS" );
+static const flag_id flag_NONCONDUCTIVE( "NONCONDUCTIVE" );
 static const std::string flag_NO_DISPLAY( "NO_DISPLAY" );
-static const std::string flag_NO_DROP( "NO_DROP" );
-static const std::string flag_NO_PACKED( "NO_PACKED" );
-static const std::string flag_NO_PARASITES( "NO_PARASITES" );
-static const std::string flag_NO_RELOAD( "NO_RELOAD" );
-static const std::string flag_NO_REPAIR( "NO_REPAIR" );
-static const std::string flag_NO_SALVAGE( "NO_SALVAGE" );
-static const std::string flag_NO_STERILE( "NO_STERILE" );
-static const std::string flag_NO_UNLOAD( "NO_UNLOAD" );
-static const std::string flag_OUTER( "OUTER" );
-static const std::string flag_OVERSIZE( "OVERSIZE" );
-static const std::string flag_PERSONAL( "PERSONAL" );
-static const std::string flag_PROCESSING( "PROCESSING" );
-static const std::string flag_PROCESSING_RESULT( "PROCESSING_RESULT" );
-static const std::string flag_PULPED( "PULPED" );
-static const std::string flag_PUMP_ACTION( "PUMP_ACTION" );
-static const std::string flag_PUMP_RAIL_COMPATIBLE( "PUMP_RAIL_COMPATIBLE" );
-static const std::string flag_QUARTERED( "QUARTERED" );
-static const std::string flag_RADIOACTIVE( "RADIOACTIVE" );
-static const std::string flag_RADIOSIGNAL_1( "RADIOSIGNAL_1" );
-static const std::string flag_RADIOSIGNAL_2( "RADIOSIGNAL_2" );
-static const std::string flag_RADIOSIGNAL_3( "RADIOSIGNAL_3" );
-static const std::string flag_RADIO_ACTIVATION( "RADIO_ACTIVATION" );
-static const std::string flag_RADIO_INVOKE_PROC( "RADIO_INVOKE_PROC" );
-static const std::string flag_RADIO_MOD( "RADIO_MOD" );
-static const std::string flag_RAIN_PROTECT( "RAIN_PROTECT" );
-static const std::string flag_REACH3( "REACH3" );
-static const std::string flag_REACH_ATTACK( "REACH_ATTACK" );
-static const std::string flag_RECHARGE( "RECHARGE" );
-static const std::string flag_REDUCED_BASHING( "REDUCED_BASHING" );
-static const std::string flag_REDUCED_WEIGHT( "REDUCED_WEIGHT" );
-static const std::string flag_RELOAD_AND_SHOOT( "RELOAD_AND_SHOOT" );
-static const std::string flag_RELOAD_EJECT( "RELOAD_EJECT" );
-static const std::string flag_RELOAD_ONE( "RELOAD_ONE" );
-static const std::string flag_REVIVE_SPECIAL( "REVIVE_SPECIAL" );
+static const flag_id flag_NO_DROP( "NO_DROP" );
+static const flag_id flag_NO_PACKED( "NO_PACKED" );
+static const flag_id flag_NO_PARASITES( "NO_PARASITES" );
+static const flag_id flag_NO_RELOAD( "NO_RELOAD" );
+static const flag_id flag_NO_REPAIR( "NO_REPAIR" );
+static const flag_id flag_NO_SALVAGE( "NO_SALVAGE" );
+static const flag_id flag_NO_STERILE( "NO_STERILE" );
+static const flag_id flag_NO_UNLOAD( "NO_UNLOAD" );
+static const flag_id flag_OUTER( "OUTER" );
+static const flag_id flag_OVERSIZE( "OVERSIZE" );
+static const flag_id flag_PERSONAL( "PERSONAL" );
+static const flag_id flag_PROCESSING( "PROCESSING" );
+static const flag_id flag_PROCESSING_RESULT( "PROCESSING_RESULT" );
+static const flag_id flag_PULPED( "PULPED" );
+static const flag_id flag_PUMP_ACTION( "PUMP_ACTION" );
+static const flag_id flag_PUMP_RAIL_COMPATIBLE( "PUMP_RAIL_COMPATIBLE" );
+static const flag_id flag_QUARTERED( "QUARTERED" );
+static const flag_id flag_RADIOACTIVE( "RADIOACTIVE" );
+static const flag_id flag_RADIOSIGNAL_1( "RADIOSIGNAL_1" );
+static const flag_id flag_RADIOSIGNAL_2( "RADIOSIGNAL_2" );
+static const flag_id flag_RADIOSIGNAL_3( "RADIOSIGNAL_3" );
+static const flag_id flag_RADIO_ACTIVATION( "RADIO_ACTIVATION" );
+static const flag_id flag_RADIO_INVOKE_PROC( "RADIO_INVOKE_PROC" );
+static const flag_id flag_RADIO_MOD( "RADIO_MOD" );
+static const flag_id flag_RAIN_PROTECT( "RAIN_PROTECT" );
+static const flag_id flag_REACH3( "REACH3" );
+static const flag_id flag_REACH_ATTACK( "REACH_ATTACK" );
+static const flag_id flag_RECHARGE( "RECHARGE" );
+static const flag_id flag_REDUCED_BASHING( "REDUCED_BASHING" );
+static const flag_id flag_REDUCED_WEIGHT( "REDUCED_WEIGHT" );
+static const flag_id flag_RELOAD_AND_SHOOT( "RELOAD_AND_SHOOT" );
+static const flag_id flag_RELOAD_EJECT( "RELOAD_EJECT" );
+static const flag_id flag_RELOAD_ONE( "RELOAD_ONE" );
+static const flag_id flag_REVIVE_SPECIAL( "REVIVE_SPECIAL" );
 static const std::string flag_SILENT( "SILENT" );
-static const std::string flag_SKINNED( "SKINNED" );
-static const std::string flag_SKINTIGHT( "SKINTIGHT" );
-static const std::string flag_SLOW_WIELD( "SLOW_WIELD" );
-static const std::string flag_SPEEDLOADER( "SPEEDLOADER" );
-static const std::string flag_SPLINT( "SPLINT" );
-static const std::string flag_TOURNIQUET( "TOURNIQUET" );
-static const std::string flag_STR_DRAW( "STR_DRAW" );
-static const std::string flag_TOBACCO( "TOBACCO" );
-static const std::string flag_UNARMED_WEAPON( "UNARMED_WEAPON" );
-static const std::string flag_UNDERSIZE( "UNDERSIZE" );
-static const std::string flag_USES_BIONIC_POWER( "USES_BIONIC_POWER" );
-static const std::string flag_USE_UPS( "USE_UPS" );
-static const std::string flag_VARSIZE( "VARSIZE" );
-static const std::string flag_VEHICLE( "VEHICLE" );
-static const std::string flag_WAIST( "WAIST" );
-static const std::string flag_WATERPROOF_GUN( "WATERPROOF_GUN" );
-static const std::string flag_WATER_EXTINGUISH( "WATER_EXTINGUISH" );
-static const std::string flag_WET( "WET" );
-static const std::string flag_WIND_EXTINGUISH( "WIND_EXTINGUISH" );
+static const flag_id flag_SKINNED( "SKINNED" );
+static const flag_id flag_SKINTIGHT( "SKINTIGHT" );
+static const flag_id flag_SLOW_WIELD( "SLOW_WIELD" );
+static const flag_id flag_SPEEDLOADER( "SPEEDLOADER" );
+static const flag_id flag_SPLINT( "SPLINT" );
+static const flag_id flag_TOURNIQUET( "TOURNIQUET" );
+static const flag_id flag_STR_DRAW( "STR_DRAW" );
+static const flag_id flag_TOBACCO( "TOBACCO" );
+static const flag_id flag_UNARMED_WEAPON( "UNARMED_WEAPON" );
+static const flag_id flag_UNDERSIZE( "UNDERSIZE" );
+static const flag_id flag_USES_BIONIC_POWER( "USES_BIONIC_POWER" );
+static const flag_id flag_USE_UPS( "USE_UPS" );
+static const flag_id flag_VARSIZE( "VARSIZE" );
+static const flag_id flag_VEHICLE( "VEHICLE" );
+static const flag_id flag_WAIST( "WAIST" );
+static const flag_id flag_WATERPROOF_GUN( "WATERPROOF_GUN" );
+static const flag_id flag_WATER_EXTINGUISH( "WATER_EXTINGUISH" );
+static const flag_id flag_WET( "WET" );
+static const flag_id flag_WIND_EXTINGUISH( "WIND_EXTINGUISH" );
 
 static const matec_id RAPID( "RAPID" );
 
@@ -516,9 +516,9 @@ item item::make_corpse( const mtype_id &mt, time_point turn, const std::string &
         result.set_var( "zombie_form", mt->zombify_into.c_str() );
     }
 
-    // This is unconditional because the const itemructor above sets result.name to
-    // "human corpse".
-    result.corpse_name = name;
+    if( !name.empty() ) {
+        result.mutable_extra().corpse_name = name;
+    }
 
     return result;
 }
@@ -1025,10 +1025,8 @@ bool item::stacks_with( const item &rhs, bool check_components ) const
     if( faults != rhs.faults ) {
         return false;
     }
-    if( techniques != rhs.techniques ) {
-        return false;
-    }
-    if( item_vars != rhs.item_vars ) {
+    if( extra_ != rhs.extra_ && ( extra().techniques != rhs.extra().techniques ||
+                                  extra().item_vars != rhs.extra().item_vars ) ) {
         return false;
     }
     if( goes_bad() && rhs.goes_bad() ) {
@@ -1098,12 +1096,43 @@ ret_val<bool> item::put_in( const item &payload, item_pocket::pocket_type pk_typ
     return result;
 }
 
+bool item::extra_data::empty() const
+{
+    return item_vars.empty() && corpse_name.empty() && techniques.empty();
+}
+
+const item::extra_data &item::extra() const
+{
+    static const extra_data no_extra;
+    return extra_ ? *extra_ : no_extra;
+}
+
+item::extra_data &item::mutable_extra()
+{
+    if( !extra_ ) {
+        extra_ = std::make_shared<extra_data>();
+    } else if( extra_.use_count() > 1 ) {
+        extra_ = std::make_shared<extra_data>( *extra_ );
+    }
+    return *extra_;
+}
+
+long item::extra_data_use_count() const
+{
+    return extra_.use_count();
+}
+
+size_t item::extra_data_size()
+{
+    return sizeof( extra_data );
+}
+
 void item::set_var( const std::string &name, const int value )
 {
     std::ostringstream tmpstream;
     tmpstream.imbue( std::locale::classic() );
     tmpstream << value;
-    item_vars[name] = tmpstream.str();
+    mutable_extra().item_vars[name] = tmpstream.str();
 }
 
 void item::set_var( const std::string &name, const long long value )
@@ -1111,7 +1140,7 @@ void item::set_var( const std::string &name, const long long value )
     std::ostringstream tmpstream;
     tmpstream.imbue( std::locale::classic() );
     tmpstream << value;
-    item_vars[name] = tmpstream.str();
+    mutable_extra().item_vars[name] = tmpstream.str();
 }
 
 // NOLINTNEXTLINE(cata-no-long)
@@ -1120,18 +1149,18 @@ void item::set_var( const std::string &name, const long value )
     std::ostringstream tmpstream;
     tmpstream.imbue( std::locale::classic() );
     tmpstream << value;
-    item_vars[name] = tmpstream.str();
+    mutable_extra().item_vars[name] = tmpstream.str();
 }
 
 void item::set_var( const std::string &name, const double value )
 {
-    item_vars[name] = string_format( "%f", value );
+    mutable_extra().item_vars[name] = string_format( "%f", value );
 }
 
 double item::get_var( const std::string &name, const double default_value ) const
 {
-    const auto it = item_vars.find( name );
-    if( it == item_vars.end() ) {
+    const auto it = extra().item_vars.find( name );
+    if( it == extra().item_vars.end() ) {
         return default_value;
     }
     return atof( it->second.c_str() );
@@ -1139,13 +1168,13 @@ double item::get_var( const std::string &name, const double default_value ) cons
 
 void item::set_var( const std::string &name, const tripoint &value )
 {
-    item_vars[name] = string_format( "%d,%d,%d", value.x, value.y, value.z );
+    mutable_extra().item_vars[name] = string_format( "%d,%d,%d", value.x, value.y, value.z );
 }
 
 tripoint item::get_var( const std::string &name, const tripoint &default_value ) const
 {
-    const auto it = item_vars.find( name );
-    if( it == item_vars.end() ) {
+    const auto it = extra().item_vars.find( name );
+    if( it == extra().item_vars.end() ) {
         return default_value;
     }
     std::vector<std::string> values = string_split( it->second, ',' );
@@ -1156,13 +1185,13 @@ tripoint item::get_var( const std::string &name, const tripoint &default_value )
 
 void item::set_var( const std::string &name, const std::string &value )
 {
-    item_vars[name] = value;
+    mutable_extra().item_vars[name] = value;
 }
 
 std::string item::get_var( const std::string &name, const std::string &default_value ) const
 {
-    const auto it = item_vars.find( name );
-    if( it == item_vars.end() ) {
+    const auto it = extra().item_vars.find( name );
+    if( it == extra().item_vars.end() ) {
         return default_value;
     }
     return it->second;
@@ -1175,17 +1204,21 @@ std::string item::get_var( const std::string &name ) const
 
 bool item::has_var( const std::string &name ) const
 {
-    return item_vars.count( name ) > 0;
+    return extra().item_vars.count( name ) > 0;
 }
 
 void item::erase_var( const std::string &name )
 {
-    item_vars.erase( name );
+    if( has_var( name ) ) {
+        mutable_extra().item_vars.erase( name );
+    }
 }
 
 void item::clear_vars()
 {
-    item_vars.clear();
+    if( !extra().item_vars.empty() ) {
+        mutable_extra().item_vars.clear();
+    }
 }
 
 // TODO: Get rid of, handle multiple types gracefully
@@ -1619,12 +1652,12 @@ void item::basic_info( std::vector<iteminfo> &info, const iteminfo_query *parts,
     if( parts->test( iteminfo_parts::DESCRIPTION ) ) {
         insert_separation_line( info );
         const std::map<std::string, std::string>::const_iterator idescription =
-            item_vars.find( "description" );
+            extra().item_vars.find( "description" );
         const cata::optional<translation> snippet = SNIPPET.get_snippet_by_id( snip_id );
         if( snippet.has_value() ) {
             // Just use the dynamic description
             info.push_back( iteminfo( "DESCRIPTION", snippet.value().translated() ) );
-        } else if( idescription != item_vars.end() ) {
+        } else if( idescription != extra().item_vars.end() ) {
             info.push_back( iteminfo( "DESCRIPTION", idescription->second ) );
         } else {
             if( has_flag( "MAGIC_FOCUS" ) ) {
@@ -1701,7 +1734,7 @@ void item::debug_info( std::vector<iteminfo> &info, const iteminfo_query *parts,
                                       burnt ) );
             const std::string tags_listed = enumerate_as_string( item_tags, enumeration_conjunction::none );
             info.push_back( iteminfo( "BASE", string_format( _( "tags: %s" ), tags_listed ) ) );
-            for( auto const &imap : item_vars ) {
+            for( auto const &imap : extra().item_vars ) {
                 info.push_back( iteminfo( "BASE",
                                           string_format( _( "item var: %s, %s" ), imap.first,
                                                   imap.second ) ) );
@@ -3556,7 +3589,7 @@ void item::combat_info( std::vector<iteminfo> &info, const iteminfo_query *parts
 
     if( parts->test( iteminfo_parts::DESCRIPTION_TECHNIQUES ) ) {
         std::set<matec_id> all_techniques = type->techniques;
-        all_techniques.insert( techniques.begin(), techniques.end() );
+        all_techniques.insert( extra().techniques.begin(), extra().techniques.end() );
 
         if( !all_techniques.empty() ) {
             insert_separation_line( info );
@@ -3897,6 +3930,7 @@ void item::final_info( std::vector<iteminfo> &info, const iteminfo_query *parts,
         }
     }
 
+    const std::map<std::string, std::string> &item_vars = extra().item_vars;
     std::map<std::string, std::string>::const_iterator item_note = item_vars.find( "item_note" );
 
     if( item_note != item_vars.end() && parts->test( iteminfo_parts::DESCRIPTION_NOTES ) ) {
@@ -4286,18 +4320,18 @@ void item::on_wear( Character &p )
         if( has_flag( flag_SPLINT ) ) {
             set_side( side::LEFT );
             if( ( covers( bodypart_id( "leg_l" ) ) && p.is_limb_broken( bodypart_id( "leg_r" ) ) &&
-                  !p.worn_with_flag( flag_SPLINT, bodypart_id( "leg_r" ) ) ) ||
+                  !p.worn_with_flag( flag_SPLINT.str(), bodypart_id( "leg_r" ) ) ) ||
                 ( covers( bodypart_id( "arm_l" ) ) && p.is_limb_broken( bodypart_id( "arm_r" ) ) &&
-                  !p.worn_with_flag( flag_SPLINT, bodypart_id( "arm_r" ) ) ) ) {
+                  !p.worn_with_flag( flag_SPLINT.str(), bodypart_id( "arm_r" ) ) ) ) {
                 set_side( side::RIGHT );
             }
         } else if( has_flag( flag_TOURNIQUET ) ) {
             set_side( side::LEFT );
             if( ( covers( bodypart_id( "leg_l" ) ) &&
                   p.has_effect( effect_bleed, bodypart_str_id( "leg_r" ) ) &&
-                  !p.worn_with_flag( flag_TOURNIQUET, bodypart_id( "leg_r" ) ) ) ||
+                  !p.worn_with_flag( flag_TOURNIQUET.str(), bodypart_id( "leg_r" ) ) ) ||
                 ( covers( bodypart_id( "arm_l" ) ) && p.has_effect( effect_bleed, bodypart_str_id( "arm_r" ) ) &&
-                  !p.worn_with_flag( flag_TOURNIQUET, bodypart_id( "arm_r" ) ) ) ) {
+                  !p.worn_with_flag( flag_TOURNIQUET.str(), bodypart_id( "arm_r" ) ) ) ) {
                 set_side( side::RIGHT );
             }
         } else {
@@ -4554,7 +4588,7 @@ std::string item::tname( unsigned int quantity, bool with_prefix, unsigned int t
     }
 
     std::string maintext;
-    if( is_corpse() || typeId() == itype_blood || item_vars.find( "name" ) != item_vars.end() ) {
+    if( is_corpse() || typeId() == itype_blood || has_var( "name" ) ) {
         maintext = type_name( quantity );
     } else if( is_gun() || is_tool() || is_magazine() ) {
         int amt = 0;
@@ -4735,7 +4769,7 @@ std::string item::tname( unsigned int quantity, bool with_prefix, unsigned int t
         ret = utf8_truncate( ret, truncate + truncate_override );
     }
 
-    if( item_vars.find( "item_note" ) != item_vars.end() ) {
+    if( has_var( "item_note" ) ) {
         //~ %s is an item name. This style is used to denote items with notes.
         return string_format( _( "*%s*" ), ret );
     } else {
@@ -5292,28 +5326,26 @@ bool item::has_fault( const fault_id &fault ) const
     return faults.count( fault );
 }
 
-bool item::has_flag( const std::string &f ) const
+bool item::has_flag( const flag_id &f ) const
 {
-    bool ret = false;
-
-    if( json_flag::get( f ).inherit() ) {
-        for( const item *e : is_gun() ? gunmods() : toolmods() ) {
-            // gunmods fired separately do not contribute to base gun flags
-            if( !e->is_gun() && e->has_flag( f ) ) {
-                return true;
-            }
+    if( f.obj().inherit() ) {
+        // gunmods fired separately do not contribute to base gun flags
+        const bool gun = is_gun();
+        const auto inherited = [gun, &f]( const item & e ) {
+            return ( gun ? e.is_gunmod() : e.is_toolmod() ) && !e.is_gun() && e.has_flag( f );
+        };
+        if( ( gun || is_tool() ) && contents.has_any_mod_with( inherited ) ) {
+            return true;
         }
     }
 
-    // other item type flags
-    ret = type->item_tags.count( f );
-    if( ret ) {
-        return ret;
-    }
+    // other item type flags, then item specific flags
+    return type->item_tags.has( f ) || item_tags.has( f );
+}
 
-    // now check for item specific flags
-    ret = item_tags.count( f );
-    return ret;
+bool item::has_flag( const std::string &f ) const
+{
+    return has_flag( flag_id( f ) );
 }
 
 bool item::has_any_flag( const std::vector<std::string> &flags ) const
@@ -5339,6 +5371,18 @@ item &item::unset_flag( const std::string &flag )
     return *this;
 }
 
+item &item::set_flag( const flag_id &flag )
+{
+    item_tags.insert( flag );
+    return *this;
+}
+
+item &item::unset_flag( const flag_id &flag )
+{
+    item_tags.erase( flag );
+    return *this;
+}
+
 item &item::set_flag_recursive( const std::string &flag )
 {
     set_flag( flag );
@@ -5415,12 +5459,12 @@ int item::get_quality( const quality_id &id ) const
 
 bool item::has_technique( const matec_id &tech ) const
 {
-    return type->techniques.count( tech ) > 0 || techniques.count( tech ) > 0;
+    return type->techniques.count( tech ) > 0 || extra().techniques.count( tech ) > 0;
 }
 
 void item::add_technique( const matec_id &tech )
 {
-    techniques.insert( tech );
+    mutable_extra().techniques.insert( tech );
 }
 
 std::vector<item *> item::toolmods()
@@ -5452,7 +5496,7 @@ std::vector<const item *> item::toolmods() const
 std::set<matec_id> item::get_techniques() const
 {
     std::set<matec_id> result = type->techniques;
-    result.insert( techniques.begin(), techniques.end() );
+    result.insert( extra().techniques.begin(), extra().techniques.end() );
     return result;
 }
 
@@ -5634,6 +5678,18 @@ int get_hourly_rotpoints_at_temp( const int temp )
     return rot_chart[temp];
 }
 
+static float rot_factor( const item &it, const float spoil_modifier )
+{
+    float factor = spoil_modifier;
+    if( it.is_corpse() && it.has_flag( flag_FIELD_DRESS ) ) {
+        factor *= 0.75;
+    }
+    if( it.item_tags.count( "MUSHY" ) ) {
+        factor *= 3.0;
+    }
+    return factor;
+}
+
 void item::calc_rot( int temp, const float spoil_modifier,
                      const time_duration &time_delta )
 {
@@ -5650,13 +5706,7 @@ void item::calc_rot( int temp, const float spoil_modifier,
     }
 
     // rot modifier
-    float factor = spoil_modifier;
-    if( is_corpse() && has_flag( flag_FIELD_DRESS ) ) {
-        factor *= 0.75;
-    }
-    if( item_tags.count( "MUSHY" ) ) {
-        factor *= 3.0;
-    }
+    const float factor = rot_factor( *this, spoil_modifier );
 
     if( item_tags.count( "COLD" ) ) {
         temp = std::min( temperatures::fridge, temp );
@@ -5674,6 +5724,36 @@ void item::calc_rot( int temp, const float spoil_modifier,
     rot += factor * time_delta / 1_hours * get_hourly_rotpoints_at_temp( temp ) * 1_turns;
 }
 
+void item::calc_rot( const temperature_history &history, const size_t from, const size_t to,
+                     const float spoil_modifier )
+{
+    // The same as calc_rot for each of the hours, see there.
+    if( from >= to || ( !is_corpse() && get_relative_rot() > 2.0 ) ) {
+        return;
+    }
+
+    if( item_tags.count( "FROZEN" ) ) {
+        return;
+    }
+
+    const float factor = rot_factor( *this, spoil_modifier );
+    const std::vector<int64_t> &sums = item_tags.count( "COLD" ) ? history.cold_rot_points :
+                                       history.rot_points;
+    // sums[from + n] - sums[from] is the rot of the first n hours.
+    std::vector<int64_t>::const_iterator last = sums.begin() + to;
+    if( !is_corpse() && factor > 0 ) {
+        // Food stops rotting after the hour that takes it past twice its shelf life.
+        const double room = ( 2 * to_turns<double>( get_shelf_life() ) - to_turns<double>( rot ) ) /
+                            factor;
+        const std::vector<int64_t>::const_iterator past = std::upper_bound( sums.begin() + from, last,
+                sums[from] + room );
+        if( past != last ) {
+            last = past;
+        }
+    }
+    rot += 1_turns * ( factor * static_cast<double>( *last - sums[from] ) );
+}
+
 void item::calc_rot_while_processing( time_duration processing_duration )
 {
     if( !item_tags.count( "PROCESSING" ) ) {
@@ -8848,8 +8928,8 @@ bool item_compare_by_charges( const item &left, const item &right )
 static const std::string USED_BY_IDS( "USED_BY_IDS" );
 bool item::already_used_by_player( const Character &p ) const
 {
-    const auto it = item_vars.find( USED_BY_IDS );
-    if( it == item_vars.end() ) {
+    const auto it = extra().item_vars.find( USED_BY_IDS );
+    if( it == extra().item_vars.end() ) {
         return false;
     }
     // USED_BY_IDS always starts *and* ends with a ';', the search string
@@ -8861,7 +8941,7 @@ bool item::already_used_by_player( const Character &p ) const
 
 void item::mark_as_used_by_player( const player &p )
 {
-    std::string &used_by_ids = item_vars[ USED_BY_IDS ];
+    std::string &used_by_ids = mutable_extra().item_vars[ USED_BY_IDS ];
     if( used_by_ids.empty() ) {
         // *always* start with a ';'
         used_by_ids = ";";
@@ -8939,13 +9019,39 @@ bool item::needs_processing() const
     return need_process;
 }
 
-int item::processing_speed() const
+// Whether processing the item itself does nothing but the temperature and rot update, which
+// happens at most every ten minutes anyway (see process_temperature_rot).
+static bool only_rots( const item &it )
 {
-    if( is_corpse() || is_food() ) {
-        return to_turns<int>( 10_minutes );
-    }
-    // Unless otherwise indicated, update every turn.
-    return 1;
+    return ( it.is_food() || it.is_corpse() ) && !it.is_tool() && it.type->emits.empty() &&
+           !it.type->countdown_action && !it.has_flag( flag_ETHEREAL_ITEM ) &&
+           !it.has_flag( flag_WET ) && !it.has_flag( flag_LITCIG ) && it.faults.empty();
+}
+
+time_duration item::processing_interval() const
+{
+    time_duration interval = 10_minutes;
+    visit_items( [&interval]( const item * it ) {
+        if( !it->active && !it->has_flag( flag_RADIO_ACTIVATION ) &&
+            !it->has_flag( flag_ETHEREAL_ITEM ) && !it->is_artifact() ) {
+            return VisitResponse::NEXT;
+        }
+        if( !only_rots( *it ) ) {
+            // Unless otherwise indicated, update every turn.
+            interval = 1_turns;
+            return VisitResponse::ABORT;
+        }
+        if( it->can_revive() ) {
+            // Nothing gets up before it is seven hours old (see ready_to_revive), so wake up
+            // right then, the usual interval applies after that.
+            const time_duration until_revivable = it->birthday() + 7_hours - calendar::turn;
+            if( until_revivable > 0_turns ) {
+                interval = std::min( interval, until_revivable );
+            }
+        }
+        return VisitResponse::NEXT;
+    } );
+    return interval;
 }
 
 void item::apply_freezerburn()
@@ -8971,7 +9077,7 @@ bool item::process_temperature_rot( float insulation, const tripoint &pos,
     }
 
     // process temperature and rot at most once every 100_turns (10 min)
-    // note we're also gated by item::processing_speed
+    // note we're also gated by item::processing_interval
     time_duration smallest_interval = 10_minutes;
     if( now - last_temp_check < smallest_interval && specific_energy > 0 ) {
         return false;
@@ -9013,8 +9119,6 @@ bool item::process_temperature_rot( float insulation, const tripoint &pos,
     if( now - time > 1_hours ) {
         // This code is for items that were left out of reality bubble for long time
 
-        const weather_generator &wgen = get_weather().get_cur_weather_gen();
-        const unsigned int seed = g->get_seed();
         int local_mod = g->new_game ? 0 : get_map().get_temperature( pos );
 
         int enviroment_mod;
@@ -9031,40 +9135,37 @@ bool item::process_temperature_rot( float insulation, const tripoint &pos,
         }
 
         // Process the past of this item in 1h chunks until there is less than 1h left.
-        time_duration time_delta = 1_hours;
-
-        while( now - time > 1_hours ) {
-            time += time_delta;
-
-            // Get the environment temperature
-            // Use weather if above ground, use map temp if below
-            double env_temperature = 0;
-            if( pos.z >= 0 && flag != temperature_flag::ROOT_CELLAR ) {
-                double weather_temperature = wgen.get_weather_temperature( pos, time, seed );
-                env_temperature = weather_temperature + enviroment_mod + local_mod;
-            } else {
-                env_temperature = AVERAGE_ANNUAL_TEMPERATURE + enviroment_mod + local_mod;
+        // The chunks end on whole hours, so the temperatures and the rot they cause are
+        // shared with the other items here.
+        const auto whole_hour_before = []( const time_point & t ) {
+            return t - ( t - calendar::turn_zero ) % 1_hours;
+        };
+        const time_point first_hour = whole_hour_before( time ) + 1_hours;
+        // The first whole hour that is at most 1h before now.
+        const time_point last_hour = whole_hour_before( now - 1_hours - 1_turns ) + 1_hours;
+        const temperature_history &history = get_weather().get_temperature_history( pos,
+                                             enviroment_mod + local_mod, flag, first_hour, last_hour );
+        // Item temperature is not tracked for hours more than 2 d ago, so neither is the rot
+        // affected by it, those hours are summed up in one go.
+        const time_point untracked_end = std::min( last_hour, whole_hour_before( now - 2_days ) );
+
+        while( time < last_hour ) {
+            if( process_rot && time >= first_hour && time > calendar::start_of_cataclysm &&
+                time < untracked_end ) {
+                calc_rot( history, history.index( time + 1_hours ), history.index( untracked_end ) + 1,
+                          spoil_modifier );
+                time = untracked_end;
+                last_temp_check = time;
+                if( has_rotten_away() && carrier == nullptr ) {
+                    // No need to track item that will be gone
+                    return true;
+                }
+                continue;
             }
 
-            switch( flag ) {
-                case temperature_flag::NORMAL:
-                    // Just use the temperature normally
-                    break;
-                case temperature_flag::FRIDGE:
-                    env_temperature = std::min( env_temperature, static_cast<double>( temperatures::fridge ) );
-                    break;
-                case temperature_flag::FREEZER:
-                    env_temperature = std::min( env_temperature, static_cast<double>( temperatures::freezer ) );
-                    break;
-                case temperature_flag::HEATER:
-                    env_temperature = std::max( env_temperature, static_cast<double>( temperatures::normal ) );
-                    break;
-                case temperature_flag::ROOT_CELLAR:
-                    env_temperature = AVERAGE_ANNUAL_TEMPERATURE;
-                    break;
-                default:
-                    debugmsg( "Temperature flag enum not valid.  Using normal temperature." );
-            }
+            const time_duration time_delta = time < first_hour ? first_hour - time : 1_hours;
+            time += time_delta;
+            const int env_temperature = history.temperatures[history.index( time )];
 
             // Calculate item temperature from environment temperature
             // If the time was more than 2 d ago we do not care about item temperature.
@@ -10004,7 +10105,7 @@ bool item::is_reloadable() const
 
 std::string item::type_name( unsigned int quantity ) const
 {
-    const auto iter = item_vars.find( "name" );
+    const auto iter = extra().item_vars.find( "name" );
     std::string ret_name;
     if( typeId() == itype_blood ) {
         if( corpse == nullptr || corpse->id.is_null() ) {
@@ -10014,7 +10115,7 @@ std::string item::type_name( unsigned int quantity ) const
                                              "%s blood",  quantity ),
                                   corpse->nname() );
         }
-    } else if( iter != item_vars.end() ) {
+    } else if( iter != extra().item_vars.end() ) {
         return iter->second;
     } else {
         ret_name = type->nname( quantity );
@@ -10051,14 +10152,14 @@ std::string item::type_name( unsigned int quantity ) const
 
     // Identify who this corpse belonged to, if applicable.
     if( corpse != nullptr && has_flag( flag_CORPSE ) ) {
-        if( corpse_name.empty() ) {
+        if( extra().corpse_name.empty() ) {
             //~ %1$s: name of corpse with modifiers;  %2$s: species name
             ret_name = string_format( pgettext( "corpse ownership qualifier", "%1$s of a %2$s" ),
                                       ret_name, corpse->nname() );
         } else {
             //~ %1$s: name of corpse with modifiers;  %2$s: proper name;  %3$s: species name
             ret_name = string_format( pgettext( "corpse ownership qualifier", "%1$s of %2$s, %3$s" ),
-                                      ret_name, corpse_name, corpse->nname() );
+                                      ret_name, extra().corpse_name, corpse->nname() );
         }
     }
 
@@ -10067,10 +10168,10 @@ std::string item::type_name( unsigned int quantity ) const
 
 std::string item::get_corpse_name()
 {
-    if( corpse_name.empty() ) {
+    if( extra().corpse_name.empty() ) {
         return std::string();
     }
-    return corpse_name;
+    return extra().corpse_name;
 }
 
 std::string item::nname( const itype_id &id, unsigned int quantity )
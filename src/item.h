@@ -8,6 +8,7 @@
 #include <functional>
 #include <list>
 #include <map>
+#include <memory>
 #include <set>
 #include <string>
 #include <type_traits>
@@ -18,6 +19,7 @@
 #include "cata_utility.h"
 #include "craft_command.h"
 #include "enums.h"
+#include "flag.h"
 #include "flat_set.h"
 #include "gun_mode.h"
 #include "io_tags.h"
@@ -51,6 +53,7 @@ struct armor_portion_data;
 struct islot_comestible;
 struct itype;
 struct mtype;
+struct temperature_history;
 struct tripoint;
 template<typename T>
 class ret_val;
@@ -791,6 +794,12 @@ class item : public visitable<item>
          * @param temp Temperature at which the rot is calculated
          */
         void calc_rot( int temp, float spoil_modifier, const time_duration &time_delta );
+        /**
+         * The same as calc_rot over the whole hours from index @p from up to @p to (exclusive) of
+         * @p history, in one go from its sums of rot points.
+         */
+        void calc_rot( const temperature_history &history, size_t from, size_t to,
+                       float spoil_modifier );
 
         /**
          * This is part of a workaround so that items don't rot away to nothing if the smoking rack
@@ -1141,9 +1150,11 @@ class item : public visitable<item>
          */
         bool needs_processing() const;
         /**
-         * The rate at which an item should be processed, in number of turns between updates.
+         * How long until processing the item (or anything inside it) can next have an effect.
+         * Items that only rot are woken up every ten minutes, corpses when they could first get
+         * up again, everything else every turn.
          */
-        int processing_speed() const;
+        time_duration processing_interval() const;
         /**
          * Process and apply artifact effects. This should be called exactly once each turn, it may
          * modify character stats (like speed, strength, ...), so call it after those have been reset.
@@ -1435,15 +1446,20 @@ class item : public visitable<item>
          * item itself (@ref item_tags). The item has the flag if it appears in either set.
          *
          * Gun mods that are attached to guns also contribute their flags to the gun item.
+         *
+         * Checking a @ref flag_id is a bit test, the string versions look up the flag_id first.
          */
         /*@{*/
+        bool has_flag( const flag_id &flag ) const;
         bool has_flag( const std::string &flag ) const;
         bool has_any_flag( const std::vector<std::string> &flags ) const;
 
         /** Idempotent filter setting an item specific flag. */
+        item &set_flag( const flag_id &flag );
         item &set_flag( const std::string &flag );
 
         /** Idempotent filter removing an item specific flag */
+        item &unset_flag( const flag_id &flag );
         item &unset_flag( const std::string &flag );
 
         /** Idempotent filter recursively setting an item specific flag on this item and its components. */
@@ -2216,15 +2232,29 @@ class item : public visitable<item>
         std::list<item> components;
         /** What faults (if any) currently apply to this item */
         std::set<fault_id> faults;
-        cata::flat_set<std::string> item_tags; // generic item specific flags
+        flag_set item_tags; // generic item specific flags
 
     private:
         safe_reference_anchor anchor;
         const itype *curammo = nullptr;
-        std::map<std::string, std::string> item_vars;
         const mtype *corpse = nullptr;
-        std::string corpse_name;       // Name of the late lamented
-        std::set<matec_id> techniques; // item specific techniques
+
+        /**
+         * Item specific state most items never get. Items without it carry none, copies share it
+         * until one of them is changed.
+         */
+        struct extra_data {
+            std::map<std::string, std::string> item_vars;
+            std::string corpse_name;       // Name of the late lamented
+            std::set<matec_id> techniques; // item specific techniques
+
+            bool empty() const;
+        };
+        std::shared_ptr<extra_data> extra_;
+        /** The item specific state, an empty one if the item has none. */
+        const extra_data &extra() const;
+        /** The item specific state for changing it, not shared with any other item. */
+        extra_data &mutable_extra();
 
         /**
          * Data for items that represent in-progress crafts.
@@ -2300,6 +2330,14 @@ class item : public visitable<item>
         bool active = false; // If true, it has active effects to be processed
         bool is_favorite = false;
 
+        /**
+         * For memory reports: the number of items sharing the item specific state of this one,
+         * 0 if it has none.
+         */
+        long extra_data_use_count() const;
+        /** Size of a block of item specific state. */
+        static size_t extra_data_size();
+
         void set_favorite( bool favorite );
         bool has_clothing_mod() const;
         float get_clothing_mod_val( clothing_mod_type type ) const;
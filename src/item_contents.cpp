@@ -1051,6 +1051,16 @@ const item &item_contents::legacy_front() const
     return *all_items_top().front();
 }
 
+bool item_contents::has_any_mod_with( const std::function<bool( const item & )> &filter ) const
+{
+    for( const item_pocket &pocket : contents ) {
+        if( pocket.is_type( item_pocket::pocket_type::MOD ) && pocket.has_any_with( filter ) ) {
+            return true;
+        }
+    }
+    return false;
+}
+
 std::vector<item *> item_contents::gunmods()
 {
     std::vector<item *> mods;
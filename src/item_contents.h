@@ -80,6 +80,8 @@ class item_contents
         // includes mods.  used for item_location::unpack()
         std::list<const item *> all_items_ptr() const;
 
+        /** Whether any item in the MOD pockets matches, without collecting them first. */
+        bool has_any_mod_with( const std::function<bool( const item & )> &filter ) const;
         /** gets all gunmods in the item */
         std::vector<item *> gunmods();
         /** gets all gunmods in the item */
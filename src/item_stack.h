@@ -6,8 +6,12 @@
 
 #include "colony.h"
 #include "item.h" // IWYU pragma: keep
+#include "pool_allocator.h"
 #include "units_fwd.h"
 
+/** The items on a map square or in a vehicle part, their memory comes from a shared pool. */
+using item_colony = cata::colony<item, cata::pool_allocator<item>>;
+
 // A wrapper class to bundle up the references needed for a caller to safely manipulate
 // items and obtain information about items at a particular map x/y location.
 // Note this does not expose the container itself,
@@ -19,15 +23,15 @@
 class item_stack
 {
     protected:
-        cata::colony<item> *items;
+        item_colony *items;
 
     public:
-        using iterator = cata::colony<item>::iterator;
-        using const_iterator = cata::colony<item>::const_iterator;
-        using reverse_iterator = cata::colony<item>::reverse_iterator;
-        using const_reverse_iterator = cata::colony<item>::const_reverse_iterator;
+        using iterator = item_colony::iterator;
+        using const_iterator = item_colony::const_iterator;
+        using reverse_iterator = item_colony::reverse_iterator;
+        using const_reverse_iterator = item_colony::const_reverse_iterator;
 
-        item_stack( cata::colony<item> *items ) : items( items ) { }
+        item_stack( item_colony *items ) : items( items ) { }
         virtual ~item_stack() = default;
 
         size_t size() const;
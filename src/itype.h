@@ -15,6 +15,7 @@
 #include "damage.h"
 #include "enums.h" // point
 #include "explosion.h"
+#include "flag.h"
 #include "game_constants.h"
 #include "item_contents.h"
 #include "item_pocket.h"
@@ -908,7 +909,7 @@ struct itype {
         /** Fields to emit when item is in active state */
         std::set<emit_id> emits;
 
-        std::set<std::string> item_tags;
+        flag_set item_tags;
         std::set<matec_id> techniques;
 
         // Minimum stat(s) or skill(s) to use the item
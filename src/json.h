@@ -445,8 +445,8 @@ class JsonIn
 
         // special case for colony as it uses `insert()` instead of `push_back()`
         // and therefore doesn't fit with vector/deque/list
-        template <typename T>
-        bool read( cata::colony<T> &v, bool throw_on_error = false ) {
+        template <typename T, typename Allocator>
+        bool read( cata::colony<T, Allocator> &v, bool throw_on_error = false ) {
             if( !test_array() ) {
                 return error_or_false( throw_on_error, "Expected json array" );
             }
@@ -692,8 +692,8 @@ class JsonOut
         }
 
         // special case for colony, since it doesn't fit in other categories
-        template <typename T>
-        void write( const cata::colony<T> &container ) {
+        template <typename T, typename Allocator>
+        void write( const cata::colony<T, Allocator> &container ) {
             write_as_array( container );
         }
 
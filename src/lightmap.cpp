@@ -1,6 +1,8 @@
 #include "lightmap.h" // IWYU pragma: associated
 #include "shadowcasting.h" // IWYU pragma: associated
 
+#include <algorithm>
+#include <array>
 #include <cmath>
 #include <cstdlib>
 #include <cstring>
@@ -30,6 +32,7 @@
 #include "string_formatter.h"
 #include "submap.h"
 #include "tileray.h"
+#include "turn_profiler.h"
 #include "type_id.h"
 #include "veh_type.h"
 #include "vehicle.h"
@@ -76,6 +79,7 @@ void map::add_light_from_items( const tripoint &p, const item_stack::iterator &b
 // TODO: Consider making this just clear the cache and dynamically fill it in as is_transparent() is called
 bool map::build_transparency_cache( const int zlev )
 {
+    turn_profiler::scoped_timer timer( turn_phase::transparency_cache );
     auto &map_cache = get_cache( zlev );
     auto &transparency_cache = map_cache.transparency_cache;
     auto &outside_cache = map_cache.outside_cache;
@@ -152,6 +156,7 @@ bool map::build_transparency_cache( const int zlev )
 
 bool map::build_vision_transparency_cache( const int zlev )
 {
+    turn_profiler::scoped_timer timer( turn_phase::vision_transparency_cache );
     auto &map_cache = get_cache( zlev );
     auto &transparency_cache = map_cache.transparency_cache;
     auto &vision_transparency_cache = map_cache.vision_transparency_cache;
@@ -209,6 +214,7 @@ void map::apply_character_light( Character &p )
 // Once this is complete, additional operations add more dynamic lighting.
 void map::build_sunlight_cache( int zlev )
 {
+    turn_profiler::scoped_timer timer( turn_phase::sunlight_cache );
     level_cache &map_cache = get_cache( zlev );
     auto &lm = map_cache.lm;
     // Grab illumination at ground level.
@@ -282,6 +288,7 @@ void map::build_sunlight_cache( int zlev )
 
 void map::generate_lightmap( const int zlev )
 {
+    turn_profiler::scoped_timer timer( turn_phase::lightmap );
     auto &map_cache = get_cache( zlev );
     auto &lm = map_cache.lm;
     auto &sm = map_cache.sm;
@@ -487,13 +494,7 @@ void map::generate_lightmap( const int zlev )
         unbuffered: (12^2)*(160*4) = apply_light_ray x 92160
         buffered:   (12*4)*(160)   = apply_light_ray x 7680
     */
-    const tripoint cache_start( 0, 0, zlev );
-    const tripoint cache_end( LIGHTMAP_CACHE_X, LIGHTMAP_CACHE_Y, zlev );
-    for( const tripoint &p : points_in_rectangle( cache_start, cache_end ) ) {
-        if( light_source_buffer[p.x][p.y] > 0.0 ) {
-            apply_light_source( p, light_source_buffer[p.x][p.y] );
-        }
-    }
+    apply_bulk_light_sources( zlev );
     for( const std::pair<tripoint, float> &elem : lm_override ) {
         lm[elem.first.x][elem.first.y].fill( elem.second );
     }
@@ -505,6 +506,156 @@ void map::add_light_source( const tripoint &p, float luminance )
     light_source_buffer[p.x][p.y] = std::max( luminance, light_source_buffer[p.x][p.y] );
 }
 
+// Upper bound of the distance apply_light_source can light up. Light falls off at least
+// with the inverse of the distance and casting stops once it drops to LIGHT_AMBIENT_LOW.
+static int light_source_reach( const float luminance )
+{
+    return std::min( 60, static_cast<int>( luminance / LIGHT_AMBIENT_LOW ) + 2 );
+}
+
+namespace
+{
+// Summed-area table of a boolean grid, answers "is any cell of this rectangle set" in O(1).
+class cell_area_sums
+{
+    public:
+        template<typename Pred>
+        explicit cell_area_sums( Pred is_set ) : sums( ( MAPSIZE_X + 1 ) * ( MAPSIZE_Y + 1 ), 0 ) {
+            for( int x = 0; x < MAPSIZE_X; ++x ) {
+                for( int y = 0; y < MAPSIZE_Y; ++y ) {
+                    at( x + 1, y + 1 ) = ( is_set( x, y ) ? 1 : 0 ) + at( x, y + 1 ) + at( x + 1, y ) - at( x, y );
+                }
+            }
+        }
+        bool any( const point &p, const int radius ) const {
+            const int x0 = std::max( p.x - radius, 0 );
+            const int y0 = std::max( p.y - radius, 0 );
+            const int x1 = std::min( p.x + radius + 1, MAPSIZE_X );
+            const int y1 = std::min( p.y + radius + 1, MAPSIZE_Y );
+            return at( x1, y1 ) - at( x0, y1 ) - at( x1, y0 ) + at( x0, y0 ) > 0;
+        }
+
+    private:
+        int &at( const int x, const int y ) {
+            return sums[x * ( MAPSIZE_Y + 1 ) + y];
+        }
+        int at( const int x, const int y ) const {
+            return sums[x * ( MAPSIZE_Y + 1 ) + y];
+        }
+
+        std::vector<int> sums;
+};
+} // namespace
+
+void map::apply_bulk_light_sources( const int zlev )
+{
+    level_cache &map_cache = get_cache( zlev );
+    const auto &light_source_buffer = map_cache.light_source_buffer;
+    const auto &transparency_cache = map_cache.transparency_cache;
+    const int map_dimensions = MAPSIZE_X * MAPSIZE_Y;
+
+    bool full_rebuild = false;
+    if( !map_cache.bulk_light ) {
+        map_cache.bulk_light = cata::make_value<bulk_light_cache>();
+        full_rebuild = true;
+    }
+    bulk_light_cache &bulk = *map_cache.bulk_light;
+    const auto &old_buffer = bulk.light_source_buffer;
+
+    // The light of a source depends on its luminance, on the luminance of its four
+    // neighbours (see apply_light_source) and on the transparency within its reach.
+    // Every source for which one of those changed marks its whole reach dirty.
+    std::unique_ptr<std::array<std::array<int, MAPSIZE_Y + 1>, MAPSIZE_X + 1>> dirty_marks;
+    if( !full_rebuild ) {
+        const auto source_changed = [&]( int x, int y ) {
+            return x >= 0 && y >= 0 && x < MAPSIZE_X && y < MAPSIZE_Y &&
+                   light_source_buffer[x][y] != old_buffer[x][y];
+        };
+        const cell_area_sums transparency_changed( [&]( int x, int y ) {
+            return transparency_cache[x][y] != bulk.transparency_cache[x][y];
+        } );
+        dirty_marks = std::make_unique<std::array<std::array<int, MAPSIZE_Y + 1>, MAPSIZE_X + 1>>();
+        auto &marks = *dirty_marks;
+        for( auto &col : marks ) {
+            col.fill( 0 );
+        }
+        bool any_dirty = false;
+        for( int x = 0; x < LIGHTMAP_CACHE_X; ++x ) {
+            for( int y = 0; y < LIGHTMAP_CACHE_Y; ++y ) {
+                const float luminance = std::max( light_source_buffer[x][y], old_buffer[x][y] );
+                if( luminance <= 0.0f ) {
+                    continue;
+                }
+                const point p( x, y );
+                const int reach = light_source_reach( luminance );
+                if( !source_changed( x, y ) && !source_changed( x - 1, y ) &&
+                    !source_changed( x + 1, y ) && !source_changed( x, y - 1 ) &&
+                    !source_changed( x, y + 1 ) && !transparency_changed.any( p, reach ) ) {
+                    continue;
+                }
+                // Difference array, resolved into the dirty area below.
+                const int x0 = std::max( x - reach, 0 );
+                const int y0 = std::max( y - reach, 0 );
+                const int x1 = std::min( x + reach + 1, MAPSIZE_X );
+                const int y1 = std::min( y + reach + 1, MAPSIZE_Y );
+                marks[x0][y0]++;
+                marks[x1][y0]--;
+                marks[x0][y1]--;
+                marks[x1][y1]++;
+                any_dirty = true;
+            }
+        }
+        if( !any_dirty ) {
+            dirty_marks.reset();
+        } else {
+            for( int x = 0; x <= MAPSIZE_X; ++x ) {
+                for( int y = 0; y <= MAPSIZE_Y; ++y ) {
+                    marks[x][y] += ( x > 0 ? marks[x - 1][y] : 0 ) + ( y > 0 ? marks[x][y - 1] : 0 ) -
+                                   ( x > 0 && y > 0 ? marks[x - 1][y - 1] : 0 );
+                }
+            }
+        }
+    }
+
+    if( full_rebuild || dirty_marks ) {
+        const auto is_dirty = [&]( int x, int y ) {
+            return full_rebuild || ( *dirty_marks )[x][y] > 0;
+        };
+        constexpr four_quadrants four_zeros( 0.0f );
+        for( int x = 0; x < MAPSIZE_X; ++x ) {
+            for( int y = 0; y < MAPSIZE_Y; ++y ) {
+                if( is_dirty( x, y ) ) {
+                    bulk.lm[x][y] = four_zeros;
+                    bulk.sm[x][y] = 0.0f;
+                }
+            }
+        }
+        const cell_area_sums dirty( is_dirty );
+        // Casting a source that did not change again is harmless outside of the dirty
+        // area, light is combined with max.
+        for( int x = 0; x < LIGHTMAP_CACHE_X; ++x ) {
+            for( int y = 0; y < LIGHTMAP_CACHE_Y; ++y ) {
+                const float luminance = light_source_buffer[x][y];
+                if( luminance > 0.0f &&
+                    ( full_rebuild || dirty.any( point( x, y ), light_source_reach( luminance ) ) ) ) {
+                    apply_light_source( tripoint( x, y, zlev ), luminance, bulk.lm, bulk.sm );
+                }
+            }
+        }
+        std::copy_n( &light_source_buffer[0][0], map_dimensions, &bulk.light_source_buffer[0][0] );
+        std::copy_n( &transparency_cache[0][0], map_dimensions, &bulk.transparency_cache[0][0] );
+    }
+
+    auto &lm = map_cache.lm;
+    auto &sm = map_cache.sm;
+    for( int x = 0; x < MAPSIZE_X; ++x ) {
+        for( int y = 0; y < MAPSIZE_Y; ++y ) {
+            lm[x][y] = elementwise_max( lm[x][y], bulk.lm[x][y] );
+            sm[x][y] = std::max( sm[x][y], bulk.sm[x][y] );
+        }
+    }
+}
+
 // Tile light/transparency: 3D
 
 lit_level map::light_at( const tripoint &p ) const
@@ -760,6 +911,8 @@ void cast_zlight_segment(
         delta.y = distance;
         bool started_block = false;
         T current_transparency = 0.0f;
+        // The cumulative transparency is fixed for the row, see castLight.
+        int intensity_dist = -1;
 
         // TODO: Precalculate min/max delta.z based on start/end and distance
         for( delta.z = 0; delta.z <= std::min( fov_3d_z_range, distance ); delta.z++ ) {
@@ -813,7 +966,10 @@ void cast_zlight_segment(
                 }
 
                 const int dist = rl_dist( tripoint_zero, delta ) + offset_distance;
-                last_intensity = calc( numerator, cumulative_transparency, dist );
+                if( dist != intensity_dist ) {
+                    last_intensity = calc( numerator, cumulative_transparency, dist );
+                    intensity_dist = dist;
+                }
 
                 if( !floor_block ) {
                     ( *output_caches[z_index] )[current.x][current.y] =
@@ -1022,6 +1178,9 @@ void castLight( Out( &output_cache )[MAPSIZE_X][MAPSIZE_Y],
         delta.y = -distance;
         bool started_row = false;
         T current_transparency = 0.0;
+        // The cumulative transparency is fixed for the row, so the intensity only has to be
+        // calculated again when the distance changes.
+        int intensity_dist = -1;
         float away = start - ( -distance + 0.5f ) / ( -distance -
                      0.5f ); //The distance between our first leadingEdge and start
 
@@ -1039,15 +1198,17 @@ void castLight( Out( &output_cache )[MAPSIZE_X][MAPSIZE_Y],
             } else if( end > trailingEdge ) {
                 break;
             }
+            T new_transparency = input_array[ current.x ][ current.y ];
             if( !started_row ) {
                 started_row = true;
-                current_transparency = input_array[ current.x ][ current.y ];
+                current_transparency = new_transparency;
             }
 
             const int dist = rl_dist( tripoint_zero, delta ) + offsetDistance;
-            last_intensity = calc( numerator, cumulative_transparency, dist );
-
-            T new_transparency = input_array[ current.x ][ current.y ];
+            if( dist != intensity_dist ) {
+                last_intensity = calc( numerator, cumulative_transparency, dist );
+                intensity_dist = dist;
+            }
 
             if( check( new_transparency, last_intensity ) ) {
                 update_output( output_cache[current.x][current.y], last_intensity,
@@ -1148,6 +1309,7 @@ castLightAll<fragment_cloud, fragment_cloud, shrapnel_calc, shrapnel_check,
  */
 void map::build_seen_cache( const tripoint &origin, const int target_z )
 {
+    turn_profiler::scoped_timer timer( turn_phase::seen_cache );
     auto &map_cache = get_cache( target_z );
     float ( &transparency_cache )[MAPSIZE_X][MAPSIZE_Y] = map_cache.vision_transparency_cache;
     float ( &seen_cache )[MAPSIZE_X][MAPSIZE_Y] = map_cache.seen_cache;
@@ -1275,8 +1437,14 @@ static bool light_check( const float &transparency, const float &intensity )
 void map::apply_light_source( const tripoint &p, float luminance )
 {
     auto &cache = get_cache( p.z );
-    four_quadrants( &lm )[MAPSIZE_X][MAPSIZE_Y] = cache.lm;
-    float ( &sm )[MAPSIZE_X][MAPSIZE_Y] = cache.sm;
+    apply_light_source( p, luminance, cache.lm, cache.sm );
+}
+
+void map::apply_light_source( const tripoint &p, float luminance,
+                              four_quadrants( &lm )[MAPSIZE_X][MAPSIZE_Y],
+                              float( &sm )[MAPSIZE_X][MAPSIZE_Y] )
+{
+    auto &cache = get_cache( p.z );
     float ( &transparency_cache )[MAPSIZE_X][MAPSIZE_Y] = cache.transparency_cache;
     float ( &light_source_buffer )[MAPSIZE_X][MAPSIZE_Y] = cache.light_source_buffer;
 
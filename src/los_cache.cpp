@@ -0,0 +1,113 @@
+#include "los_cache.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "point.h"
+
+// Must be a power of two.
+static constexpr size_t capacity = 1 << 17;
+static constexpr int capacity_bits = 17;
+// How many slots after its hash a line may end up in.
+static constexpr size_t max_probe = 8;
+
+static uint64_t pack( const tripoint &p )
+{
+    return static_cast<uint64_t>( p.x & 0x3ff ) << 16 | static_cast<uint64_t>( p.y & 0x3ff ) << 6 |
+           static_cast<uint64_t>( ( p.z + OVERMAP_DEPTH ) & 0x3f );
+}
+
+static uint64_t make_key( const tripoint &a, const tripoint &b )
+{
+    // The same key for both directions.
+    return a < b ? pack( a ) << 26 | pack( b ) : pack( b ) << 26 | pack( a );
+}
+
+static size_t home_slot( const uint64_t key )
+{
+    return static_cast<size_t>( ( key * 0x9E3779B97F4A7C15ULL ) >> ( 64 - capacity_bits ) );
+}
+
+los_cache::los_cache()
+{
+    invalidate_all();
+}
+
+const los_cache::entry *los_cache::find( const uint64_t key ) const
+{
+    if( table.empty() ) {
+        return nullptr;
+    }
+    const size_t home = home_slot( key );
+    for( size_t i = 0; i < max_probe; ++i ) {
+        const entry &e = table[( home + i ) & ( capacity - 1 )];
+        if( e.generation != 0 && e.key == key ) {
+            return &e;
+        }
+    }
+    return nullptr;
+}
+
+int los_cache::get( const tripoint &a, const tripoint &b ) const
+{
+    ++stats_.lookups;
+    const entry *const e = find( make_key( a, b ) );
+    if( e == nullptr || e->generation != generations[e->level] ) {
+        return -1;
+    }
+    ++stats_.hits;
+    return e->visible ? 1 : 0;
+}
+
+void los_cache::set( const tripoint &a, const tripoint &b, const bool visible )
+{
+    ++stats_.stores;
+    if( table.empty() ) {
+        // Allocated on first use, most maps (e.g. those used by mapgen) never look for lines.
+        table.resize( capacity );
+    }
+    const uint64_t key = make_key( a, b );
+    const size_t home = home_slot( key );
+    entry *target = nullptr;
+    for( size_t i = 0; i < max_probe; ++i ) {
+        entry &e = table[( home + i ) & ( capacity - 1 )];
+        if( e.generation != 0 && e.key == key ) {
+            target = &e;
+            break;
+        }
+        if( target == nullptr && e.generation != generations[e.level] ) {
+            // Free, or left over from an earlier generation.
+            target = &e;
+        }
+    }
+    if( target == nullptr ) {
+        target = &table[home];
+        ++stats_.evictions;
+    }
+    target->key = key;
+    target->level = a.z == b.z ? a.z + OVERMAP_DEPTH : OVERMAP_LAYERS;
+    target->generation = generations[target->level];
+    target->visible = visible;
+}
+
+void los_cache::invalidate( const int z )
+{
+    if( last_generation > std::numeric_limits<uint32_t>::max() - 2 ) {
+        invalidate_all();
+        return;
+    }
+    generations[z + OVERMAP_DEPTH] = ++last_generation;
+    generations[OVERMAP_LAYERS] = ++last_generation;
+}
+
+void los_cache::invalidate_all()
+{
+    if( last_generation > std::numeric_limits<uint32_t>::max() - levels ) {
+        // Start over before the generations wrap around and match old lines again.
+        std::fill( table.begin(), table.end(), entry() );
+        last_generation = 0;
+    }
+    for( uint32_t &generation : generations ) {
+        generation = ++last_generation;
+    }
+}
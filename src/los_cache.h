@@ -0,0 +1,74 @@
+#pragma once
+#ifndef CATA_SRC_LOS_CACHE_H
+#define CATA_SRC_LOS_CACHE_H
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "game_constants.h"
+
+struct tripoint;
+
+/**
+ * Results of @ref map::sees between pairs of map squares (in local coordinates).
+ *
+ * A line is stored under its two end points in either order. The table has a fixed size and
+ * uses open addressing, a line that finds no free slot near its hash replaces what is there.
+ *
+ * Lines are stamped with the generation of their z-level (lines between levels share an extra
+ * generation of their own), so forgetting all lines of a level after its transparency changed
+ * only bumps a number instead of touching the table.
+ */
+class los_cache
+{
+    public:
+        struct statistics {
+            uint64_t lookups = 0;
+            uint64_t hits = 0;
+            uint64_t stores = 0;
+            // Stores that replaced a valid line of another pair.
+            uint64_t evictions = 0;
+        };
+
+        los_cache();
+
+        /** 1 if the line is known to be clear, 0 if known to be blocked, -1 if not known. */
+        int get( const tripoint &a, const tripoint &b ) const;
+        void set( const tripoint &a, const tripoint &b, bool visible );
+
+        /** Forgets the lines on level z and all lines between levels. */
+        void invalidate( int z );
+        void invalidate_all();
+        /** Current generation of level z, it changes when the level is invalidated. */
+        uint32_t generation( const int z ) const {
+            return generations[z + OVERMAP_DEPTH];
+        }
+
+        const statistics &stats() const {
+            return stats_;
+        }
+        void reset_stats() {
+            stats_ = statistics();
+        }
+
+    private:
+        struct entry {
+            uint64_t key = 0;
+            // 0 is never the generation of a level, so it marks free slots.
+            uint32_t generation = 0;
+            uint8_t level = 0;
+            bool visible = false;
+        };
+        // Lines between levels use the slot after the last z-level.
+        static constexpr int levels = OVERMAP_LAYERS + 1;
+
+        const entry *find( uint64_t key ) const;
+
+        std::vector<entry> table;
+        std::array<uint32_t, levels> generations;
+        uint32_t last_generation = 0;
+        mutable statistics stats_;
+};
+
+#endif // CATA_SRC_LOS_CACHE_H
@@ -1319,10 +1319,11 @@ void main_menu::world_tab()
                     if( query_yes ) {
                         layer = 2; // Go to world submenu, not list of worlds
 
+                        // Writes still queued in the background would recreate files of the world.
+                        MAPBUFFER.reset();
                         world_generator->delete_world( all_worldnames[sel2 - 1], do_delete );
 
                         savegames.clear();
-                        MAPBUFFER.reset();
                         overmap_buffer.clear();
 
                         if( do_delete ) {
@@ -10,6 +10,7 @@
 #include <limits>
 #include <ostream>
 #include <queue>
+#include <tuple>
 #include <type_traits>
 #include <unordered_map>
 
@@ -29,6 +30,7 @@
 #include "construction.h"
 #include "coordinate_conversions.h"
 #include "creature.h"
+#include "creature_tracker.h"
 #include "cursesdef.h"
 #include "damage.h"
 #include "debug.h"
@@ -67,6 +69,7 @@
 #include "monster.h"
 #include "morale_types.h"
 #include "mtype.h"
+#include "npc.h"
 #include "optional.h"
 #include "options.h"
 #include "output.h"
@@ -85,6 +88,7 @@
 #include "timed_event.h"
 #include "translations.h"
 #include "trap.h"
+#include "turn_profiler.h"
 #include "ui_manager.h"
 #include "value_ptr.h"
 #include "veh_type.h"
@@ -93,6 +97,7 @@
 #include "vpart_range.h"
 #include "weather.h"
 #include "weighted_list.h"
+#include "worker_pool.h"
 
 static const itype_id itype_battery( "battery" );
 static const itype_id itype_chemistry_set( "chemistry_set" );
@@ -119,7 +124,7 @@ static const efftype_id effect_crushed( "crushed" );
 
 #define dbg(x) DebugLog((x),D_MAP) << __FILE__ << ":" << __LINE__ << ": "
 
-static cata::colony<item> nulitems;          // Returned when &i_at() is asked for an OOB value
+static item_colony nulitems;          // Returned when &i_at() is asked for an OOB value
 static field              nulfield;          // Returned when &field_at() is asked for an OOB value
 static level_cache        nullcache;         // Dummy cache for z-levels outside bounds
 
@@ -3814,7 +3819,7 @@ void map::shoot( const tripoint &p, projectile &proj, const bool hit_items )
     if( fields_there.field_count() > 0 ) {
         // Need to make a copy since 'remove_field' modifies the value
         field fields_copy = fields_there;
-        for( const std::pair<const field_type_id, field_entry> &fd : fields_copy ) {
+        for( const field::value_type &fd : fields_copy ) {
             if( fd.first->bash_info.str_min > 0 ) {
                 if( inc ) {
                     add_field( p, fd_fire, fd.second.get_field_intensity() - 1 );
@@ -4522,8 +4527,8 @@ void map::make_active( item_location &loc )
         debugmsg( "Tried to make active at (%d,%d) but the submap is not loaded", l.x, l.y );
         return;
     }
-    cata::colony<item> &item_stack = current_submap->get_items( l );
-    cata::colony<item>::iterator iter = item_stack.get_iterator_from_pointer( target );
+    item_colony &item_stack = current_submap->get_items( l );
+    item_colony::iterator iter = item_stack.get_iterator_from_pointer( target );
 
     if( current_submap->active_items.empty() ) {
         submaps_with_active_items.insert( tripoint( abs_sub.x + loc.position().x / SEEX,
@@ -5534,6 +5539,7 @@ bool map::add_field( const tripoint &p, const field_type_id &type, int intensity
     current_submap->is_uniform = false;
 
     if( current_submap->get_field( l ).add_field( type, intensity, age ) ) {
+        current_submap->mark_field_tile( l );
         //Only adding it to the count if it doesn't exist.
         if( !current_submap->field_count++ ) {
             get_cache( p.z ).field_cache.set( static_cast<size_t>( p.x / SEEX + ( (
@@ -6277,15 +6283,8 @@ bool map::sees( const tripoint &F, const tripoint &T, const int range,
         bresenham_slope = 0;
         return false; // Out of range!
     }
-    // Cannonicalize the order of the tripoints so the cache is reflexive.
-    const tripoint &min = F < T ? F : T;
-    const tripoint &max = !( F < T ) ? F : T;
-    // A little gross, just pack the values into a point.
-    const point key(
-        min.x << 16 | min.y << 8 | ( min.z + OVERMAP_DEPTH ),
-        max.x << 16 | max.y << 8 | ( max.z + OVERMAP_DEPTH )
-    );
-    char cached = skew_vision_cache.get( key, -1 );
+    // The cache is reflexive, a line is stored under both orders of its end points.
+    const int cached = skew_vision_cache.get( F, T );
     if( cached >= 0 ) {
         return cached > 0;
     }
@@ -6305,7 +6304,7 @@ bool map::sees( const tripoint &F, const tripoint &T, const int range,
             }
             return true;
         } );
-        skew_vision_cache.insert( 100000, key, visible ? 1 : 0 );
+        skew_vision_cache.set( F, T, visible );
         return visible;
     }
 
@@ -6338,7 +6337,7 @@ bool map::sees( const tripoint &F, const tripoint &T, const int range,
         last_point = new_point;
         return true;
     } );
-    skew_vision_cache.insert( 100000, key, visible ? 1 : 0 );
+    skew_vision_cache.set( F, T, visible );
     return visible;
 }
 
@@ -6728,6 +6727,35 @@ shift_bitset_cache<MAPSIZE_X, SEEX>( std::bitset<MAPSIZE_X *MAPSIZE_X> &cache,
 template void
 shift_bitset_cache<MAPSIZE, 1>( std::bitset<MAPSIZE *MAPSIZE> &cache, const point &s );
 
+void map::prefetch_submaps( const point &heading, const int distance )
+{
+    const tripoint abs = get_abs_sub();
+    const tripoint heading_distance( heading, distance );
+    if( heading == point_zero ||
+        ( abs == last_prefetch_origin && heading_distance == last_prefetch_heading ) ) {
+        return;
+    }
+    last_prefetch_origin = abs;
+    last_prefetch_heading = heading_distance;
+
+    const int zmin = zlevels ? -OVERMAP_DEPTH : abs.z;
+    const int zmax = zlevels ? OVERMAP_HEIGHT : abs.z;
+    // The submaps of the rows and columns the map will move onto, including the corners
+    // when heading diagonally.
+    for( int dx = -distance; dx < my_MAPSIZE + distance; dx++ ) {
+        for( int dy = -distance; dy < my_MAPSIZE + distance; dy++ ) {
+            const bool ahead_x = heading.x < 0 ? dx < 0 : heading.x > 0 && dx >= my_MAPSIZE;
+            const bool ahead_y = heading.y < 0 ? dy < 0 : heading.y > 0 && dy >= my_MAPSIZE;
+            if( !ahead_x && !ahead_y ) {
+                continue;
+            }
+            for( int z = zmin; z <= zmax; z++ ) {
+                MAPBUFFER.prefetch( tripoint( abs.x + dx, abs.y + dy, z ) );
+            }
+        }
+    }
+}
+
 void map::shift( const point &sp )
 {
     // Special case of 0-shift; refresh the map
@@ -7884,6 +7912,7 @@ int map::determine_wall_corner( const tripoint &p ) const
 
 void map::build_outside_cache( const int zlev )
 {
+    turn_profiler::scoped_timer timer( turn_phase::outside_cache );
     auto &ch = get_cache( zlev );
     if( !ch.outside_cache_dirty ) {
         return;
@@ -7944,6 +7973,7 @@ void map::build_outside_cache( const int zlev )
 void map::build_obstacle_cache( const tripoint &start, const tripoint &end,
                                 fragment_cloud( &obstacle_cache )[MAPSIZE_X][MAPSIZE_Y] )
 {
+    turn_profiler::scoped_timer timer( turn_phase::obstacle_cache );
     const point min_submap{ std::max( 0, start.x / SEEX ), std::max( 0, start.y / SEEY ) };
     const point max_submap{
         std::min( my_MAPSIZE - 1, end.x / SEEX ), std::min( my_MAPSIZE - 1, end.y / SEEY ) };
@@ -8019,6 +8049,7 @@ void map::build_obstacle_cache( const tripoint &start, const tripoint &end,
 
 bool map::build_floor_cache( const int zlev )
 {
+    turn_profiler::scoped_timer timer( turn_phase::floor_cache );
     auto &ch = get_cache( zlev );
     if( !ch.floor_cache_dirty ) {
         return false;
@@ -8093,6 +8124,7 @@ static void vehicle_caching_internal( level_cache &zch, const vpart_reference &v
 }
 void map::do_vehicle_caching( int z )
 {
+    turn_profiler::scoped_timer timer( turn_phase::vehicle_caches );
     level_cache &ch = get_cache( z );
     for( vehicle *v : ch.vehicle_list ) {
         for( const vpart_reference &vp : v->get_all_parts() ) {
@@ -8110,17 +8142,26 @@ void map::build_map_cache( const int zlev, bool skip_lightmap )
     const int minz = zlevels ? -OVERMAP_DEPTH : zlev;
     const int maxz = zlevels ? OVERMAP_HEIGHT : zlev;
     bool seen_cache_dirty = false;
-    for( int z = minz; z <= maxz; z++ ) {
+    // These builders only read the submaps and write the cache of their own z-level,
+    // so the levels are built concurrently.
+    std::array<bool, OVERMAP_LAYERS> level_changed = {};
+    // Resolve the weather id once before it's read from several threads.
+    get_weather().weather_id.obj();
+    get_worker_pool().parallel_for( minz, maxz + 1, [&]( const int z ) {
         build_outside_cache( z );
-        seen_cache_dirty |= build_transparency_cache( z );
-        seen_cache_dirty |= build_floor_cache( z );
+        bool changed = build_transparency_cache( z );
+        changed |= build_floor_cache( z );
+        level_changed[z + OVERMAP_DEPTH] = changed;
+    } );
+    // Vehicles write into the caches built above, so they are handled after the join.
+    for( int z = minz; z <= maxz; z++ ) {
+        if( level_changed[z + OVERMAP_DEPTH] ) {
+            seen_cache_dirty = true;
+            skew_vision_cache.invalidate( z );
+        }
         do_vehicle_caching( z );
     }
     seen_cache_dirty |= build_vision_transparency_cache( zlev );
-
-    if( seen_cache_dirty ) {
-        skew_vision_cache.clear();
-    }
     // Initial value is illegal player position.
     const tripoint &p = get_player_character().pos();
     static tripoint player_prev_pos;
@@ -8473,10 +8514,12 @@ void map::scent_blockers( std::array<std::array<bool, MAPSIZE_X>, MAPSIZE_Y> &bl
     };
 
     function_over( tripoint( min, abs_sub.z ), tripoint( max, abs_sub.z ), fill_values );
+}
 
+std::vector<point> map::vehicle_scent_reducers( const point &min, const point &max )
+{
     const inclusive_rectangle<point> local_bounds( min, max );
-
-    // Now vehicles
+    std::vector<point> ret;
 
     auto vehs = get_vehicles();
     for( auto &wrapped_veh : vehs ) {
@@ -8484,7 +8527,7 @@ void map::scent_blockers( std::array<std::array<bool, MAPSIZE_X>, MAPSIZE_Y> &bl
         for( const vpart_reference &vp : veh.get_any_parts( VPFLAG_OBSTACLE ) ) {
             const tripoint part_pos = vp.pos();
             if( local_bounds.contains( part_pos.xy() ) ) {
-                reduces_scent[part_pos.x][part_pos.y] = true;
+                ret.push_back( part_pos.xy() );
             }
         }
 
@@ -8496,10 +8539,13 @@ void map::scent_blockers( std::array<std::array<bool, MAPSIZE_X>, MAPSIZE_Y> &bl
 
             const tripoint part_pos = vp.pos();
             if( local_bounds.contains( part_pos.xy() ) ) {
-                reduces_scent[part_pos.x][part_pos.y] = true;
+                ret.push_back( part_pos.xy() );
             }
         }
     }
+    std::sort( ret.begin(), ret.end() );
+    ret.erase( std::unique( ret.begin(), ret.end() ), ret.end() );
+    return ret;
 }
 
 tripoint_range<tripoint> map::points_in_rectangle( const tripoint &from, const tripoint &to ) const
@@ -8606,15 +8652,37 @@ std::list<tripoint> map::find_furnitures_with_flag_in_radius( const tripoint &ce
 std::list<Creature *> map::get_creatures_in_radius( const tripoint &center, size_t radius,
         size_t radiusz )
 {
-    std::list<Creature *> creatures;
-    for( const auto &loc : points_in_radius( center, radius, radiusz ) ) {
-        Creature *tmp_critter = g->critter_at( loc );
-        if( tmp_critter != nullptr ) {
-            creatures.push_back( tmp_critter );
+    // Same as asking game::critter_at for each point, but monsters come from the spatial
+    // index of the tracker.
+    const auto in_area = [&]( const tripoint & p ) {
+        return inbounds( p ) && square_dist( p.xy(), center.xy() ) <= static_cast<int>( radius ) &&
+               std::abs( p.z - center.z ) <= static_cast<int>( radiusz );
+    };
+    std::vector<Creature *> found;
+    for( monster *mon : g->critter_tracker->find_all_near( center, radius, radiusz ) ) {
+        if( !mon->is_hallucination() && inbounds( mon->pos() ) ) {
+            found.push_back( mon );
         }
-
     }
-    return creatures;
+    const auto add_unless_taken = [&]( Creature & critter ) {
+        const tripoint &p = critter.pos();
+        if( in_area( p ) && std::none_of( found.begin(), found.end(), [&p]( const Creature * c ) {
+        return c->pos() == p;
+    } ) ) {
+            found.push_back( &critter );
+        }
+    };
+    add_unless_taken( get_player_character() );
+    for( npc &guy : g->all_npcs() ) {
+        add_unless_taken( guy );
+    }
+    // In the order of the points of the area.
+    std::sort( found.begin(), found.end(), []( const Creature * a, const Creature * b ) {
+        const tripoint &pa = a->pos();
+        const tripoint &pb = b->pos();
+        return std::tie( pa.z, pa.y, pa.x ) < std::tie( pb.z, pb.y, pb.x );
+    } );
+    return std::list<Creature *>( found.begin(), found.end() );
 }
 
 level_cache &map::access_cache( int zlev )
@@ -8674,7 +8742,9 @@ pathfinding_cache &map::get_pathfinding_cache( int zlev ) const
 void map::set_pathfinding_cache_dirty( const int zlev )
 {
     if( inbounds_z( zlev ) ) {
-        get_pathfinding_cache( zlev ).dirty = true;
+        pathfinding_cache &cache = get_pathfinding_cache( zlev );
+        cache.dirty = true;
+        cache.generation++;
     }
 }
 
@@ -8692,6 +8762,11 @@ const pathfinding_cache &map::get_pathfinding_cache_ref( int zlev ) const
     return cache;
 }
 
+int map::get_pathfinding_generation( const int zlev ) const
+{
+    return inbounds_z( zlev ) ? get_pathfinding_cache( zlev ).generation : 0;
+}
+
 void map::update_pathfinding_cache( int zlev ) const
 {
     auto &cache = get_pathfinding_cache( zlev );
@@ -28,13 +28,14 @@
 #include "item_stack.h"
 #include "lightmap.h"
 #include "line.h"
-#include "lru_cache.h"
+#include "los_cache.h"
 #include "mapdata.h"
 #include "point.h"
 #include "rng.h"
 #include "shadowcasting.h"
 #include "type_id.h"
 #include "units_fwd.h"
+#include "value_ptr.h"
 
 struct scent_block;
 template <typename T> class safe_reference;
@@ -93,6 +94,11 @@ class map;
 enum ter_bitflags : int;
 struct pathfinding_cache;
 struct pathfinding_settings;
+struct route_flow_field;
+struct route_hierarchy;
+class route_cache;
+class route_hierarchies;
+enum pf_special : int;
 template<typename T>
 struct weighted_int_list;
 
@@ -104,7 +110,7 @@ class map_stack : public item_stack
         tripoint location;
         map *myorigin;
     public:
-        map_stack( cata::colony<item> *newstack, tripoint newloc, map *neworigin ) :
+        map_stack( item_colony *newstack, tripoint newloc, map *neworigin ) :
             item_stack( newstack ), location( newloc ), myorigin( neworigin ) {}
         void insert( const item &newitem ) override;
         iterator erase( const_iterator it ) override;
@@ -156,6 +162,19 @@ struct bash_params {
     bool bashing_from_above = false;
 };
 
+/**
+ * Light cast by the bulk light sources of one z-level (see @ref map::add_light_source),
+ * kept between lightmap generations together with the source buffer and transparency
+ * it was cast with.  The result only depends on those two inputs, so after a change only
+ * the sources whose light can reach a changed cell have to be cast again.
+ */
+struct bulk_light_cache {
+    four_quadrants lm[MAPSIZE_X][MAPSIZE_Y];
+    float sm[MAPSIZE_X][MAPSIZE_Y];
+    float light_source_buffer[MAPSIZE_X][MAPSIZE_Y];
+    float transparency_cache[MAPSIZE_X][MAPSIZE_Y];
+};
+
 struct level_cache {
     // Zeros all relevant values
     level_cache();
@@ -170,6 +189,8 @@ struct level_cache {
     // To prevent redundant ray casting into neighbors: precalculate bulk light source positions.
     // This is only valid for the duration of generate_lightmap
     float light_source_buffer[MAPSIZE_X][MAPSIZE_Y];
+    // Allocated by the first lightmap generation on this z-level.
+    cata::value_ptr<bulk_light_cache> bulk_light;
     bool outside_cache[MAPSIZE_X][MAPSIZE_Y];
     bool floor_cache[MAPSIZE_X][MAPSIZE_Y];
     float transparency_cache[MAPSIZE_X][MAPSIZE_Y];
@@ -371,6 +392,13 @@ class map
          * Note: the map must have been loaded before this can be called.
          */
         void shift( const point &s );
+        /**
+         * Asks @ref mapbuffer to read the submaps beyond the edge of the map in the
+         * direction of heading in the background, so a later @ref shift finds them in
+         * memory.  Covers distance submaps past the edge, on all z-levels the map uses.
+         * Does nothing if neither the map nor the heading changed since the last call.
+         */
+        void prefetch_submaps( const point &heading, int distance );
         /**
          * Moves the map vertically to (not by!) newz.
          * Does not actually shift anything, only forces cache updates.
@@ -466,6 +494,17 @@ class map
         * Returns whether `F` sees `T` with a view range of `range`.
         */
         bool sees( const tripoint &F, const tripoint &T, int range ) const;
+        /** Hit counts of the cache behind @ref sees, for profiling. */
+        const los_cache::statistics &sees_cache_stats() const {
+            return skew_vision_cache.stats();
+        }
+        void reset_sees_cache_stats() const {
+            skew_vision_cache.reset_stats();
+        }
+        /** Changes whenever what can be seen on level z may have changed. */
+        uint32_t sees_cache_generation( const int z ) const {
+            return skew_vision_cache.generation( z );
+        }
     private:
         /**
          * Don't expose the slope adjust outside map functions.
@@ -536,6 +575,10 @@ class map
         /**
          * Calculate the best path using A*
          *
+         * Routes are remembered for the rest of the turn, and targets many creatures path to
+         * get a flow field (see @ref route_cache).  Long routes are found on an abstract graph
+         * of the submaps first (see @ref route_hierarchy).
+         *
          * @param f The source location from which to path.
          * @param t The destination to which to path.
          * @param settings Structure describing pathfinding parameters.
@@ -543,7 +586,7 @@ class map
          */
         std::vector<tripoint> route( const tripoint &f, const tripoint &t,
                                      const pathfinding_settings &settings,
-        const std::set<tripoint> &pre_closed = {{ }} ) const;
+                                     const std::set<tripoint> &pre_closed = {} ) const;
 
         // Vehicles: Common to 2D and 3D
         VehicleList get_vehicles();
@@ -1294,12 +1337,18 @@ class map
 
         // Scent propagation helpers
         /**
-         * Build the map of scent-resistant tiles.
+         * Build the map of scent-resistant tiles from terrain and furniture.
          * Should be way faster than if done in `game.cpp` using public map functions.
+         * Changes of the result bump the generation of the pathfinding cache.
          */
         void scent_blockers( std::array<std::array<bool, MAPSIZE_X>, MAPSIZE_Y> &blocks_scent,
                              std::array<std::array<bool, MAPSIZE_X>, MAPSIZE_Y> &reduces_scent,
                              const point &min, const point &max );
+        /**
+         * Tiles within the rectangle that reduce scent because of vehicle obstacles or closed doors,
+         * on top of what @ref scent_blockers finds.  Sorted, so the result can be compared.
+         */
+        std::vector<point> vehicle_scent_reducers( const point &min, const point &max );
 
         // Computers
         computer *computer_at( const tripoint &p );
@@ -1597,6 +1646,10 @@ class map
         int my_MAPSIZE;
         bool zlevels;
 
+        // Arguments of the last @ref prefetch_submaps call and where the map was then.
+        tripoint last_prefetch_origin = tripoint_min;
+        tripoint last_prefetch_heading;
+
         /**
          * Absolute coordinates of first submap (get_submap_at(0,0))
          * This is in submap coordinates (see overmapbuffer for explanation).
@@ -1696,9 +1749,15 @@ class map
         int determine_wall_corner( const tripoint &p ) const;
         // apply a circular light pattern immediately, however it's best to use...
         void apply_light_source( const tripoint &p, float luminance );
+        void apply_light_source( const tripoint &p, float luminance,
+                                 four_quadrants( &lm )[MAPSIZE_X][MAPSIZE_Y],
+                                 float( &sm )[MAPSIZE_X][MAPSIZE_Y] );
         // ...this, which will apply the light after at the end of generate_lightmap, and prevent redundant
         // light rays from causing massive slowdowns, if there's a huge amount of light.
         void add_light_source( const tripoint &p, float luminance );
+        // Casts the buffered light sources that changed since the previous lightmap into the
+        // bulk light cache of the z-level and merges the cache into the lightmap.
+        void apply_bulk_light_sources( int zlev );
         // Handle just cardinal directions and 45 deg angles.
         void apply_directional_light( const tripoint &p, int direction, float luminance );
         void apply_light_arc( const tripoint &p, int angle, float luminance, int wideangle = 30 );
@@ -1772,6 +1831,8 @@ class map
         std::array< std::unique_ptr<level_cache>, OVERMAP_LAYERS > caches;
 
         mutable std::array< std::unique_ptr<pathfinding_cache>, OVERMAP_LAYERS > pathfinding_caches;
+        mutable std::unique_ptr<route_cache> cached_routes;
+        mutable std::unique_ptr<route_hierarchies> route_graphs;
         /**
          * Set of submaps that contain active items in absolute coordinates.
          */
@@ -1780,7 +1841,7 @@ class map
         /**
          * Cache of coordinate pairs recently checked for visibility.
          */
-        mutable lru_cache<point, char> skew_vision_cache;
+        mutable los_cache skew_vision_cache;
 
         // Note: no bounds check
         level_cache &get_cache( int zlev ) const {
@@ -1789,6 +1850,35 @@ class map
 
         pathfinding_cache &get_pathfinding_cache( int zlev ) const;
 
+        // Validated for the current turn and caches.
+        route_cache &get_route_cache() const;
+        std::vector<tripoint> route_astar( const tripoint &f, const tripoint &t,
+                                           const pathfinding_settings &settings,
+                                           const std::set<tripoint> &pre_closed ) const;
+        /**
+         * Extra cost of stepping from @p from onto the adjacent, non-flat @p to.
+         * Returns one of the negative pf_step_* values of pathfinding.cpp if that's not possible.
+         */
+        int route_step_cost( const tripoint &from, const tripoint &to, pf_special to_special,
+                             const pathfinding_settings &settings ) const;
+        // Cost of a step to an adjacent tile, negative if it isn't possible.
+        int route_move_cost( const tripoint &from, const tripoint &to,
+                             const pathfinding_settings &settings ) const;
+        void build_flow_field( route_flow_field &field ) const;
+        // Dijkstra search inside the area of the field, towards or away from its target.
+        // Tiles in @p closed are not entered.
+        void search_route_area( route_flow_field &field, bool to_target,
+                                const std::set<tripoint> &closed = {} ) const;
+        std::vector<tripoint> route_from_flow_field( const route_flow_field &field,
+                const tripoint &f ) const;
+        // Brings the parts of the graph of submaps whose tiles changed up to date.
+        void update_route_hierarchy( route_hierarchy &graph ) const;
+        void build_route_hierarchy_submap( route_hierarchy &graph, const point &sm ) const;
+        // Empty if the graph doesn't connect the two points, or the tiles in pre_closed are
+        // in the way of the route it found.
+        std::vector<tripoint> route_hierarchical( const tripoint &f, const tripoint &t,
+                const pathfinding_settings &settings, const std::set<tripoint> &pre_closed ) const;
+
         visibility_variables visibility_variables_cache;
 
     public:
@@ -1797,6 +1887,11 @@ class map
         }
 
         const pathfinding_cache &get_pathfinding_cache_ref( int zlev ) const;
+        /**
+         * Changes whenever terrain or furniture on the z-level changed, unlike
+         * @ref get_pathfinding_cache_ref this doesn't update the cache.
+         */
+        int get_pathfinding_generation( int zlev ) const;
 
         void update_pathfinding_cache( int zlev ) const;
 
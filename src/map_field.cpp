@@ -413,9 +413,13 @@ bool map::process_fields_in_submap( submap *const current_submap,
     maptile map_tile( current_submap, point_zero );
     int &locx = map_tile.pos_.x;
     int &locy = map_tile.pos_.y;
-    // Loop through all tiles in this submap indicated by current_submap
+    // Loop through the tiles of this submap that have fields. Fields added to tiles
+    // further along are still processed this turn, the same as when visiting every tile.
     for( locx = 0; locx < SEEX; locx++ ) {
         for( locy = 0; locy < SEEY; locy++ ) {
+            if( !current_submap->has_field_tile( map_tile.pos_ ) ) {
+                continue;
+            }
             // This is a translation from local coordinates to submap coordinates.
             // All submaps are in one long 1d array.
             thep.x = locx + submap.x * SEEX;
@@ -854,6 +858,9 @@ bool map::process_fields_in_submap( submap *const current_submap,
                     ++it;
                 }
             }
+            if( curfield.field_count() == 0 ) {
+                current_submap->unmark_field_tile( map_tile.pos_ );
+            }
         }
     }
     const int minz = zlevels ? -OVERMAP_DEPTH : abs_sub.z;
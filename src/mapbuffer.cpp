@@ -3,6 +3,7 @@
 #include <algorithm>
 #include <exception>
 #include <functional>
+#include <iterator>
 #include <set>
 #include <sstream>
 #include <utility>
@@ -16,11 +17,16 @@
 #include "game_constants.h"
 #include "json.h"
 #include "map.h"
+#include "mapbuffer_io.h"
+#include "optional.h"
+#include "options.h"
 #include "output.h"
 #include "path_info.h"
+#include "pool_allocator.h"
 #include "popup.h"
 #include "string_formatter.h"
 #include "submap.h"
+#include "submap_storage.h"
 #include "translations.h"
 #include "ui_manager.h"
 
@@ -38,6 +44,25 @@ static std::string find_dirname( const tripoint &om_addr )
                           segment_addr.y, segment_addr.z );
 }
 
+// Region files hold the binary quads of a whole overmap.
+static std::string find_region_path( const tripoint &om_addr )
+{
+    const tripoint region_addr = omt_to_om_copy( om_addr );
+    return string_format( "%s/maps/%d.%d.%d.region", PATH_INFO::world_base_save_path(),
+                          region_addr.x, region_addr.y, region_addr.z );
+}
+
+static mapbuffer_io::quad_location locate_quad( const tripoint &om_addr )
+{
+    mapbuffer_io::quad_location loc;
+    loc.om_addr = om_addr;
+    loc.dirname = find_dirname( om_addr );
+    loc.path = find_quad_path( loc.dirname, om_addr );
+    loc.region_path = find_region_path( om_addr );
+    loc.binary = get_option<std::string>( "SUBMAP_STORAGE" ) == "binary";
+    return loc;
+}
+
 mapbuffer MAPBUFFER;
 
 mapbuffer::mapbuffer() = default;
@@ -49,10 +74,61 @@ mapbuffer::~mapbuffer()
 
 void mapbuffer::reset()
 {
+    if( io ) {
+        io->wait();
+        report_io_errors();
+        io.reset();
+    }
+    prefetch_requested.clear();
     for( auto &elem : submaps ) {
         delete elem.second;
     }
     submaps.clear();
+    // The item storage kept for reloaded submaps is of no use for another world.
+    cata::memory_pool::release();
+}
+
+mapbuffer_io &mapbuffer::get_io()
+{
+    if( !io ) {
+        io = std::make_unique<mapbuffer_io>();
+    }
+    return *io;
+}
+
+bool mapbuffer::finish_writes()
+{
+    if( !io ) {
+        return true;
+    }
+    io->wait();
+    return report_io_errors();
+}
+
+bool mapbuffer::report_io_errors()
+{
+    if( !io ) {
+        return true;
+    }
+    const std::vector<std::string> errors = io->take_errors();
+    for( const std::string &err : errors ) {
+        popup( _( "Failed to save the map: %s" ), err );
+    }
+    return errors.empty();
+}
+
+void mapbuffer::prefetch( const tripoint &p )
+{
+    const tripoint om_addr = sm_to_omt_copy( p );
+    if( submaps.count( p ) != 0 || prefetch_requested.count( om_addr ) != 0 ) {
+        return;
+    }
+    // Only meant to avoid asking for the same quads every turn.
+    if( prefetch_requested.size() > mapbuffer_io::max_prefetched * 4 ) {
+        prefetch_requested.clear();
+    }
+    prefetch_requested.insert( om_addr );
+    get_io().prefetch( locate_quad( om_addr ) );
 }
 
 bool mapbuffer::add_submap( const tripoint &p, submap *sm )
@@ -106,6 +182,7 @@ submap *mapbuffer::lookup_submap( const tripoint &p )
 void mapbuffer::save( bool delete_after_save )
 {
     assure_dir_exist( PATH_INFO::world_base_save_path() + "/maps" );
+    report_io_errors();
 
     int num_saved_submaps = 0;
     int num_total_submaps = submaps.size();
@@ -156,11 +233,91 @@ void mapbuffer::save( bool delete_after_save )
                    om_addr.y > map_origin.y + HALF_MAPSIZE );
         num_saved_submaps += 4;
     }
+    get_io().flush_regions();
     for( auto &elem : submaps_to_delete ) {
         remove_submap( elem );
     }
 }
 
+int mapbuffer::convert_storage( const bool to_binary )
+{
+    // Work on the files directly, without anything happening in the background.
+    finish_writes();
+    io.reset();
+    std::map<std::string, std::unique_ptr<submap_region>> regions;
+    const auto get_region = [&regions]( const std::string & path ) {
+        std::unique_ptr<submap_region> &region = regions[path];
+        if( !region ) {
+            region = std::make_unique<submap_region>( path );
+        }
+        return region.get();
+    };
+    const auto save_regions = [&regions]() {
+        try {
+            for( auto &region : regions ) {
+                region.second->save();
+            }
+            return true;
+        } catch( const std::exception &err ) {
+            debugmsg( "Failed to convert the map: %s", err.what() );
+            return false;
+        }
+    };
+
+    const std::string maps_dir = PATH_INFO::world_base_save_path() + "/maps";
+    int converted = 0;
+    if( to_binary ) {
+        std::vector<std::string> converted_files;
+        for( const std::string &path : get_files_from_path( ".map", maps_dir, true, true ) ) {
+            const std::vector<std::string> parts = string_split(
+                    path.substr( path.find_last_of( '/' ) + 1 ), '.' );
+            if( parts.size() != 4 ) {
+                continue;
+            }
+            tripoint om_addr;
+            try {
+                om_addr = tripoint( std::stoi( parts[0] ), std::stoi( parts[1] ), std::stoi( parts[2] ) );
+            } catch( const std::exception & ) {
+                continue;
+            }
+            std::string json;
+            const auto read_json = [&json]( std::istream & fin ) {
+                json.assign( std::istreambuf_iterator<char>( fin ), std::istreambuf_iterator<char>() );
+            };
+            if( !read_from_file( path, read_json ) ) {
+                continue;
+            }
+            get_region( find_region_path( om_addr ) )->write_quad( om_addr, json );
+            converted_files.push_back( path );
+            converted++;
+        }
+        // Only drop the JSON once everything is safely written.
+        if( save_regions() ) {
+            for( const std::string &path : converted_files ) {
+                remove_file( path );
+            }
+        }
+    } else {
+        for( const std::string &path : get_files_from_path( ".region", maps_dir, false, true ) ) {
+            submap_region &region = *get_region( path );
+            for( const tripoint &om_addr : region.get_quads() ) {
+                const std::string dirname = find_dirname( om_addr );
+                assure_dir_exist( dirname );
+                const cata::optional<std::string> json = region.read_quad( om_addr );
+                const auto write_json = [&json]( std::ostream & fout ) {
+                    fout << *json;
+                };
+                if( json && write_to_file( find_quad_path( dirname, om_addr ), write_json, "map quad" ) ) {
+                    region.remove_quad( om_addr );
+                    converted++;
+                }
+            }
+        }
+        save_regions();
+    }
+    return converted;
+}
+
 void mapbuffer::save_quad( const std::string &dirname, const std::string &filename,
                            const tripoint &om_addr, std::list<tripoint> &submaps_to_delete,
                            bool delete_after_save )
@@ -197,9 +354,7 @@ void mapbuffer::save_quad( const std::string &dirname, const std::string &filena
         return;
     }
 
-    // Don't create the directory if it would be empty
-    assure_dir_exist( dirname );
-    write_to_file( filename, [&]( std::ostream & fout ) {
+    const auto write_quad = [&]( std::ostream & fout ) {
         JsonOut jsout( fout );
         jsout.start_array();
         for( auto &submap_addr : submap_addrs ) {
@@ -234,7 +389,14 @@ void mapbuffer::save_quad( const std::string &dirname, const std::string &filena
         }
 
         jsout.end_array();
-    } );
+    };
+
+    std::ostringstream json;
+    write_quad( json );
+    mapbuffer_io::quad_location loc = locate_quad( om_addr );
+    loc.dirname = dirname;
+    loc.path = filename;
+    get_io().write( loc, json.str() );
 }
 
 // We're reading in way too many entities here to mess around with creating sub-objects and
@@ -258,11 +420,17 @@ submap *mapbuffer::unserialize_submaps( const tripoint &p )
         }
     }
 
-    using namespace std::placeholders;
-    if( !read_from_file_optional_json( quad_path, std::bind( &mapbuffer::deserialize, this, _1 ) ) ) {
+    mapbuffer_io::quad_location loc = locate_quad( om_addr );
+    loc.path = quad_path;
+    prefetch_requested.erase( om_addr );
+    const cata::optional<std::string> json = get_io().read( loc );
+    if( !json ) {
         // If it doesn't exist, trigger generating it.
         return nullptr;
     }
+    std::istringstream fin( *json );
+    JsonIn jsin( fin );
+    deserialize( jsin );
     if( submaps.count( p ) == 0 ) {
         debugmsg( "file %s did not contain the expected submap %d,%d,%d",
                   quad_path, p.x, p.y, p.z );
@@ -5,11 +5,13 @@
 #include <list>
 #include <map>
 #include <memory>
+#include <set>
 #include <string>
 
 #include "point.h"
 
 class submap;
+class mapbuffer_io;
 class JsonIn;
 
 /**
@@ -22,14 +24,25 @@ class mapbuffer
         ~mapbuffer();
 
         /** Store all submaps in this instance into savefiles.
+         * The submaps are serialized right away, but written to disk in the background
+         * (see @ref mapbuffer_io).
          * @param delete_after_save If true, the saved submaps are removed
          * from the mapbuffer (and deleted).
          **/
         void save( bool delete_after_save = false );
 
-        /** Delete all buffered submaps. **/
+        /** Delete all buffered submaps, after finishing the pending disk writes. **/
         void reset();
 
+        /**
+         * Waits until everything saved so far is written to disk.
+         * @return false if any of the background writes failed, those errors are shown.
+         */
+        bool finish_writes();
+
+        /** Starts reading the saved quad of the submap in the background, unless it's loaded. */
+        void prefetch( const tripoint &p );
+
         /** Add a new submap to the buffer.
          *
          * @param p The absolute world position in submap coordinates.
@@ -54,6 +67,14 @@ class mapbuffer
          */
         submap *lookup_submap( const tripoint &p );
 
+        /**
+         * Converts the quads of the world saved on disk between JSON files and binary region
+         * files (see @ref submap_region), regardless of the SUBMAP_STORAGE option.  Quads
+         * saved later still follow the option.
+         * @return The number of converted quads.
+         */
+        int convert_storage( bool to_binary );
+
     private:
         using submap_map_t = std::map<tripoint, submap *>;
 
@@ -74,7 +95,13 @@ class mapbuffer
         void save_quad( const std::string &dirname, const std::string &filename,
                         const tripoint &om_addr, std::list<tripoint> &submaps_to_delete,
                         bool delete_after_save );
+        mapbuffer_io &get_io();
+        // Shows the errors of the background writes, returns false if there were any.
+        bool report_io_errors();
         submap_map_t submaps;
+        std::unique_ptr<mapbuffer_io> io;
+        // Quads, in overmap terrain coordinates, prefetch was asked for.
+        std::set<tripoint> prefetch_requested;
 };
 
 extern mapbuffer MAPBUFFER;
@@ -0,0 +1,251 @@
+#include "mapbuffer_io.h"
+
+#include <algorithm>
+#include <exception>
+#include <fstream>
+#include <iterator>
+#include <ostream>
+#include <stdexcept>
+#include <utility>
+
+#include "cata_utility.h"
+#include "filesystem.h"
+#include "submap_storage.h"
+
+mapbuffer_io::mapbuffer_io() : worker( &mapbuffer_io::work, this )
+{
+}
+
+mapbuffer_io::~mapbuffer_io()
+{
+    {
+        std::lock_guard<std::mutex> lock( mutex );
+        stopping = true;
+    }
+    job_added.notify_all();
+    worker.join();
+}
+
+void mapbuffer_io::write( const quad_location &loc, std::string &&json )
+{
+    {
+        std::lock_guard<std::mutex> lock( mutex );
+        const unsigned int id = ++next_write_id;
+        const auto shared_json = std::make_shared<const std::string>( std::move( json ) );
+        pending_writes[loc.om_addr] = pending_write{ id, shared_json };
+        // Whatever was read before is outdated now.
+        const auto ready = prefetched.find( loc.om_addr );
+        if( ready != prefetched.end() ) {
+            drop_prefetched( ready );
+        }
+        jobs.push_back( job{ job_type::write, loc, shared_json, id } );
+    }
+    job_added.notify_one();
+}
+
+void mapbuffer_io::flush_regions()
+{
+    {
+        std::lock_guard<std::mutex> lock( mutex );
+        jobs.push_back( job{ job_type::flush_regions, quad_location(), nullptr } );
+    }
+    job_added.notify_one();
+}
+
+void mapbuffer_io::prefetch( const quad_location &loc )
+{
+    {
+        std::lock_guard<std::mutex> lock( mutex );
+        if( pending_writes.count( loc.om_addr ) != 0 || prefetched.count( loc.om_addr ) != 0 ) {
+            return;
+        }
+        prefetches.push_back( job{ job_type::prefetch, loc, nullptr } );
+    }
+    job_added.notify_one();
+}
+
+cata::optional<std::string> mapbuffer_io::read( const quad_location &loc )
+{
+    {
+        std::lock_guard<std::mutex> lock( mutex );
+        const auto pending = pending_writes.find( loc.om_addr );
+        if( pending != pending_writes.end() ) {
+            return *pending->second.json;
+        }
+        const auto ready = prefetched.find( loc.om_addr );
+        if( ready != prefetched.end() ) {
+            std::string json = std::move( ready->second.json );
+            drop_prefetched( ready );
+            return json;
+        }
+    }
+    return read_from_disk( loc );
+}
+
+void mapbuffer_io::wait()
+{
+    std::unique_lock<std::mutex> lock( mutex );
+    idle.wait( lock, [this]() {
+        return jobs.empty() && prefetches.empty() && !busy;
+    } );
+}
+
+std::vector<std::string> mapbuffer_io::take_errors()
+{
+    std::lock_guard<std::mutex> lock( mutex );
+    std::vector<std::string> ret;
+    ret.swap( errors );
+    return ret;
+}
+
+void mapbuffer_io::drop_prefetched( const std::map<tripoint, prefetched_quad>::iterator iter )
+{
+    prefetch_order.erase( iter->second.order );
+    prefetched.erase( iter );
+}
+
+void mapbuffer_io::work()
+{
+    std::unique_lock<std::mutex> lock( mutex );
+    while( true ) {
+        job_added.wait( lock, [this]() {
+            return stopping || !jobs.empty() || !prefetches.empty();
+        } );
+        if( stopping ) {
+            // Prefetching is pointless now, but everything saved must reach the disk.
+            prefetches.clear();
+            if( jobs.empty() ) {
+                return;
+            }
+        }
+        std::deque<job> &queue = prefetches.empty() ? jobs : prefetches;
+        job current = std::move( queue.front() );
+        queue.pop_front();
+        busy = true;
+        lock.unlock();
+        try {
+            run( current );
+        } catch( const std::exception &err ) {
+            lock.lock();
+            errors.emplace_back( err.what() );
+            lock.unlock();
+        }
+        lock.lock();
+        busy = false;
+        if( jobs.empty() && prefetches.empty() ) {
+            idle.notify_all();
+        }
+    }
+}
+
+void mapbuffer_io::run( job &j )
+{
+    const quad_location &loc = j.loc;
+    switch( j.type ) {
+        case job_type::write: {
+            // Saving in either format drops the quad from the other one, so there's only one copy.
+            if( loc.binary ) {
+                {
+                    std::lock_guard<std::mutex> lock( region_mutex );
+                    get_region( loc.region_path, true )->write_quad( loc.om_addr, *j.json );
+                }
+                if( file_exist( loc.path ) ) {
+                    remove_file( loc.path );
+                }
+            } else {
+                // Don't create the directory if it would be empty
+                assure_dir_exist( loc.dirname );
+                write_to_file( loc.path, [&j]( std::ostream & fout ) {
+                    fout << *j.json;
+                } );
+                std::lock_guard<std::mutex> lock( region_mutex );
+                if( submap_region *region = get_region( loc.region_path, false ) ) {
+                    region->remove_quad( loc.om_addr );
+                }
+            }
+            std::lock_guard<std::mutex> lock( mutex );
+            const auto pending = pending_writes.find( loc.om_addr );
+            // A later save of the same quad is still waiting.
+            if( pending != pending_writes.end() && pending->second.id == j.write_id ) {
+                pending_writes.erase( pending );
+            }
+            break;
+        }
+        case job_type::flush_regions: {
+            std::lock_guard<std::mutex> lock( region_mutex );
+            // Saved regions are read from disk again when needed, so they don't pile up in
+            // memory while the player travels.
+            for( auto iter = regions.begin(); iter != regions.end(); ) {
+                if( iter->second ) {
+                    iter->second->save();
+                }
+                iter = regions.erase( iter );
+            }
+            break;
+        }
+        case job_type::prefetch: {
+            {
+                std::lock_guard<std::mutex> lock( mutex );
+                if( pending_writes.count( loc.om_addr ) != 0 || prefetched.count( loc.om_addr ) != 0 ) {
+                    break;
+                }
+            }
+            cata::optional<std::string> json = read_from_disk( loc );
+            if( !json ) {
+                break;
+            }
+            std::lock_guard<std::mutex> lock( mutex );
+            // Saved again in the meantime, the pending write is newer.
+            if( pending_writes.count( loc.om_addr ) != 0 ) {
+                break;
+            }
+            prefetched[loc.om_addr] = prefetched_quad{ std::move( *json ),
+                                      prefetch_order.insert( prefetch_order.end(), loc.om_addr ) };
+            while( prefetch_order.size() > max_prefetched ) {
+                drop_prefetched( prefetched.find( prefetch_order.front() ) );
+            }
+            break;
+        }
+    }
+}
+
+cata::optional<std::string> mapbuffer_io::read_from_disk( const quad_location &loc )
+{
+    if( loc.binary ) {
+        if( cata::optional<std::string> json = read_from_region( loc ) ) {
+            return json;
+        }
+    }
+    if( file_exist( loc.path ) ) {
+        std::ifstream fin( loc.path, std::ios::binary );
+        std::string json( ( std::istreambuf_iterator<char>( fin ) ), std::istreambuf_iterator<char>() );
+        if( !fin || json.empty() ) {
+            throw std::runtime_error( "reading \"" + loc.path + "\" failed" );
+        }
+        return json;
+    }
+    if( !loc.binary ) {
+        return read_from_region( loc );
+    }
+    return cata::nullopt;
+}
+
+cata::optional<std::string> mapbuffer_io::read_from_region( const quad_location &loc )
+{
+    std::lock_guard<std::mutex> lock( region_mutex );
+    const submap_region *region = get_region( loc.region_path, false );
+    return region ? region->read_quad( loc.om_addr ) : cata::nullopt;
+}
+
+submap_region *mapbuffer_io::get_region( const std::string &path, const bool create )
+{
+    auto iter = regions.find( path );
+    if( iter == regions.end() ) {
+        iter = regions.emplace( path, nullptr ).first;
+    }
+    // Remember missing files as well, so they are only looked for once.
+    if( !iter->second && ( create || file_exist( path ) ) ) {
+        iter->second = std::make_unique<submap_region>( path );
+    }
+    return iter->second.get();
+}
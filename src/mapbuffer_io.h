@@ -0,0 +1,120 @@
+#pragma once
+#ifndef CATA_SRC_MAPBUFFER_IO_H
+#define CATA_SRC_MAPBUFFER_IO_H
+
+#include <condition_variable>
+#include <deque>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "optional.h"
+#include "point.h"
+
+class submap_region;
+
+/**
+ * Background thread doing the disk I/O of @ref mapbuffer: it writes the quads that were
+ * saved and reads quads the player is heading towards before they are needed.
+ *
+ * Quads are handed over as JSON text.  Serializing and creating submaps stays on the main
+ * thread, so the worker never touches game state.  A quad waiting to be written is read
+ * back from memory, so reads always see the latest save.
+ */
+class mapbuffer_io
+{
+    public:
+        /** Where a quad is saved, worked out on the main thread. */
+        struct quad_location {
+            tripoint om_addr;
+            std::string dirname;
+            std::string path;
+            std::string region_path;
+            bool binary = false;
+        };
+
+        /** Prefetched quads kept beyond this many are dropped, oldest first. */
+        static constexpr size_t max_prefetched = 256;
+
+        mapbuffer_io();
+        /** Finishes all queued work before returning. */
+        ~mapbuffer_io();
+
+        mapbuffer_io( const mapbuffer_io & ) = delete;
+        mapbuffer_io &operator=( const mapbuffer_io & ) = delete;
+
+        void write( const quad_location &loc, std::string &&json );
+        /** Writes the region files changed by the writes queued so far. */
+        void flush_regions();
+        void prefetch( const quad_location &loc );
+        /**
+         * JSON of the quad, from memory if it's waiting to be written or was prefetched,
+         * otherwise read from disk right away.  Empty if the quad was never saved.
+         * Throws std::exception if reading fails.
+         */
+        cata::optional<std::string> read( const quad_location &loc );
+
+        /** Waits until all queued work is done. */
+        void wait();
+        /** Errors of the work done in the background since the last call. */
+        std::vector<std::string> take_errors();
+
+    private:
+        enum class job_type : int {
+            write,
+            flush_regions,
+            prefetch,
+        };
+        struct job {
+            job_type type;
+            quad_location loc;
+            // Shared with @ref pending_writes, so the text is only held once.
+            std::shared_ptr<const std::string> json;
+            unsigned int write_id = 0;
+        };
+        struct pending_write {
+            unsigned int id;
+            std::shared_ptr<const std::string> json;
+        };
+        struct prefetched_quad {
+            std::string json;
+            std::list<tripoint>::iterator order;
+        };
+
+        // Requires the mutex.
+        void drop_prefetched( std::map<tripoint, prefetched_quad>::iterator iter );
+        void work();
+        void run( job &j );
+        cata::optional<std::string> read_from_disk( const quad_location &loc );
+        cata::optional<std::string> read_from_region( const quad_location &loc );
+        // Requires region_mutex.
+        submap_region *get_region( const std::string &path, bool create );
+
+        // Everything down to the thread is guarded by the mutex.
+        std::mutex mutex;
+        std::condition_variable job_added;
+        std::condition_variable idle;
+        std::deque<job> jobs;
+        // Prefetches are served before writes, so they are queued separately.
+        std::deque<job> prefetches;
+        std::map<tripoint, pending_write> pending_writes;
+        std::map<tripoint, prefetched_quad> prefetched;
+        // Oldest first.
+        std::list<tripoint> prefetch_order;
+        std::vector<std::string> errors;
+        unsigned int next_write_id = 0;
+        bool busy = false;
+        bool stopping = false;
+
+        std::mutex region_mutex;
+        // Only the regions changed since the last flush stay loaded.
+        std::map<std::string, std::unique_ptr<submap_region>> regions;
+
+        std::thread worker;
+};
+
+#endif // CATA_SRC_MAPBUFFER_IO_H
@@ -303,6 +303,13 @@ float monster::rate_target( Creature &c, float best, bool smart ) const
     return FLT_MAX;
 }
 
+// Radius of the box around a monster holding everything rate_target may rate better than
+// dist. That is often FLT_MAX, which is out of range for an int, so stop at the map's size.
+static int search_radius( const float dist )
+{
+    return static_cast<int>( std::min<float>( dist, MAPSIZE_X ) ) - 1;
+}
+
 void monster::plan()
 {
     const auto &factions = g->critter_tracker->factions();
@@ -352,8 +359,9 @@ void monster::plan()
             }
         }
         if( angers_cub_threatened > 0 ) {
-            for( monster &tmp : g->all_monsters() ) {
-                if( type->baby_monster == tmp.type->id ) {
+            for( monster *baby : g->critter_tracker->find_all_of_type( type->baby_monster ) ) {
+                monster &tmp = *baby;
+                if( !tmp.is_dead() && type->baby_monster == tmp.type->id ) {
                     // baby nearby; is the player too close?
                     dist = tmp.rate_target( player_character, dist, smart_planning );
                     if( dist <= 3 ) {
@@ -365,7 +373,7 @@ void monster::plan()
             }
         }
     } else if( friendly != 0 && !docile ) {
-        for( monster &tmp : g->all_monsters() ) {
+        const auto consider_target = [&]( monster & tmp ) {
             if( tmp.friendly == 0 ) {
                 float rating = rate_target( tmp, dist, smart_planning );
                 if( rating < dist ) {
@@ -373,6 +381,17 @@ void monster::plan()
                     dist = rating;
                 }
             }
+        };
+        if( smart_planning ) {
+            for( monster &tmp : g->all_monsters() ) {
+                consider_target( tmp );
+            }
+        } else if( dist > 1 ) {
+            // rate_target ignores anything at dist or further.
+            const int radius = search_radius( dist );
+            for( monster *tmp : g->critter_tracker->find_all_near( pos(), radius, radius ) ) {
+                consider_target( *tmp );
+            }
         }
     }
 
@@ -433,35 +452,41 @@ void monster::plan()
 
     fleeing = fleeing || ( mood == MATT_FLEE );
     if( friendly == 0 ) {
-        for( const auto &fac : factions ) {
-            auto faction_att = faction.obj().attitude( fac.first );
-            if( faction_att == MFA_NEUTRAL || faction_att == MFA_FRIENDLY ) {
-                continue;
+        const auto consider_target = [&]( monster & mon ) {
+            float rating = rate_target( mon, dist, smart_planning );
+            if( rating == dist ) {
+                ++valid_targets;
+                if( one_in( valid_targets ) ) {
+                    target = &mon;
+                }
             }
-
-            for( const weak_ptr_fast<monster> &weak : fac.second ) {
-                const shared_ptr_fast<monster> shared = weak.lock();
-                if( !shared ) {
+            if( rating < dist ) {
+                target = &mon;
+                dist = rating;
+                valid_targets = 1;
+            }
+            if( rating <= 5 ) {
+                anger += angers_hostile_near;
+                morale -= fears_hostile_near;
+            }
+        };
+        if( smart_planning ) {
+            // Ratings are scaled by the power of the target, so any distance may do.
+            for( const auto &fac : factions ) {
+                auto faction_att = faction.obj().attitude( fac.first );
+                if( faction_att == MFA_NEUTRAL || faction_att == MFA_FRIENDLY ) {
                     continue;
                 }
-                monster &mon = *shared;
-                float rating = rate_target( mon, dist, smart_planning );
-                if( rating == dist ) {
-                    ++valid_targets;
-                    if( one_in( valid_targets ) ) {
-                        target = &mon;
-                    }
-                }
-                if( rating < dist ) {
-                    target = &mon;
-                    dist = rating;
-                    valid_targets = 1;
-                }
-                if( rating <= 5 ) {
-                    anger += angers_hostile_near;
-                    morale -= fears_hostile_near;
+                for( const shared_ptr_fast<monster> &mon : fac.second ) {
+                    consider_target( *mon );
                 }
             }
+        } else if( dist > 1 ) {
+            // rate_target ignores anything at dist or further.
+            for( monster *mon : g->critter_tracker->find_hostile_near( faction, pos(),
+                    search_radius( dist ) ) ) {
+                consider_target( *mon );
+            }
         }
     }
 
@@ -478,12 +503,7 @@ void monster::plan()
     }
     swarms = swarms && target == nullptr; // Only swarm if we have no target
     if( group_morale || swarms ) {
-        for( const weak_ptr_fast<monster> &weak : myfaction_iter->second ) {
-            const shared_ptr_fast<monster> shared = weak.lock();
-            if( !shared ) {
-                continue;
-            }
-            monster &mon = *shared;
+        const auto consider_ally = [&]( monster & mon ) {
             float rating = rate_target( mon, dist, smart_planning );
             if( group_morale && rating <= 10 ) {
                 morale += 10 - rating;
@@ -500,6 +520,22 @@ void monster::plan()
                     dist = rating;
                 }
             }
+        };
+        if( smart_planning ) {
+            for( const shared_ptr_fast<monster> &shared : myfaction_iter->second ) {
+                consider_ally( *shared );
+            }
+        } else {
+            // rate_target ignores anything at dist or further, so swarming to a further ally
+            // is out and only allies close enough to boost morale or crowd us are left.
+            const float reach = std::min( dist, group_morale ? 11.0f : 5.0f );
+            const int radius = static_cast<int>( reach ) - 1;
+            if( radius > 0 ) {
+                for( monster *mon : g->critter_tracker->find_faction_near( actual_faction, pos(),
+                        radius ) ) {
+                    consider_ally( *mon );
+                }
+            }
         }
     }
 
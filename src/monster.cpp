@@ -2856,7 +2856,7 @@ void monster::hear_sound( const tripoint &source, const int vol, const int dist
     }
 
     const bool goodhearing = has_flag( MF_GOODHEARING );
-    const int volume = goodhearing ? 2 * vol - dist : vol - dist;
+    const int volume = heard_volume( vol, dist );
     // Error is based on volume, louder sound = less error
     if( volume <= 0 ) {
         return;
@@ -2890,6 +2890,22 @@ void monster::hear_sound( const tripoint &source, const int vol, const int dist
     }
 }
 
+void monster::hear_sound_trigger( const int vol, const int dist )
+{
+    if( !can_hear() ) {
+        return;
+    }
+    const int volume = heard_volume( vol, dist );
+    if( volume > 0 ) {
+        process_trigger( mon_trigger::SOUND, volume );
+    }
+}
+
+int monster::heard_volume( const int vol, const int dist ) const
+{
+    return ( has_flag( MF_GOODHEARING ) ? 2 * vol : vol ) - dist;
+}
+
 monster_horde_attraction monster::get_horde_attraction()
 {
     if( horde_attraction == MHA_NULL ) {
@@ -431,6 +431,13 @@ class monster : public Creature
          * @param distance Distance to sound source (currently just rl_dist)
          */
         void hear_sound( const tripoint &source, int vol, int distance );
+        /**
+         * Anger and fear caused by a sound the monster hears, but doesn't go looking for
+         * because it hears a louder one (see sounds::process_sounds).
+         */
+        void hear_sound_trigger( int vol, int distance );
+        /** Volume of a sound as heard by the monster, not heard at all if it's not positive. */
+        int heard_volume( int vol, int distance ) const;
 
         bool is_hallucination() const override;    // true if the monster isn't actually real
 
@@ -571,6 +571,29 @@ struct npc_short_term_cache {
     std::map<direction, float> threat_map;
     // Cache of locations the NPC has searched recently in npc::find_item()
     lru_cache<tripoint, int> searched_tiles;
+
+    // What npc::assess_danger() found out about a creature while neither of us moved
+    struct creature_scan {
+        // Expires when the creature dies, another one may be created at the same address.
+        weak_ptr_fast<Creature> who;
+        tripoint pos = tripoint_min;
+        cata::optional<bool> seen;
+        cata::optional<bool> clear_shot;
+    };
+    // Forgotten when we move, when what can be seen on our level changes or after a few turns
+    std::unordered_map<const Creature *, creature_scan> creature_scans;
+    tripoint scanned_from = tripoint_min;
+    time_point scanned_since;
+    uint32_t scanned_generation = 0;
+};
+
+// Value of an item as a weapon, as compared by npc::wield_better_weapon()
+struct npc_weapon_value {
+    itype_id type;
+    // See weapon_state() in npcmove.cpp, covers changes made to the item in place
+    size_t state = 0;
+    int ammo = 0;
+    double value = 0.0;
 };
 
 // DO NOT USE! This is old, use strings as talk topic instead, e.g. "TALK_AGREE_FOLLOW" instead of
@@ -1245,6 +1268,12 @@ class npc : public player
         std::map<std::string, time_point> complaints;
 
         npc_short_term_cache ai_cache;
+        // Kept until we carry or wear different items, or for an hour as our skills may have improved
+        std::unordered_map<const item *, npc_weapon_value> weapon_values;
+        int weapon_values_revision = -1;
+        size_t weapon_values_worn = 0;
+        time_point weapon_values_since;
+        double cached_weapon_value( const item &it, int ammo );
     public:
         /**
          * Global position, expressed in map square coordinate system
@@ -5,6 +5,7 @@
 #include <climits>
 #include <cmath>
 #include <cstdlib>
+#include <functional>
 #include <iterator>
 #include <memory>
 #include <numeric>
@@ -137,6 +138,11 @@ static constexpr float NPC_DANGER_VERY_LOW = 5.0f;
 static constexpr float NPC_DANGER_MAX = 150.0f;
 static constexpr float MAX_FLOAT = 5000000000.0f;
 
+// How long assess_danger() relies on what it found out about creatures that did not move
+static const time_duration creature_scan_lifetime = 10_turns;
+// How long wield_better_weapon() relies on the values of weapons we still carry
+static const time_duration weapon_values_lifetime = 1_hours;
+
 enum npc_action : int {
     npc_undecided = 0,
     npc_pause,
@@ -442,6 +448,45 @@ void npc::assess_danger()
         }
     }
 
+    // Seeing and having a clear shot are the expensive parts below, so they are remembered for
+    // the creatures that stay where they are while we stay where we are.
+    const uint32_t sees_generation = here.sees_cache_generation( posz() );
+    if( ai_cache.scanned_from != pos() || ai_cache.scanned_generation != sees_generation ||
+        calendar::turn >= ai_cache.scanned_since + creature_scan_lifetime ) {
+        ai_cache.creature_scans.clear();
+        ai_cache.scanned_from = pos();
+        ai_cache.scanned_generation = sees_generation;
+        ai_cache.scanned_since = calendar::turn;
+    } else {
+        for( auto iter = ai_cache.creature_scans.begin(); iter != ai_cache.creature_scans.end(); ) {
+            iter = iter->second.who.expired() ? ai_cache.creature_scans.erase( iter ) : std::next( iter );
+        }
+    }
+    const auto scan_of = [this]( const Creature & critter ) -> npc_short_term_cache::creature_scan & {
+        npc_short_term_cache::creature_scan &scan = ai_cache.creature_scans[&critter];
+        if( scan.pos != critter.pos() || scan.who.expired() ) {
+            // It moved, we have not looked at it yet or it's another creature than before
+            scan = npc_short_term_cache::creature_scan();
+            scan.who = g->shared_from( critter );
+            scan.pos = critter.pos();
+        }
+        return scan;
+    };
+    const auto can_see = [this, &scan_of]( const Creature & critter ) {
+        npc_short_term_cache::creature_scan &scan = scan_of( critter );
+        if( !scan.seen ) {
+            scan.seen = critter.is_monster() ? sees( critter ) : sees( critter.pos() );
+        }
+        return *scan.seen;
+    };
+    const auto can_shoot = [this, &scan_of]( const Creature & critter ) {
+        npc_short_term_cache::creature_scan &scan = scan_of( critter );
+        if( !scan.clear_shot ) {
+            scan.clear_shot = clear_shot_reach( pos(), critter.pos(), false );
+        }
+        return *scan.clear_shot;
+    };
+
     // find our Character friends and enemies
     std::vector<weak_ptr_fast<Creature>> hostile_guys;
     for( const npc &guy : g->all_npcs() ) {
@@ -451,7 +496,7 @@ void npc::assess_danger()
 
         if( has_faction_relationship( guy, npc_factions::watch_your_back ) ) {
             ai_cache.friends.emplace_back( g->shared_from( guy ) );
-        } else if( attitude_to( guy ) != Attitude::NEUTRAL && sees( guy.pos() ) ) {
+        } else if( attitude_to( guy ) != Attitude::NEUTRAL && can_see( guy ) ) {
             hostile_guys.emplace_back( g->shared_from( guy ) );
         }
     }
@@ -472,7 +517,7 @@ void npc::assess_danger()
         if( att != Attitude::HOSTILE && ( critter.friendly || !is_enemy() ) ) {
             continue;
         }
-        if( !sees( critter ) ) {
+        if( !can_see( critter ) ) {
             continue;
         }
         float critter_threat = evaluate_enemy( critter );
@@ -488,7 +533,7 @@ void npc::assess_danger()
             continue;
         }
         // ignore targets behind glass even if we can see them
-        if( !clear_shot_reach( pos(), critter.pos(), false ) ) {
+        if( !can_shoot( critter ) ) {
             continue;
         }
 
@@ -547,7 +592,7 @@ void npc::assess_danger()
             return 0.0f;
         }
         // ignore targets behind glass even if we can see them
-        if( !clear_shot_reach( pos(), foe.pos(), false ) ) {
+        if( !can_shoot( foe ) ) {
             return 0.0f;
         }
         bool is_too_close = dist <= def_radius;
@@ -3403,6 +3448,54 @@ bool npc::do_player_activity()
     return moves != old_moves;
 }
 
+// Changes when an item or anything in it is damaged, modded, loaded or replaced in place, none
+// of which the inventory notices.
+static size_t weapon_state( const item &it )
+{
+    size_t state = 0;
+    it.visit_items( [&state]( const item * node ) {
+        state = state * 31 + std::hash<itype_id>()( node->typeId() );
+        state = state * 31 + static_cast<size_t>( node->damage() );
+        state = state * 31 + static_cast<size_t>( node->charges );
+        return VisitResponse::NEXT;
+    } );
+    return state;
+}
+
+double npc::cached_weapon_value( const item &it, const int ammo )
+{
+    if( is_wielding( it ) ) {
+        // Cached by weapon_value() itself until we wield something else
+        return weapon_value( it, ammo );
+    }
+    // What we wear is replaced in place as well, e.g. by taking one thing off and putting
+    // another one on.
+    size_t worn_state = worn.size();
+    for( const item &armor : worn ) {
+        worn_state = worn_state * 31 + std::hash<const item *>()( &armor );
+        worn_state = worn_state * 31 + std::hash<itype_id>()( armor.typeId() );
+    }
+    if( weapon_values_revision != inv->get_revision() || weapon_values_worn != worn_state ||
+        calendar::turn >= weapon_values_since + weapon_values_lifetime ) {
+        weapon_values.clear();
+        weapon_values_revision = inv->get_revision();
+        weapon_values_worn = worn_state;
+        weapon_values_since = calendar::turn;
+    }
+    const size_t state = weapon_state( it );
+    const auto found = weapon_values.find( &it );
+    if( found != weapon_values.end() && found->second.type == it.typeId() &&
+        found->second.state == state && found->second.ammo == ammo ) {
+        return found->second.value;
+    }
+    npc_weapon_value &cached = weapon_values[&it];
+    cached.type = it.typeId();
+    cached.state = state;
+    cached.ammo = ammo;
+    cached.value = weapon_value( it, ammo );
+    return cached.value;
+}
+
 bool npc::wield_better_weapon()
 {
     // TODO: Allow wielding weaker weapons against weaker targets
@@ -3420,7 +3513,7 @@ bool npc::wield_better_weapon()
         bool allowed = can_use_gun && it.is_gun() && ( !use_silent || it.is_silent() );
         double val;
         if( !allowed ) {
-            val = weapon_value( it, 0 );
+            val = cached_weapon_value( it, 0 );
         } else {
             int ammo_count = it.ammo_remaining();
             int ups_drain = it.get_gun_ups_drain();
@@ -3428,7 +3521,7 @@ bool npc::wield_better_weapon()
                 ammo_count = std::min( ammo_count, ups_charges / ups_drain );
             }
 
-            val = weapon_value( it, ammo_count );
+            val = cached_weapon_value( it, ammo_count );
         }
 
         if( val > best_value ) {
@@ -4265,7 +4358,10 @@ void npc::go_to_omt_destination()
             }
         }
     }
-    path = here.route( pos(), centre_sub, get_pathfinding_settings(), get_path_avoid() );
+    // Only heading towards the next overmap tile, any reasonable way there will do.
+    pathfinding_settings settings = get_pathfinding_settings();
+    settings.allow_approximate = true;
+    path = here.route( pos(), centre_sub, settings, get_path_avoid() );
     add_msg( m_debug, "%s going %s->%s", name, omt_pos.to_string(), goal.to_string() );
 
     if( !path.empty() ) {
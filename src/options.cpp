@@ -17,6 +17,7 @@
 #include "game_constants.h"
 #include "input.h"
 #include "json.h"
+#include "mapbuffer.h"
 #include "mapsharing.h"
 #include "output.h"
 #include "path_info.h"
@@ -2006,6 +2007,12 @@ void options_manager::add_options_world_default()
     }, "reset"
        );
 
+    add( "SUBMAP_STORAGE", "world_default", translate_marker( "Map storage format" ),
+         translate_marker( "How the map of the world is saved.  JSON files are easy to edit, compressed binary files take a fraction of the disk space.  Parts of the map that were saved before are converted when they are saved again, or all at once when the option is changed during a game." ),
+    { { "json", translate_marker( "JSON" ) }, { "binary", translate_marker( "Compressed binary" ) } },
+    "json"
+       );
+
     add_empty_line();
 
     add( "CITY_SIZE", "world_default", translate_marker( "Size of cities" ),
@@ -2906,6 +2913,11 @@ std::string options_manager::show( bool ingame, const bool world_options_only,
             if( ingame && world_options_changed ) {
                 world_generator->active_world->WORLD_OPTIONS = ACTIVE_WORLD_OPTIONS;
                 world_generator->active_world->save();
+                if( WOPTIONS_OLD["SUBMAP_STORAGE"] != ACTIVE_WORLD_OPTIONS["SUBMAP_STORAGE"] &&
+                    query_yn( _( "Convert the map saved so far to the new format now?" ) ) ) {
+                    const bool to_binary = ACTIVE_WORLD_OPTIONS["SUBMAP_STORAGE"].getValue() == "binary";
+                    MAPBUFFER.convert_storage( to_binary );
+                }
             }
             g->on_options_changed();
         } else {
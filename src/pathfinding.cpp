@@ -1,5 +1,6 @@
 #include "pathfinding.h"
 
+#include <climits>
 #include <cstdlib>
 #include <algorithm>
 #include <queue>
@@ -9,9 +10,11 @@
 #include <utility>
 #include <vector>
 
+#include "calendar.h"
 #include "cata_utility.h"
 #include "coordinates.h"
 #include "debug.h"
+#include "hash_utils.h"
 #include "map.h"
 #include "mapdata.h"
 #include "optional.h"
@@ -176,6 +179,593 @@ bool is_disjoint( const Set1 &set1, const Set2 &set2 )
     return true;
 }
 
+// Results of map::route_step_cost that aren't a cost.
+// The tile can't be entered from this side.
+static constexpr int pf_step_blocked = -1;
+// The tile can't be entered at all.
+static constexpr int pf_step_closed = -2;
+// The tile is a ledge that is jumped down from instead of being entered.
+static constexpr int pf_step_ledge = -3;
+
+// 7 3 5
+// 1 . 2
+// 6 4 8
+static constexpr std::array<int, 8> x_offset{{ -1,  1,  0,  0,  1, -1, -1, 1 }};
+static constexpr std::array<int, 8> y_offset{{  0,  0, -1,  1, -1,  1, -1, 1 }};
+
+int map::route_step_cost( const tripoint &from, const tripoint &to, const pf_special to_special,
+                          const pathfinding_settings &settings ) const
+{
+    const int bash = settings.bash_strength;
+    const int climb_cost = settings.climb_cost;
+    const bool doors = settings.allow_open_doors;
+
+    if( settings.avoid_rough_terrain ) {
+        // Close all rough terrain tiles
+        return pf_step_closed;
+    }
+
+    int part = -1;
+    const maptile &tile = maptile_at_internal( to );
+    const auto &terrain = tile.get_ter_t();
+    const auto &furniture = tile.get_furn_t();
+    const vehicle *veh = veh_at_internal( to, part );
+
+    const int cost = move_cost_internal( furniture, terrain, veh, part );
+    // Don't calculate bash rating unless we intend to actually use it
+    const int rating = ( bash == 0 || cost != 0 ) ? -1 :
+                       bash_rating_internal( bash, furniture, terrain, false, veh, part );
+
+    if( cost == 0 && rating <= 0 && ( !doors || !terrain.open || !furniture.open ) && veh == nullptr &&
+        climb_cost <= 0 ) {
+        return pf_step_closed;
+    }
+
+    int step_cost = cost;
+    if( cost == 0 ) {
+        if( climb_cost > 0 && to_special & PF_CLIMBABLE ) {
+            // Climbing fences
+            step_cost += climb_cost;
+        } else if( doors && ( terrain.open || furniture.open ) &&
+                   ( !terrain.has_flag( "OPENCLOSE_INSIDE" ) || !furniture.has_flag( "OPENCLOSE_INSIDE" ) ||
+                     !is_outside( from ) ) ) {
+            // Only try to open INSIDE doors from the inside
+            // To open and then move onto the tile
+            step_cost += 4;
+        } else if( veh != nullptr ) {
+            const auto vpobst = vpart_position( const_cast<vehicle &>( *veh ), part ).obstacle_at_part();
+            part = vpobst ? vpobst->part_index() : -1;
+            int dummy = -1;
+            if( doors && veh->part_flag( part, VPFLAG_OPENABLE ) &&
+                ( !veh->part_flag( part, "OPENCLOSE_INSIDE" ) ||
+                  veh_at_internal( from, dummy ) == veh ) ) {
+                // Handle car doors, but don't try to path through curtains
+                step_cost += 10; // One turn to open, 4 to move there
+            } else if( part >= 0 && bash > 0 ) {
+                // Car obstacle that isn't a door
+                // TODO: Account for armor
+                int hp = veh->cpart( part ).hp();
+                if( hp / 20 > bash ) {
+                    // Threshold damage thing means we just can't bash this down
+                    return pf_step_closed;
+                } else if( hp / 10 > bash ) {
+                    // Threshold damage thing means we will fail to deal damage pretty often
+                    hp *= 2;
+                }
+
+                step_cost += 2 * hp / bash + 8 + 4;
+            } else if( part >= 0 ) {
+                if( !doors || !veh->part_flag( part, VPFLAG_OPENABLE ) ) {
+                    // Won't be openable, don't try from other sides
+                    return pf_step_closed;
+                }
+
+                return pf_step_blocked;
+            }
+        } else if( rating > 1 ) {
+            // Expected number of turns to bash it down, 1 turn to move there
+            // and 5 turns of penalty not to trash everything just because we can
+            step_cost += ( 20 / rating ) + 2 + 10;
+        } else if( rating == 1 ) {
+            // Desperate measures, avoid whenever possible
+            step_cost += 500;
+        } else {
+            // Unbashable and unopenable from here
+            if( !doors || !terrain.open || !furniture.open ) {
+                // Or anywhere else for that matter
+                return pf_step_closed;
+            }
+
+            return pf_step_blocked;
+        }
+    }
+
+    if( settings.avoid_traps && to_special & PF_TRAP ) {
+        const auto &ter_trp = terrain.trap.obj();
+        const auto &trp = ter_trp.is_benign() ? tile.get_trap_t() : ter_trp;
+        if( !trp.is_benign() ) {
+            // For now make them detect all traps
+            if( has_zlevels() && terrain.has_flag( TFLAG_NO_FLOOR ) ) {
+                // Special case - ledge in z-levels
+                // Warning: really expensive, needs a cache
+                if( valid_move( to, tripoint( to.xy(), to.z - 1 ), false, true ) ) {
+                    return pf_step_ledge;
+                }
+            } else {
+                // Otherwise it's walkable
+                step_cost += 500;
+            }
+        }
+    }
+
+    if( settings.avoid_sharp && to_special & PF_SHARP ) {
+        // Avoid sharp things
+        return pf_step_closed;
+    }
+
+    return step_cost;
+}
+
+void route_cache::validate( const time_point &turn, const tripoint &abs_sub,
+                            const std::array<int, OVERMAP_LAYERS> &generations )
+{
+    if( turn == this->turn && abs_sub == this->abs_sub && generations == this->generations ) {
+        return;
+    }
+    this->turn = turn;
+    this->abs_sub = abs_sub;
+    this->generations = generations;
+    routes.clear();
+    flow_fields.clear();
+}
+
+const std::vector<tripoint> *route_cache::find( const tripoint &f, const tripoint &t,
+        const pathfinding_settings &settings, const std::set<tripoint> &pre_closed ) const
+{
+    for( const route_entry &entry : routes ) {
+        if( entry.from == f && entry.to == t && entry.settings == settings &&
+            entry.pre_closed == pre_closed ) {
+            return &entry.route;
+        }
+    }
+    return nullptr;
+}
+
+void route_cache::remember( const tripoint &f, const tripoint &t,
+                            const pathfinding_settings &settings,
+                            const std::set<tripoint> &pre_closed, const std::vector<tripoint> &route )
+{
+    if( routes.size() < max_routes ) {
+        routes.push_back( route_entry{ f, t, settings, pre_closed, route } );
+    }
+}
+
+route_flow_field &route_cache::flow_field( const tripoint &t, const pathfinding_settings &settings )
+{
+    for( route_flow_field &field : flow_fields ) {
+        if( field.target == t && field.settings == settings ) {
+            field.requests++;
+            return field;
+        }
+    }
+    flow_fields.emplace_back();
+    route_flow_field &field = flow_fields.back();
+    field.target = t;
+    field.settings = settings;
+    field.requests = 1;
+    return field;
+}
+
+route_cache &map::get_route_cache() const
+{
+    if( !cached_routes ) {
+        cached_routes = std::make_unique<route_cache>();
+    }
+    std::array<int, OVERMAP_LAYERS> generations;
+    for( int i = 0; i < OVERMAP_LAYERS; ++i ) {
+        generations[i] = pathfinding_caches[i]->generation;
+    }
+    cached_routes->validate( calendar::turn, abs_sub, generations );
+    return *cached_routes;
+}
+
+int map::route_move_cost( const tripoint &from, const tripoint &to,
+                          const pathfinding_settings &settings ) const
+{
+    static const auto non_normal = PF_SLOW | PF_WALL | PF_VEHICLE | PF_TRAP | PF_SHARP;
+    const pf_special to_special = get_pathfinding_cache_ref( to.z ).special[to.x][to.y];
+    const int diagonal = from.x != to.x && from.y != to.y ? 1 : 0;
+    if( !( to_special & non_normal ) ) {
+        return diagonal + 2;
+    }
+    const int cost = route_step_cost( from, to, to_special, settings );
+    return cost < 0 ? -1 : diagonal + cost;
+}
+
+void map::build_flow_field( route_flow_field &field ) const
+{
+    const tripoint &t = field.target;
+    // Everything route_astar could search for a source within settings.max_dist.
+    const int radius = field.settings.max_dist + 16;
+    int minx = t.x - radius;
+    int miny = t.y - radius;
+    int maxx = t.x + radius;
+    int maxy = t.y + radius;
+    clip_to_bounds( minx, miny );
+    clip_to_bounds( maxx, maxy );
+    field.min = point( minx, miny );
+    field.max = point( maxx, maxy );
+    search_route_area( field, true );
+}
+
+void map::search_route_area( route_flow_field &field, const bool to_target,
+                              const std::set<tripoint> &closed ) const
+{
+    const tripoint &t = field.target;
+    const pathfinding_settings &settings = field.settings;
+    const size_t area = static_cast<size_t>( ( field.max.x - field.min.x + 1 ) *
+                        ( field.max.y - field.min.y + 1 ) );
+    field.cost.assign( area, INT_MAX );
+    field.next_step.assign( area, -1 );
+    field.built = true;
+
+    std::priority_queue<std::pair<int, point>, std::vector<std::pair<int, point>>, pair_greater_cmp_first>
+    open;
+    field.cost[field.index( t.xy() )] = 0;
+    open.push( std::make_pair( 0, t.xy() ) );
+    while( !open.empty() ) {
+        const std::pair<int, point> top = open.top();
+        open.pop();
+        const point &cur = top.second;
+        if( top.first > field.cost[field.index( cur )] || top.first > settings.max_length ) {
+            continue;
+        }
+        for( size_t i = 0; i < 8; i++ ) {
+            const point next( cur.x + x_offset[i], cur.y + y_offset[i] );
+            if( !field.covers( next ) ) {
+                continue;
+            }
+            const tripoint cur_p( cur, t.z );
+            const tripoint next_p( next, t.z );
+            if( !closed.empty() && closed.count( next_p ) ) {
+                continue;
+            }
+            // Towards the target the step goes from next to cur.
+            const int cost = to_target ? route_move_cost( next_p, cur_p, settings ) :
+                             route_move_cost( cur_p, next_p, settings );
+            if( cost < 0 ) {
+                continue;
+            }
+            const int next_index = field.index( next );
+            const int new_cost = top.first + cost;
+            if( new_cost < field.cost[next_index] ) {
+                field.cost[next_index] = new_cost;
+                // Stepping back the opposite way leads to cur.
+                field.next_step[next_index] = static_cast<signed char>( i );
+                open.push( std::make_pair( new_cost, next ) );
+            }
+        }
+    }
+}
+
+// Path from the target of a search away from it to p, without the target.
+static std::vector<tripoint> route_to_searched_tile( const route_flow_field &field,
+        const point &p )
+{
+    std::vector<tripoint> ret;
+    point cur = p;
+    while( cur != field.target.xy() ) {
+        ret.emplace_back( cur, field.target.z );
+        const int dir = field.next_step[field.index( cur )];
+        if( dir < 0 ) {
+            debugmsg( "Broken route search at %d:%d:%d", cur.x, cur.y, field.target.z );
+            return std::vector<tripoint>();
+        }
+        cur -= point( x_offset[dir], y_offset[dir] );
+    }
+    std::reverse( ret.begin(), ret.end() );
+    return ret;
+}
+
+std::vector<tripoint> map::route_from_flow_field( const route_flow_field &field,
+        const tripoint &f ) const
+{
+    std::vector<tripoint> ret;
+    if( field.cost[field.index( f.xy() )] > field.settings.max_length ) {
+        return ret;
+    }
+    ret.reserve( rl_dist( f, field.target ) * 2 );
+    point cur = f.xy();
+    while( cur != field.target.xy() ) {
+        const int dir = field.next_step[field.index( cur )];
+        if( dir < 0 ) {
+            debugmsg( "Broken flow field at %d:%d:%d", cur.x, cur.y, f.z );
+            return std::vector<tripoint>();
+        }
+        cur -= point( x_offset[dir], y_offset[dir] );
+        ret.emplace_back( cur, f.z );
+    }
+    return ret;
+}
+
+constexpr int route_hierarchy::min_distance;
+
+const route_hierarchy::node *route_hierarchy::find_node( const point &sm, const point &p ) const
+{
+    for( const node &n : submaps[sm.x * MAPSIZE + sm.y].nodes ) {
+        if( n.pos == p ) {
+            return &n;
+        }
+    }
+    return nullptr;
+}
+
+route_hierarchy &route_hierarchies::get( const pathfinding_settings &settings, const int zlev )
+{
+    for( route_hierarchy &graph : hierarchies ) {
+        if( graph.zlev == zlev && graph.settings == settings ) {
+            return graph;
+        }
+    }
+    if( hierarchies.size() >= max_hierarchies ) {
+        hierarchies.pop_front();
+    }
+    hierarchies.emplace_back();
+    route_hierarchy &graph = hierarchies.back();
+    graph.settings = settings;
+    graph.zlev = zlev;
+    return graph;
+}
+
+void map::update_route_hierarchy( route_hierarchy &graph ) const
+{
+    const pathfinding_cache &pf_cache = get_pathfinding_cache_ref( graph.zlev );
+    if( graph.generation == pf_cache.generation ) {
+        return;
+    }
+    graph.generation = pf_cache.generation;
+
+    std::array<bool, MAPSIZE *MAPSIZE> changed = {};
+    for( int smx = 0; smx < my_MAPSIZE; ++smx ) {
+        for( int smy = 0; smy < my_MAPSIZE; ++smy ) {
+            size_t signature = 0;
+            for( int x = smx * SEEX; x < ( smx + 1 ) * SEEX; ++x ) {
+                for( int y = smy * SEEY; y < ( smy + 1 ) * SEEY; ++y ) {
+                    const tripoint p( x, y, graph.zlev );
+                    const maptile &tile = maptile_at_internal( p );
+                    cata::hash_combine( signature, static_cast<int>( pf_cache.special[x][y] ) );
+                    cata::hash_combine( signature, tile.get_ter().to_i() );
+                    cata::hash_combine( signature, tile.get_furn().to_i() );
+                    cata::hash_combine( signature, tile.get_trap().to_i() );
+                    if( pf_cache.special[x][y] & PF_VEHICLE ) {
+                        int part = -1;
+                        cata::hash_combine( signature, veh_at_internal( p, part ) );
+                        cata::hash_combine( signature, part );
+                    }
+                }
+            }
+            route_hierarchy::submap_graph &sm_graph = graph.submaps[smx * MAPSIZE + smy];
+            if( !sm_graph.built || sm_graph.signature != signature ) {
+                sm_graph.signature = signature;
+                changed[smx * MAPSIZE + smy] = true;
+            }
+        }
+    }
+
+    // Entrances depend on the tiles on both sides of a border, so the neighbours of
+    // changed submaps are rebuilt as well.
+    for( int smx = 0; smx < my_MAPSIZE; ++smx ) {
+        for( int smy = 0; smy < my_MAPSIZE; ++smy ) {
+            const point sm( smx, smy );
+            bool rebuild = changed[smx * MAPSIZE + smy];
+            for( const point &offset : four_adjacent_offsets ) {
+                const point other = sm + offset;
+                if( other.x >= 0 && other.y >= 0 && other.x < my_MAPSIZE && other.y < my_MAPSIZE ) {
+                    rebuild = rebuild || changed[other.x * MAPSIZE + other.y];
+                }
+            }
+            if( rebuild ) {
+                build_route_hierarchy_submap( graph, sm );
+            }
+        }
+    }
+}
+
+void map::build_route_hierarchy_submap( route_hierarchy &graph, const point &sm ) const
+{
+    const pathfinding_settings &settings = graph.settings;
+    route_hierarchy::submap_graph &sm_graph = graph.submaps[sm.x * MAPSIZE + sm.y];
+    sm_graph.built = true;
+    sm_graph.nodes.clear();
+
+    const point origin( sm.x * SEEX, sm.y * SEEY );
+    const auto add_entrance = [&]( const tripoint & inside, const tripoint & outside ) {
+        const int cost = route_move_cost( inside, outside, settings );
+        auto iter = std::find_if( sm_graph.nodes.begin(), sm_graph.nodes.end(),
+        [&inside]( const route_hierarchy::node & n ) {
+            return n.pos == inside.xy();
+        } );
+        if( iter == sm_graph.nodes.end() ) {
+            sm_graph.nodes.push_back( route_hierarchy::node{ inside.xy(), {} } );
+            iter = sm_graph.nodes.end() - 1;
+        }
+        if( cost >= 0 ) {
+            iter->edges.push_back( route_hierarchy::edge{ outside.xy(), cost } );
+        }
+    };
+    for( const point &side : four_adjacent_offsets ) {
+        const point other = sm + side;
+        if( other.x < 0 || other.y < 0 || other.x >= my_MAPSIZE || other.y >= my_MAPSIZE ) {
+            continue;
+        }
+        // The border tiles of this submap, in the same order seen from either side.
+        const point along = side.x != 0 ? point_south : point_east;
+        const point first = origin + point( side.x > 0 ? SEEX - 1 : 0, side.y > 0 ? SEEY - 1 : 0 );
+        const auto border_tile = [&]( const int k ) {
+            return tripoint( first + along * k, graph.zlev );
+        };
+        int run_start = -1;
+        for( int k = 0; k <= SEEX; ++k ) {
+            bool crossable = false;
+            if( k < SEEX ) {
+                const tripoint inside = border_tile( k );
+                const tripoint outside = inside + side;
+                crossable = route_move_cost( inside, outside, settings ) >= 0 ||
+                            route_move_cost( outside, inside, settings ) >= 0;
+            }
+            if( crossable && run_start < 0 ) {
+                run_start = k;
+            } else if( !crossable && run_start >= 0 ) {
+                const int run_end = k - 1;
+                // Long stretches, like open fields, also get an entrance at either end so
+                // routes don't have to bend towards the middle.
+                const int middle = ( run_start + run_end ) / 2;
+                add_entrance( border_tile( middle ), border_tile( middle ) + side );
+                if( run_end - run_start >= 5 ) {
+                    add_entrance( border_tile( run_start ), border_tile( run_start ) + side );
+                    add_entrance( border_tile( run_end ), border_tile( run_end ) + side );
+                }
+                run_start = -1;
+            }
+        }
+    }
+
+    // Costs between the entrances, staying inside the submap.
+    route_flow_field search;
+    search.settings = settings;
+    search.min = origin;
+    search.max = origin + point( SEEX - 1, SEEY - 1 );
+    for( route_hierarchy::node &from : sm_graph.nodes ) {
+        search.target = tripoint( from.pos, graph.zlev );
+        search_route_area( search, false );
+        for( const route_hierarchy::node &to : sm_graph.nodes ) {
+            const int cost = search.cost[search.index( to.pos )];
+            if( &to != &from && cost <= settings.max_length ) {
+                from.edges.push_back( route_hierarchy::edge{ to.pos, cost } );
+            }
+        }
+    }
+}
+
+std::vector<tripoint> map::route_hierarchical( const tripoint &f, const tripoint &t,
+        const pathfinding_settings &settings, const std::set<tripoint> &pre_closed ) const
+{
+    if( !route_graphs ) {
+        route_graphs = std::make_unique<route_hierarchies>();
+    }
+    route_hierarchy &graph = route_graphs->get( settings, f.z );
+    update_route_hierarchy( graph );
+
+    const auto submap_of = []( const point & p ) {
+        return point( p.x / SEEX, p.y / SEEY );
+    };
+    const point f_sm = submap_of( f.xy() );
+    const point t_sm = submap_of( t.xy() );
+    // The graph doesn't know about pre_closed, so the tiles are only avoided within the
+    // submaps. Start and end are never closed, as with route_astar.
+    std::set<tripoint> closed = pre_closed;
+    closed.erase( f );
+    closed.erase( t );
+    const auto is_closed = [&closed, &f]( const point & p ) {
+        return closed.count( tripoint( p, f.z ) ) > 0;
+    };
+    const auto submap_search = [&]( const tripoint & p, const point & sm, const bool to_target ) {
+        route_flow_field search;
+        search.target = p;
+        search.settings = settings;
+        search.min = point( sm.x * SEEX, sm.y * SEEY );
+        search.max = search.min + point( SEEX - 1, SEEY - 1 );
+        search_route_area( search, to_target, closed );
+        return search;
+    };
+    // Costs from the source to the entrances of its submap, and from the entrances of the
+    // target's submap to the target.
+    const route_flow_field from_f = submap_search( f, f_sm, false );
+    const route_flow_field to_t = submap_search( t, t_sm, true );
+
+    // A* over the entrances, indexed by their position.
+    std::vector<int> gscore( MAPSIZE_X * MAPSIZE_Y, INT_MAX );
+    std::vector<int> parent( MAPSIZE_X * MAPSIZE_Y, -1 );
+    std::priority_queue<std::pair<int, point>, std::vector<std::pair<int, point>>, pair_greater_cmp_first>
+    open;
+    const auto estimate = [&t]( const point & p ) {
+        return 2 * rl_dist( p, t.xy() );
+    };
+    for( const route_hierarchy::node &n : graph.submaps[f_sm.x * MAPSIZE + f_sm.y].nodes ) {
+        const int cost = from_f.cost[from_f.index( n.pos )];
+        if( cost != INT_MAX && !is_closed( n.pos ) ) {
+            gscore[flat_index( n.pos )] = cost;
+            open.push( std::make_pair( cost + estimate( n.pos ), n.pos ) );
+        }
+    }
+    int best = INT_MAX;
+    point best_node;
+    while( !open.empty() ) {
+        const std::pair<int, point> top = open.top();
+        open.pop();
+        if( top.first >= best ) {
+            break;
+        }
+        const point &cur = top.second;
+        const int g = gscore[flat_index( cur )];
+        if( top.first > g + estimate( cur ) ) {
+            continue;
+        }
+        const point cur_sm = submap_of( cur );
+        if( cur_sm == t_sm ) {
+            const int cost = to_t.cost[to_t.index( cur )];
+            if( cost != INT_MAX && g + cost < best ) {
+                best = g + cost;
+                best_node = cur;
+            }
+        }
+        const route_hierarchy::node *n = graph.find_node( cur_sm, cur );
+        if( n == nullptr ) {
+            continue;
+        }
+        for( const route_hierarchy::edge &e : n->edges ) {
+            if( is_closed( e.to ) ) {
+                continue;
+            }
+            const int next_index = flat_index( e.to );
+            if( g + e.cost < gscore[next_index] ) {
+                gscore[next_index] = g + e.cost;
+                parent[next_index] = flat_index( cur );
+                open.push( std::make_pair( g + e.cost + estimate( e.to ), e.to ) );
+            }
+        }
+    }
+    if( best > settings.max_length ) {
+        return std::vector<tripoint>();
+    }
+
+    // Refine the entrances into tiles, one submap at a time.
+    std::vector<point> nodes;
+    for( int index = flat_index( best_node ); index >= 0; index = parent[index] ) {
+        nodes.emplace_back( index / MAPSIZE_Y, index % MAPSIZE_Y );
+    }
+    std::reverse( nodes.begin(), nodes.end() );
+    std::vector<tripoint> ret = route_to_searched_tile( from_f, nodes.front() );
+    for( size_t i = 1; i < nodes.size(); ++i ) {
+        const point sm = submap_of( nodes[i] );
+        if( sm != submap_of( nodes[i - 1] ) ) {
+            // Crossing the border between two submaps.
+            ret.emplace_back( nodes[i], f.z );
+            continue;
+        }
+        const route_flow_field search = submap_search( tripoint( nodes[i - 1], f.z ), sm, false );
+        if( search.cost[search.index( nodes[i] )] > settings.max_length ) {
+            // The closed tiles cut the submap in two.
+            return std::vector<tripoint>();
+        }
+        const std::vector<tripoint> part = route_to_searched_tile( search, nodes[i] );
+        ret.insert( ret.end(), part.begin(), part.end() );
+    }
+    const std::vector<tripoint> last = route_from_flow_field( to_t, tripoint( nodes.back(), f.z ) );
+    ret.insert( ret.end(), last.begin(), last.end() );
+    return ret;
+}
+
 std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
                                   const pathfinding_settings &settings,
                                   const std::set<tripoint> &pre_closed ) const
@@ -217,13 +807,43 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
         return ret;
     }
 
+    route_cache &cache = get_route_cache();
+    if( const std::vector<tripoint> *known = cache.find( f, t, settings, pre_closed ) ) {
+        return *known;
+    }
+
+    bool found = false;
+    if( pre_closed.empty() && f.z == t.z ) {
+        route_flow_field &field = cache.flow_field( t, settings );
+        if( !field.built && field.requests >= route_cache::flow_field_threshold ) {
+            build_flow_field( field );
+        }
+        if( field.built && field.covers( f.xy() ) ) {
+            ret = route_from_flow_field( field, f );
+            // Without stairs the flow field saw everything A* would, so there is no path.
+            found = !ret.empty() || !has_zlevels() || !settings.allow_climb_stairs;
+        }
+    }
+    if( !found && settings.allow_approximate && f.z == t.z &&
+        rl_dist( f, t ) >= route_hierarchy::min_distance ) {
+        ret = route_hierarchical( f, t, settings, pre_closed );
+        found = !ret.empty();
+    }
+    if( !found ) {
+        ret = route_astar( f, t, settings, pre_closed );
+    }
+
+    cache.remember( f, t, settings, pre_closed, ret );
+    return ret;
+}
+
+std::vector<tripoint> map::route_astar( const tripoint &f, const tripoint &t,
+                                        const pathfinding_settings &settings,
+                                        const std::set<tripoint> &pre_closed ) const
+{
+    std::vector<tripoint> ret;
     int max_length = settings.max_length;
-    int bash = settings.bash_strength;
-    int climb_cost = settings.climb_cost;
-    bool doors = settings.allow_open_doors;
-    bool trapavoid = settings.avoid_traps;
-    bool roughavoid = settings.avoid_rough_terrain;
-    bool sharpavoid = settings.avoid_sharp;
+    static const auto non_normal = PF_SLOW | PF_WALL | PF_VEHICLE | PF_TRAP | PF_SHARP;
 
     const int pad = 16;  // Should be much bigger - low value makes pathfinders dumb!
     int minx = std::min( f.x, t.x ) - pad;
@@ -278,11 +898,6 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
         const auto &pf_cache = get_pathfinding_cache_ref( cur.z );
         const auto cur_special = pf_cache.special[cur.x][cur.y];
 
-        // 7 3 5
-        // 1 . 2
-        // 6 4 8
-        constexpr std::array<int, 8> x_offset{{ -1,  1,  0,  0,  1, -1, -1, 1 }};
-        constexpr std::array<int, 8> y_offset{{  0,  0, -1,  1, -1,  1, -1, 1 }};
         for( size_t i = 0; i < 8; i++ ) {
             const tripoint p( cur.x + x_offset[i], cur.y + y_offset[i], cur.z );
             const int index = flat_index( p.xy() );
@@ -300,127 +915,33 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
             int newg = layer.gscore[parent_index] + ( ( cur.x != p.x && cur.y != p.y ) ? 1 : 0 );
 
             const auto p_special = pf_cache.special[p.x][p.y];
-            // TODO: De-uglify, de-huge-n
             if( !( p_special & non_normal ) ) {
                 // Boring flat dirt - the most common case above the ground
                 newg += 2;
             } else {
-                if( roughavoid ) {
-                    layer.state[index] = ASL_CLOSED; // Close all rough terrain tiles
+                const int step_cost = route_step_cost( cur, p, p_special, settings );
+                if( step_cost == pf_step_closed ) {
+                    // Close it so that next time we won't try to calculate costs
+                    layer.state[index] = ASL_CLOSED;
                     continue;
-                }
-
-                int part = -1;
-                const maptile &tile = maptile_at_internal( p );
-                const auto &terrain = tile.get_ter_t();
-                const auto &furniture = tile.get_furn_t();
-                const vehicle *veh = veh_at_internal( p, part );
-
-                const int cost = move_cost_internal( furniture, terrain, veh, part );
-                // Don't calculate bash rating unless we intend to actually use it
-                const int rating = ( bash == 0 || cost != 0 ) ? -1 :
-                                   bash_rating_internal( bash, furniture, terrain, false, veh, part );
-
-                if( cost == 0 && rating <= 0 && ( !doors || !terrain.open || !furniture.open ) && veh == nullptr &&
-                    climb_cost <= 0 ) {
-                    layer.state[index] = ASL_CLOSED; // Close it so that next time we won't try to calculate costs
+                } else if( step_cost == pf_step_blocked ) {
                     continue;
-                }
-
-                newg += cost;
-                if( cost == 0 ) {
-                    if( climb_cost > 0 && p_special & PF_CLIMBABLE ) {
-                        // Climbing fences
-                        newg += climb_cost;
-                    } else if( doors && ( terrain.open || furniture.open ) &&
-                               ( !terrain.has_flag( "OPENCLOSE_INSIDE" ) || !furniture.has_flag( "OPENCLOSE_INSIDE" ) ||
-                                 !is_outside( cur ) ) ) {
-                        // Only try to open INSIDE doors from the inside
-                        // To open and then move onto the tile
-                        newg += 4;
-                    } else if( veh != nullptr ) {
-                        const auto vpobst = vpart_position( const_cast<vehicle &>( *veh ), part ).obstacle_at_part();
-                        part = vpobst ? vpobst->part_index() : -1;
-                        int dummy = -1;
-                        if( doors && veh->part_flag( part, VPFLAG_OPENABLE ) &&
-                            ( !veh->part_flag( part, "OPENCLOSE_INSIDE" ) ||
-                              veh_at_internal( cur, dummy ) == veh ) ) {
-                            // Handle car doors, but don't try to path through curtains
-                            newg += 10; // One turn to open, 4 to move there
-                        } else if( part >= 0 && bash > 0 ) {
-                            // Car obstacle that isn't a door
-                            // TODO: Account for armor
-                            int hp = veh->cpart( part ).hp();
-                            if( hp / 20 > bash ) {
-                                // Threshold damage thing means we just can't bash this down
-                                layer.state[index] = ASL_CLOSED;
-                                continue;
-                            } else if( hp / 10 > bash ) {
-                                // Threshold damage thing means we will fail to deal damage pretty often
-                                hp *= 2;
-                            }
-
-                            newg += 2 * hp / bash + 8 + 4;
-                        } else if( part >= 0 ) {
-                            if( !doors || !veh->part_flag( part, VPFLAG_OPENABLE ) ) {
-                                // Won't be openable, don't try from other sides
-                                layer.state[index] = ASL_CLOSED;
-                            }
-
-                            continue;
-                        }
-                    } else if( rating > 1 ) {
-                        // Expected number of turns to bash it down, 1 turn to move there
-                        // and 5 turns of penalty not to trash everything just because we can
-                        newg += ( 20 / rating ) + 2 + 10;
-                    } else if( rating == 1 ) {
-                        // Desperate measures, avoid whenever possible
-                        newg += 500;
-                    } else {
-                        // Unbashable and unopenable from here
-                        if( !doors || !terrain.open || !furniture.open ) {
-                            // Or anywhere else for that matter
-                            layer.state[index] = ASL_CLOSED;
-                        }
-
-                        continue;
+                } else if( step_cost == pf_step_ledge ) {
+                    tripoint below( p.xy(), p.z - 1 );
+                    if( !has_flag( TFLAG_NO_FLOOR, below ) ) {
+                        // Otherwise this would have been a huge fall
+                        auto &layer = pf.get_layer( p.z - 1 );
+                        // From cur, not p, because we won't be walking on air
+                        pf.add_point( layer.gscore[parent_index] + 10,
+                                      layer.score[parent_index] + 10 + 2 * rl_dist( below, t ),
+                                      cur, below );
                     }
-                }
-
-                if( trapavoid && p_special & PF_TRAP ) {
-                    const auto &ter_trp = terrain.trap.obj();
-                    const auto &trp = ter_trp.is_benign() ? tile.get_trap_t() : ter_trp;
-                    if( !trp.is_benign() ) {
-                        // For now make them detect all traps
-                        if( has_zlevels() && terrain.has_flag( TFLAG_NO_FLOOR ) ) {
-                            // Special case - ledge in z-levels
-                            // Warning: really expensive, needs a cache
-                            if( valid_move( p, tripoint( p.xy(), p.z - 1 ), false, true ) ) {
-                                tripoint below( p.xy(), p.z - 1 );
-                                if( !has_flag( TFLAG_NO_FLOOR, below ) ) {
-                                    // Otherwise this would have been a huge fall
-                                    auto &layer = pf.get_layer( p.z - 1 );
-                                    // From cur, not p, because we won't be walking on air
-                                    pf.add_point( layer.gscore[parent_index] + 10,
-                                                  layer.score[parent_index] + 10 + 2 * rl_dist( below, t ),
-                                                  cur, below );
-                                }
-
-                                // Close p, because we won't be walking on it
-                                layer.state[index] = ASL_CLOSED;
-                                continue;
-                            }
-                        } else if( trapavoid ) {
-                            // Otherwise it's walkable
-                            newg += 500;
-                        }
-                    }
-                }
 
-                if( sharpavoid && p_special & PF_SHARP ) {
-                    layer.state[index] = ASL_CLOSED; // Avoid sharp things
+                    // Close p, because we won't be walking on it
+                    layer.state[index] = ASL_CLOSED;
+                    continue;
                 }
-
+                newg += step_cost;
             }
 
             // If not visited, add as open
@@ -2,7 +2,15 @@
 #ifndef CATA_SRC_PATHFINDING_H
 #define CATA_SRC_PATHFINDING_H
 
+#include <array>
+#include <cstddef>
+#include <deque>
+#include <set>
+#include <vector>
+
+#include "calendar.h"
 #include "game_constants.h"
+#include "point.h"
 
 enum pf_special : int {
     PF_NORMAL = 0x00,    // Plain boring tile (grass, dirt, floor etc.)
@@ -43,6 +51,8 @@ struct pathfinding_cache {
     ~pathfinding_cache();
 
     bool dirty = false;
+    // Incremented whenever the cache is marked dirty, routes found before are stale.
+    int generation = 0;
 
     pf_special special[MAPSIZE_X][MAPSIZE_Y];
 };
@@ -62,6 +72,9 @@ struct pathfinding_settings {
     bool allow_climb_stairs = true;
     bool avoid_rough_terrain = false;
     bool avoid_sharp = false;
+    // Long routes may be found on the coarse hierarchy, then they can be somewhat longer than
+    // the shortest one.
+    bool allow_approximate = false;
 
     pathfinding_settings() = default;
     pathfinding_settings( const pathfinding_settings & ) = default;
@@ -70,6 +83,138 @@ struct pathfinding_settings {
         : bash_strength( bs ), max_dist( md ), max_length( ml ), climb_cost( cc ),
           allow_open_doors( aod ), avoid_traps( at ), allow_climb_stairs( acs ), avoid_rough_terrain( art ),
           avoid_sharp( as ) {}
+
+    bool operator==( const pathfinding_settings &rhs ) const {
+        return bash_strength == rhs.bash_strength && max_dist == rhs.max_dist &&
+               max_length == rhs.max_length && climb_cost == rhs.climb_cost &&
+               allow_open_doors == rhs.allow_open_doors && avoid_traps == rhs.avoid_traps &&
+               allow_climb_stairs == rhs.allow_climb_stairs &&
+               avoid_rough_terrain == rhs.avoid_rough_terrain && avoid_sharp == rhs.avoid_sharp &&
+               allow_approximate == rhs.allow_approximate;
+    }
+};
+
+/**
+ * Distances to one target for every tile around it, found by a single Dijkstra search
+ * outwards from the target.  Any number of creatures can follow it to the target
+ * instead of searching a path each.
+ *
+ * The same search is also run away from a tile, then the costs are those of reaching
+ * each tile from it.  Either way next_step leads back towards the target.
+ */
+struct route_flow_field {
+    tripoint target;
+    pathfinding_settings settings;
+    // Number of routes to the target requested since the cache was last cleared.
+    int requests = 0;
+    bool built = false;
+    // Covered area, inclusive.
+    point min;
+    point max;
+    // Per tile of the area: cost to reach the target, and the direction of the next step
+    // as an index into the neighbour offsets, or -1.
+    std::vector<int> cost;
+    std::vector<signed char> next_step;
+
+    bool covers( const point &p ) const {
+        return p.x >= min.x && p.x <= max.x && p.y >= min.y && p.y <= max.y;
+    }
+    int index( const point &p ) const {
+        return ( p.x - min.x ) * ( max.y - min.y + 1 ) + ( p.y - min.y );
+    }
+};
+
+/**
+ * Abstract graph of one z-level for hierarchical (HPA*) searches of long routes.
+ *
+ * Neighbouring submaps are linked by entrances, a pair of nodes on either side of each
+ * stretch of their border that can be crossed.  The nodes of one submap are linked by
+ * the costs of the best paths between them that stay inside the submap.  A route across
+ * the map is found by searching these nodes and is then refined one submap at a time.
+ * Only submaps whose tiles changed get their part of the graph rebuilt.
+ */
+struct route_hierarchy {
+    /** Routes shorter than this are searched for directly. */
+    static constexpr int min_distance = 2 * SEEX;
+
+    struct edge {
+        point to;
+        int cost;
+    };
+    struct node {
+        point pos;
+        std::vector<edge> edges;
+    };
+    struct submap_graph {
+        bool built = false;
+        // Hash of the tiles the nodes were built from.
+        size_t signature = 0;
+        std::vector<node> nodes;
+    };
+
+    pathfinding_settings settings;
+    int zlev = 0;
+    // Generation of the pathfinding cache the graph is up to date with.
+    int generation = -1;
+    std::array<submap_graph, MAPSIZE *MAPSIZE> submaps;
+
+    const node *find_node( const point &sm, const point &p ) const;
+};
+
+/** Graphs for the different pathfinding settings and z-levels in use. */
+class route_hierarchies
+{
+    public:
+        /** Oldest graphs are dropped beyond this many. */
+        static constexpr size_t max_hierarchies = 16;
+
+        route_hierarchy &get( const pathfinding_settings &settings, int zlev );
+
+    private:
+        std::deque<route_hierarchy> hierarchies;
+};
+
+/**
+ * Routes found by map::route during the current turn.  Every zombie of a horde asks for a
+ * route to the same target, so identical requests are answered from memory, and targets
+ * requested often get a flow field.  Everything is dropped when the turn changes, the map
+ * is shifted or any pathfinding cache is marked dirty.
+ */
+class route_cache
+{
+    public:
+        /** Requests of one target before a flow field is built for it. */
+        static constexpr int flow_field_threshold = 3;
+        /** Limit of remembered individual routes. */
+        static constexpr size_t max_routes = 128;
+
+        /** Drops everything unless it was computed for the same turn, map and caches. */
+        void validate( const time_point &turn, const tripoint &abs_sub,
+                       const std::array<int, OVERMAP_LAYERS> &generations );
+
+        const std::vector<tripoint> *find( const tripoint &f, const tripoint &t,
+                                           const pathfinding_settings &settings,
+                                           const std::set<tripoint> &pre_closed ) const;
+        void remember( const tripoint &f, const tripoint &t, const pathfinding_settings &settings,
+                       const std::set<tripoint> &pre_closed, const std::vector<tripoint> &route );
+
+        /** Counts a request for the target and returns its flow field, which may not be built yet. */
+        route_flow_field &flow_field( const tripoint &t, const pathfinding_settings &settings );
+
+    private:
+        struct route_entry {
+            tripoint from;
+            tripoint to;
+            pathfinding_settings settings;
+            std::set<tripoint> pre_closed;
+            std::vector<tripoint> route;
+        };
+
+        time_point turn = calendar::before_time_starts;
+        tripoint abs_sub;
+        std::array<int, OVERMAP_LAYERS> generations = {};
+        std::vector<route_entry> routes;
+        std::vector<route_flow_field> flow_fields;
 };
 
 #endif // CATA_SRC_PATHFINDING_H
@@ -0,0 +1,91 @@
+#include "pool_allocator.h"
+
+#include <new>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace cata
+{
+namespace memory_pool
+{
+
+// Blocks kept beyond this are given back to the heap right away.
+static constexpr size_t max_pooled_bytes = 64 * 1024 * 1024;
+
+namespace
+{
+struct pool {
+    // Free blocks by their exact size, colonies ask for the same few sizes over and over.
+    std::unordered_map<size_t, std::vector<void *>> free_blocks;
+    statistics stats;
+};
+} // namespace
+
+static pool &get_pool()
+{
+    // Never destroyed, containers with static storage may give their blocks back after
+    // everything else is gone.
+    static pool *const instance = new pool();
+    return *instance;
+}
+
+void *allocate( const size_t bytes )
+{
+    pool &p = get_pool();
+    ++p.stats.allocations;
+    p.stats.bytes_in_use += bytes;
+    const auto it = p.free_blocks.find( bytes );
+    if( it != p.free_blocks.end() && !it->second.empty() ) {
+        void *const block = it->second.back();
+        it->second.pop_back();
+        ++p.stats.reused;
+        p.stats.bytes_pooled -= bytes;
+        return block;
+    }
+    return ::operator new( bytes );
+}
+
+void deallocate( void *const block, const size_t bytes )
+{
+    if( block == nullptr ) {
+        return;
+    }
+    pool &p = get_pool();
+    ++p.stats.deallocations;
+    p.stats.bytes_in_use -= bytes;
+    if( p.stats.bytes_pooled + bytes > max_pooled_bytes ) {
+        ::operator delete( block );
+        return;
+    }
+    p.free_blocks[bytes].push_back( block );
+    p.stats.bytes_pooled += bytes;
+}
+
+void release()
+{
+    pool &p = get_pool();
+    for( std::pair<const size_t, std::vector<void *>> &blocks : p.free_blocks ) {
+        for( void *block : blocks.second ) {
+            ::operator delete( block );
+        }
+    }
+    p.free_blocks.clear();
+    p.stats.bytes_pooled = 0;
+}
+
+const statistics &stats()
+{
+    return get_pool().stats;
+}
+
+void reset_counters()
+{
+    statistics &s = get_pool().stats;
+    s.allocations = 0;
+    s.reused = 0;
+    s.deallocations = 0;
+}
+
+} // namespace memory_pool
+} // namespace cata
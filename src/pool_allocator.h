@@ -0,0 +1,77 @@
+#pragma once
+#ifndef CATA_SRC_POOL_ALLOCATOR_H
+#define CATA_SRC_POOL_ALLOCATOR_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace cata
+{
+
+/**
+ * Memory for containers that come and go in large numbers, like the item colonies of the
+ * submaps loaded and unloaded as the player moves around. Freed blocks are kept by size and
+ * handed out again for the next request of that size instead of going back to the heap.
+ *
+ * Like the game state it serves, the pool is only used from the main thread.
+ */
+namespace memory_pool
+{
+
+struct statistics {
+    // Blocks handed out.
+    uint64_t allocations = 0;
+    // Blocks handed out that were taken from the pool instead of the heap.
+    uint64_t reused = 0;
+    // Blocks given back.
+    uint64_t deallocations = 0;
+    size_t bytes_in_use = 0;
+    size_t bytes_pooled = 0;
+};
+
+void *allocate( size_t bytes );
+void deallocate( void *p, size_t bytes );
+
+/** Gives the pooled blocks back to the heap, those in use are not affected. */
+void release();
+
+const statistics &stats();
+/** Resets the counters, but not the byte counts. */
+void reset_counters();
+
+} // namespace memory_pool
+
+/** Standard allocator taking its memory from @ref memory_pool. */
+template<typename T>
+class pool_allocator
+{
+    public:
+        using value_type = T;
+
+        pool_allocator() = default;
+        template<typename U>
+        // NOLINTNEXTLINE(google-explicit-constructor)
+        pool_allocator( const pool_allocator<U> & ) {}
+
+        T *allocate( size_t n ) {
+            static_assert( alignof( T ) <= alignof( std::max_align_t ),
+                           "pooled blocks only have the default alignment" );
+            return static_cast<T *>( memory_pool::allocate( n * sizeof( T ) ) );
+        }
+        void deallocate( T *p, size_t n ) {
+            memory_pool::deallocate( p, n * sizeof( T ) );
+        }
+
+        template<typename U>
+        bool operator==( const pool_allocator<U> & ) const {
+            return true;
+        }
+        template<typename U>
+        bool operator!=( const pool_allocator<U> & ) const {
+            return false;
+        }
+};
+
+} // namespace cata
+
+#endif // CATA_SRC_POOL_ALLOCATOR_H
@@ -2338,9 +2338,12 @@ void item::io( Archive &archive )
     archive.io( "bday", bday, calendar::start_of_cataclysm );
     archive.io( "mission_id", mission_id, -1 );
     archive.io( "player_id", player_id, -1 );
-    archive.io( "item_vars", item_vars, io::empty_default_tag() );
+    // Saving only reads the rarely set state, loading gets its own copy to fill.
+    extra_data &extra_state = Archive::is_input::value ? mutable_extra() :
+                              const_cast<extra_data &>( extra() );
+    archive.io( "item_vars", extra_state.item_vars, io::empty_default_tag() );
     // TODO: change default to empty string
-    archive.io( "name", corpse_name, std::string() );
+    archive.io( "name", extra_state.corpse_name, std::string() );
     archive.io( "owner", owner, owner.NULL_ID() );
     archive.io( "old_owner", old_owner, old_owner.NULL_ID() );
     archive.io( "invlet", invlet, '\0' );
@@ -2351,7 +2354,7 @@ void item::io( Archive &archive )
     archive.io( "rot", rot, 0_turns );
     archive.io( "last_temp_check", last_temp_check, calendar::start_of_cataclysm );
     archive.io( "current_phase", cur_phase, static_cast<int>( type->phase ) );
-    archive.io( "techniques", techniques, io::empty_default_tag() );
+    archive.io( "techniques", extra_state.techniques, io::empty_default_tag() );
     archive.io( "faults", faults, io::empty_default_tag() );
     archive.io( "item_tags", item_tags, io::empty_default_tag() );
     archive.io( "components", components, io::empty_default_tag() );
@@ -2440,6 +2443,7 @@ void item::io( Archive &archive )
 
     // Books without any chapters don't need to store a remaining-chapters
     // counter, it will always be 0 and it prevents proper stacking.
+    std::map<std::string, std::string> &item_vars = mutable_extra().item_vars;
     if( get_chapters() == 0 ) {
         for( auto it = item_vars.begin(); it != item_vars.end(); ) {
             if( it->first.compare( 0, 19, "remaining-chapters-" ) == 0 ) {
@@ -2453,6 +2457,9 @@ void item::io( Archive &archive )
     // Remove stored translated gerund in favor of storing the inscription tool type
     item_vars.erase( "item_label_type" );
     item_vars.erase( "item_note_type" );
+    if( extra().empty() ) {
+        extra_.reset();
+    }
 
     current_phase = static_cast<phase_id>( cur_phase );
     // override phase if frozen, needed for legacy save
@@ -4112,7 +4119,7 @@ void submap::load( JsonIn &jsin, const std::string &member_name, int version )
                     tmp.legacy_fast_forward_time();
                 }
 
-                const cata::colony<item>::iterator it = itm[p.x][p.y].insert( tmp );
+                const item_colony::iterator it = itm[p.x][p.y].insert( tmp );
                 if( tmp.needs_processing() ) {
                     active_items.add( *it, p );
                 }
@@ -4163,6 +4170,7 @@ void submap::load( JsonIn &jsin, const std::string &member_name, int version )
                     field_count++;
                 }
                 fld[i][j].add_field( ft, intensity, time_duration::from_turns( age ) );
+                mark_field_tile( { i, j } );
             }
         }
     } else if( member_name == "graffiti" ) {
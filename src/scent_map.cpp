@@ -3,6 +3,8 @@
 #include <algorithm>
 #include <cassert>
 #include <cstdlib>
+#include <memory>
+#include <utility>
 
 #include "assign.h"
 #include "calendar.h"
@@ -16,6 +18,9 @@
 #include "string_id.h"
 
 static constexpr int SCENT_RADIUS = 40;
+// decrease this to reduce gas spread. Keep it under 125 for
+// stability. This is essentially a decimal number * 1000.
+static constexpr int SCENT_DIFFUSIVITY = 100;
 
 static nc_color sev( const size_t level )
 {
@@ -80,14 +85,41 @@ void scent_map::draw( const catacurses::window &win, const int div, const tripoi
 
 void scent_map::shift( const point &sm_shift )
 {
-    scent_array<int> new_scent;
-    for( size_t x = 0; x < MAPSIZE_X; ++x ) {
-        for( size_t y = 0; y < MAPSIZE_Y; ++y ) {
-            const point p = point( x, y ) + sm_shift;
-            new_scent[x][y] = inbounds( p ) ? grscent[ p.x ][ p.y ] : 0;
+    if( sm_shift == point_zero ) {
+        return;
+    }
+    // Moved in place, the order of the columns makes sure none is overwritten before it was moved.
+    const auto shift_column = [&sm_shift]( std::array<int, MAPSIZE_Y> &dest,
+    const std::array<int, MAPSIZE_Y> &src ) {
+        const int dy = sm_shift.y;
+        if( std::abs( dy ) >= MAPSIZE_Y ) {
+            dest.fill( 0 );
+        } else if( dy >= 0 ) {
+            std::copy( src.begin() + dy, src.end(), dest.begin() );
+            std::fill( dest.end() - dy, dest.end(), 0 );
+        } else {
+            std::copy_backward( src.begin(), src.end() + dy, dest.end() );
+            std::fill( dest.begin(), dest.begin() - dy, 0 );
+        }
+    };
+    const int dx = sm_shift.x;
+    if( dx >= 0 ) {
+        for( int x = 0; x < MAPSIZE_X; ++x ) {
+            if( x + dx < MAPSIZE_X ) {
+                shift_column( grscent[x], grscent[x + dx] );
+            } else {
+                grscent[x].fill( 0 );
+            }
+        }
+    } else {
+        for( int x = MAPSIZE_X - 1; x >= 0; --x ) {
+            if( x + dx >= 0 ) {
+                shift_column( grscent[x], grscent[x + dx] );
+            } else {
+                grscent[x].fill( 0 );
+            }
         }
     }
-    grscent = new_scent;
 }
 
 int scent_map::get( const tripoint &p ) const
@@ -152,6 +184,75 @@ bool scent_map::inbounds( const point &p ) const
     return scent_map_boundaries.contains( p );
 }
 
+scent_map::diffusion_cache &scent_map::get_diffusion_cache( map &m )
+{
+    if( !diffusion ) {
+        diffusion = std::make_unique<diffusion_cache>();
+    }
+    diffusion_cache &cache = *diffusion;
+    const point map_max( MAPSIZE_X - 1, MAPSIZE_Y - 1 );
+    const tripoint abs_sub = m.get_abs_sub();
+    const int generation = m.get_pathfinding_generation( abs_sub.z );
+    // Vehicles move without changing the generation, but finding their parts is cheap.
+    std::vector<point> vehicle_reducers = m.vehicle_scent_reducers( point_zero, map_max );
+    if( cache.m == &m && cache.abs_sub == abs_sub && cache.generation == generation &&
+        cache.vehicle_reducers == vehicle_reducers ) {
+        return cache;
+    }
+    cache.m = &m;
+    cache.abs_sub = abs_sub;
+    cache.generation = generation;
+    cache.vehicle_reducers = std::move( vehicle_reducers );
+
+    // these are for caching flag lookups
+    scent_array<bool> blocks_scent; // currently only TFLAG_NO_SCENT blocks scent
+    scent_array<bool> reduces_scent;
+    m.scent_blockers( blocks_scent, reduces_scent, point_zero, map_max );
+    for( const point &p : cache.vehicle_reducers ) {
+        reduces_scent[p.x][p.y] = true;
+    }
+
+    for( int x = 0; x < MAPSIZE_X; ++x ) {
+        for( int y = 0; y < MAPSIZE_Y; ++y ) {
+            if( blocks_scent[x][y] ) {
+                cache.weight[x][y] = 0;
+                cache.diffusivity[x][y] = 0;
+            } else if( reduces_scent[x][y] ) {
+                // only 20% of scent can diffuse on REDUCE_SCENT squares
+                cache.weight[x][y] = 2;
+                // less air movement for REDUCE_SCENT square
+                cache.diffusivity[x][y] = SCENT_DIFFUSIVITY / 5;
+            } else {
+                cache.weight[x][y] = 10;
+                cache.diffusivity[x][y] = SCENT_DIFFUSIVITY;
+            }
+        }
+    }
+    for( int x = 0; x < MAPSIZE_X; ++x ) {
+        for( int y = 0; y < MAPSIZE_Y; ++y ) {
+            if( x == 0 || y == 0 || x == MAPSIZE_X - 1 || y == MAPSIZE_Y - 1 ||
+                cache.weight[x][y] == 0 ) {
+                // Never updated, see scent_map::update, or blocking scent and keeping none.
+                cache.kept[x][y] = 0;
+                cache.absorbed[x][y] = 0;
+                continue;
+            }
+            // to how many neighboring squares do we diffuse out? (include our own square
+            // since we also include our own square when diffusing in)
+            int squares_used = 0;
+            for( int i = x - 1; i <= x + 1; ++i ) {
+                for( int j = y - 1; j <= y + 1; ++j ) {
+                    squares_used += cache.weight[i][j];
+                }
+            }
+            const int this_diffusivity = cache.diffusivity[x][y];
+            cache.kept[x][y] = 10 * 1000 - squares_used * this_diffusivity;
+            cache.absorbed[x][y] = this_diffusivity * ( 90 - squares_used );
+        }
+    }
+    return cache;
+}
+
 void scent_map::update( const tripoint &center, map &m )
 {
     // Stop updating scent after X turns of the player not moving.
@@ -163,91 +264,44 @@ void scent_map::update( const tripoint &center, map &m )
         return;
     }
 
-    // note: the next four intermediate matrices need to be at least
-    // [2*SCENT_RADIUS+3][2*SCENT_RADIUS+1] in size to hold enough data
-    // The code I'm modifying used [MAPSIZE_X]. I'm staying with that to avoid new bugs.
-
-    // These two matrices are transposed so that x addresses are contiguous in memory
-    scent_array<int> sum_3_scent_y;
-    scent_array<int> squares_used_y;
+    // for loop constants, the diffusion needs one more square on each side
+    const int scentmap_minx = std::max( 1, center.x - SCENT_RADIUS );
+    const int scentmap_maxx = std::min( MAPSIZE_X - 2, center.x + SCENT_RADIUS );
+    const int scentmap_miny = std::max( 1, center.y - SCENT_RADIUS );
+    const int scentmap_maxy = std::min( MAPSIZE_Y - 2, center.y + SCENT_RADIUS );
+    if( scentmap_minx > scentmap_maxx || scentmap_miny > scentmap_maxy ) {
+        return;
+    }
 
-    // these are for caching flag lookups
-    scent_array<bool> blocks_scent; // currently only TFLAG_NO_SCENT blocks scent
-    scent_array<bool> reduces_scent;
+    diffusion_cache &cache = get_diffusion_cache( m );
+    scent_array<int> &sum_3_scent_y = cache.sum_3_y;
 
-    // for loop constants
-    const int scentmap_minx = center.x - SCENT_RADIUS;
-    const int scentmap_maxx = center.x + SCENT_RADIUS;
-    const int scentmap_miny = center.y - SCENT_RADIUS;
-    const int scentmap_maxy = center.y + SCENT_RADIUS;
-
-    // decrease this to reduce gas spread. Keep it under 125 for
-    // stability. This is essentially a decimal number * 1000.
-    const int diffusivity = 100;
-
-    // The new scent flag searching function. Should be wayyy faster than the old one.
-    m.scent_blockers( blocks_scent, reduces_scent, point( scentmap_minx - 1, scentmap_miny - 1 ),
-                      point( scentmap_maxx + 1, scentmap_maxy + 1 ) );
-    // Sum neighbors in the y direction.  This way, each square gets called 3 times instead of 9
-    // times. This cost us an extra loop here, but it also eliminated a loop at the end, so there
-    // is a net performance improvement over the old code. Could probably still be better.
-    // note: this method needs an array that is one square larger on each side in the x direction
-    // than the final scent matrix. I think this is fine since SCENT_RADIUS is less than
-    // MAPSIZE_X, but if that changes, this may need tweaking.
+    // The diffusion is separable: first sum the weighted neighbors in y direction, then add
+    // up three of those sums in x direction.  Columns are contiguous in memory, so both
+    // inner loops work on plain arrays without branches and can be vectorized.
     for( int x = scentmap_minx - 1; x <= scentmap_maxx + 1; ++x ) {
+        const int *scent = grscent[x].data();
+        const int *weight = cache.weight[x].data();
+        int *sum = sum_3_scent_y[x].data();
         for( int y = scentmap_miny; y <= scentmap_maxy; ++y ) {
-            // remember the sum of the scent val for the 3 neighboring squares that can defuse into
-            sum_3_scent_y[y][x] = 0;
-            squares_used_y[y][x] = 0;
-            for( int i = y - 1; i <= y + 1; ++i ) {
-                if( !blocks_scent[x][i] ) {
-                    if( reduces_scent[x][i] ) {
-                        // only 20% of scent can diffuse on REDUCE_SCENT squares
-                        sum_3_scent_y[y][x] += 2 * grscent[x][i];
-                        squares_used_y[y][x] += 2;
-                    } else {
-                        sum_3_scent_y[y][x] += 10 * grscent[x][i];
-                        squares_used_y[y][x] += 10;
-                    }
-                }
-            }
+            sum[y] = weight[y - 1] * scent[y - 1] + weight[y] * scent[y] + weight[y + 1] * scent[y + 1];
         }
     }
 
-    // Rest of the scent map
+    // Rest of the scent map, tiles blocking scent have nothing kept and nothing diffusing in.
     for( int x = scentmap_minx; x <= scentmap_maxx; ++x ) {
+        int *scent = grscent[x].data();
+        const int *sum_left = sum_3_scent_y[x - 1].data();
+        const int *sum_here = sum_3_scent_y[x].data();
+        const int *sum_right = sum_3_scent_y[x + 1].data();
+        const int *diffusivity = cache.diffusivity[x].data();
+        const int *kept = cache.kept[x].data();
+        const int *absorbed = cache.absorbed[x].data();
         for( int y = scentmap_miny; y <= scentmap_maxy; ++y ) {
-            int &scent_here = grscent[x][y];
-            if( !blocks_scent[x][y] ) {
-                // to how many neighboring squares do we diffuse out? (include our own square
-                // since we also include our own square when diffusing in)
-                const int squares_used = squares_used_y[y][x - 1]
-                                         + squares_used_y[y][x]
-                                         + squares_used_y[y][x + 1];
-
-                int this_diffusivity;
-                if( !reduces_scent[x][y] ) {
-                    this_diffusivity = diffusivity;
-                } else {
-                    this_diffusivity = diffusivity / 5; //less air movement for REDUCE_SCENT square
-                }
-                // take the old scent and subtract what diffuses out
-                int temp_scent = scent_here * ( 10 * 1000 - squares_used * this_diffusivity );
-                // neighboring REDUCE_SCENT squares absorb some scent
-                temp_scent -= scent_here * this_diffusivity * ( 90 - squares_used ) / 5;
-                // we've already summed neighboring scent values in the y direction in the previous
-                // loop. Now we do it for the x direction, multiply by diffusion, and this is what
-                // diffuses into our current square.
-                scent_here =
-                    ( temp_scent
-                      + this_diffusivity * ( sum_3_scent_y[y][x - 1]
-                                             + sum_3_scent_y[y][x]
-                                             + sum_3_scent_y[y][x + 1] )
-                    ) / ( 1000 * 10 );
-            } else {
-                // this cell blocks scent via NO_SCENT (in json)
-                scent_here = 0;
-            }
+            // take the old scent and subtract what diffuses out, including what neighboring
+            // REDUCE_SCENT squares absorb, then add what diffuses in.
+            scent[y] = ( scent[y] * kept[y] - scent[y] * absorbed[y] / 5
+                         + diffusivity[y] * ( sum_left[y] + sum_here[y] + sum_right[y] ) ) / ( 1000 * 10 );
         }
     }
 }
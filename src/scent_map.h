@@ -3,6 +3,7 @@
 #define CATA_SRC_SCENT_MAP_H
 
 #include <array>
+#include <memory>
 #include <set>
 #include <string>
 #include <vector>
@@ -45,13 +46,40 @@ class scent_map
         template<typename T>
         using scent_array = std::array<std::array<T, MAPSIZE_Y>, MAPSIZE_X>;
 
+        /**
+         * What the diffusion needs to know about the tiles, worked out from the scent
+         * blockers of the map.  Rebuilt only when the terrain, furniture or the vehicles
+         * that reduce scent changed.
+         */
+        struct diffusion_cache {
+            const map *m = nullptr;
+            tripoint abs_sub;
+            int generation = -1;
+            std::vector<point> vehicle_reducers;
+
+            // How much scent of a tile counts for its neighbors: 10, 2 if it reduces scent, 0 if it blocks it.
+            scent_array<int> weight;
+            // 0 on tiles blocking scent, so they end up with no scent without a branch.
+            scent_array<int> diffusivity;
+            // Scent that stays on the tile, times 10000.
+            scent_array<int> kept;
+            // Scent absorbed by neighboring tiles that reduce scent, times 50000.
+            scent_array<int> absorbed;
+            // Scratch space for the weighted scent of each tile and its neighbors in y direction.
+            scent_array<int> sum_3_y;
+        };
+
         scent_array<int> grscent;
         scenttype_id typescent;
         cata::optional<tripoint> player_last_position;
         time_point player_last_moved = calendar::before_time_starts;
+        std::unique_ptr<diffusion_cache> diffusion;
 
         const game &gm;
 
+        // Brings @ref diffusion up to date with the map.
+        diffusion_cache &get_diffusion_cache( map &m );
+
     public:
         scent_map( const game &g ) : gm( g ) { }
 
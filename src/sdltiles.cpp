@@ -2870,6 +2870,10 @@ static void CheckMessages()
                 }
                 break;
             case SDL_RENDER_TARGETS_RESET:
+                // The kept frame is lost with the render targets.
+                if( tilecontext ) {
+                    tilecontext->invalidate_frame_cache();
+                }
                 need_redraw = true;
                 needupdate = true;
                 break;
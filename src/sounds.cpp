@@ -16,13 +16,16 @@
 #include "character.h"
 #include "coordinate_conversions.h"
 #include "creature.h"
+#include "creature_tracker.h"
 #include "debug.h"
 #include "effect.h"
 #include "enums.h"
+#include "flood_fill.h"
 #include "game.h"
 #include "game_constants.h"
 #include "item.h"
 #include "itype.h"
+#include "lightmap.h"
 #include "line.h"
 #include "map.h"
 #include "map_iterator.h"
@@ -166,6 +169,83 @@ static int sound_distance( const tripoint &source, const tripoint &sink )
     return rl_dist( source.xy(), sink.xy() ) + vertical_attenuation;
 }
 
+// Sounds at least this loud get a sound_field, quieter ones don't carry far enough for the
+// way around walls to matter much.
+static constexpr int min_field_volume = 20;
+// Going through a wall or closed door muffles a sound as much as this many tiles of open air.
+static constexpr int wall_attenuation = 10;
+
+namespace
+{
+/**
+ * How far a sound has to travel to each tile of its z-level, around or through what blocks
+ * sight, which is mostly walls and closed doors. Computed at most once per source each turn,
+ * then shared by every monster, NPC and the player hearing it.
+ */
+class sound_field
+{
+    public:
+        sound_field( const tripoint &source, const int range ) : source( source ), range( range ) {
+            const level_cache &cache = get_map().get_cache_ref( source.z );
+            ff::point_distance_fill_8_connected( source.xy(), range, { MAPSIZE_X, MAPSIZE_Y },
+            distances, [&cache]( const point & p ) {
+                return cache.transparency_cache[p.x][p.y] > LIGHT_TRANSPARENCY_SOLID ? 1 :
+                       1 + wall_attenuation;
+            } );
+        }
+
+        /** Distance the sound travels to @p sink, never less than sound_distance. */
+        int distance( const tripoint &sink ) const {
+            const int direct = sound_distance( source, sink );
+            if( sink.z != source.z || sink.x < 0 || sink.y < 0 || sink.x >= MAPSIZE_X ||
+                sink.y >= MAPSIZE_Y ) {
+                return direct;
+            }
+            // Anything not reached is out of range.
+            return std::max( direct, std::min( distances[sink.y * MAPSIZE_X + sink.x], range ) );
+        }
+
+        int get_range() const {
+            return range;
+        }
+
+    private:
+        tripoint source;
+        int range;
+        std::vector<int> distances;
+};
+} // namespace
+
+// The sound fields of this turn by source, valid while the map is not shifted.
+static std::unordered_map<tripoint, sound_field> sound_fields;
+static int sound_fields_turn = -1;
+static tripoint sound_fields_abs_sub;
+
+// Distance a sound of the given volume travels from source to sink.
+static int sound_distance( const tripoint &source, const tripoint &sink, const int volume,
+                           const int range )
+{
+    map &here = get_map();
+    if( volume < min_field_volume || source.z != sink.z || !here.inbounds( source ) ) {
+        return sound_distance( source, sink );
+    }
+    if( sound_fields_turn != to_turn<int>( calendar::turn ) ||
+        sound_fields_abs_sub != here.get_abs_sub() ) {
+        sound_fields.clear();
+        sound_fields_turn = to_turn<int>( calendar::turn );
+        sound_fields_abs_sub = here.get_abs_sub();
+    }
+    // Nothing can be further away than the corners of the map.
+    const int needed = std::min( range, MAPSIZE_X + MAPSIZE_Y );
+    auto iter = sound_fields.find( source );
+    if( iter == sound_fields.end() ) {
+        iter = sound_fields.emplace( source, sound_field( source, needed ) ).first;
+    } else if( iter->second.get_range() < needed ) {
+        iter->second = sound_field( source, needed );
+    }
+    return iter->second.distance( sink );
+}
+
 void sounds::ambient_sound( const tripoint &p, int vol, sound_t category,
                             const std::string &description )
 {
@@ -299,10 +379,28 @@ static int get_signal_for_hordes( const centroid &centr )
     return 0;
 }
 
+namespace
+{
+// The loudest sound a monster hears this turn.
+struct heard_sound {
+    monster *critter;
+    tripoint source;
+    int vol;
+    int dist;
+    // See monster::heard_volume.
+    int heard;
+};
+} // namespace
+
 void sounds::process_sounds()
 {
     std::vector<centroid> sound_clusters = cluster_sounds( recent_sounds );
     const int weather_vol = get_weather().weather_id->sound_attn;
+    // Every monster only goes looking for the loudest sound it hears, so a firefight or an
+    // alarm does not cost monsters times sounds wander targets.  Every sound still angers or
+    // scares it.  In the order the monsters are found.
+    std::vector<heard_sound> heard;
+    std::unordered_map<const monster *, size_t> heard_index;
     for( const auto &this_centroid : sound_clusters ) {
         // Since monsters don't go deaf ATM we can just use the weather modified volume
         // If they later get physical effects from loud noises we'll have to change this
@@ -321,15 +419,39 @@ void sounds::process_sounds()
             overmap_buffer.signal_hordes( target, sig_power );
         }
         // Alert all monsters (that can hear) to the sound.
-        for( monster &critter : g->all_monsters() ) {
-            // TODO: Generalize this to Creature::hear_sound
-            const int dist = sound_distance( source, critter.pos() );
-            if( vol * 2 > dist ) {
+        // Monsters further away horizontally than vol * 2 certainly won't hear it.
+        if( vol <= 0 ) {
+            continue;
+        }
+        for( monster *critter : g->critter_tracker->find_all_near( source, vol * 2 - 1,
+                OVERMAP_LAYERS ) ) {
+            if( !critter->can_hear() ) {
+                continue;
+            }
+            const int dist = sound_distance( source, critter->pos(), vol, vol * 2 );
+            if( vol * 2 <= dist ) {
                 // Exclude monsters that certainly won't hear the sound
-                critter.hear_sound( source, vol, dist );
+                continue;
+            }
+            const heard_sound sound{ critter, source, vol, dist, critter->heard_volume( vol, dist ) };
+            const auto found = heard_index.emplace( critter, heard.size() );
+            if( found.second ) {
+                heard.push_back( sound );
+                continue;
+            }
+            heard_sound &loudest = heard[found.first->second];
+            if( loudest.heard < sound.heard ) {
+                critter->hear_sound_trigger( loudest.vol, loudest.dist );
+                loudest = sound;
+            } else {
+                critter->hear_sound_trigger( sound.vol, sound.dist );
             }
         }
     }
+    for( const heard_sound &sound : heard ) {
+        // TODO: Generalize this to Creature::hear_sound
+        sound.critter->hear_sound( sound.source, sound.vol, sound.dist );
+    }
     recent_sounds.clear();
 }
 
@@ -389,8 +511,15 @@ void sounds::process_sound_markers( player *p )
     for( const auto &sound_event_pair : sounds_since_last_turn ) {
         const tripoint &pos = sound_event_pair.first;
         const sound_event &sound = sound_event_pair.second;
-        const int distance_to_sound = sound_distance( p->pos(), pos );
         const int raw_volume = sound.volume;
+        const int reach = static_cast<int>( std::max( raw_volume, raw_volume - weather_vol ) *
+                                            std::max( 1.0f, volume_multiplier ) );
+        int distance_to_sound = sound_distance( p->pos(), pos );
+        if( pos != p->pos() && distance_to_sound >= reach ) {
+            // Neither heard nor felt, most footsteps of a horde end here.
+            continue;
+        }
+        distance_to_sound = sound_distance( pos, p->pos(), raw_volume, reach );
 
         // The felt volume of a sound is not affected by negative multipliers, such as already
         // deafened players or players with sub-par hearing to begin with.
@@ -556,6 +685,7 @@ void sounds::process_sound_markers( player *p )
 void sounds::reset_sounds()
 {
     recent_sounds.clear();
+    sound_fields.clear();
     sounds_since_last_turn.clear();
     sound_markers.clear();
 }
@@ -53,6 +53,18 @@ submap::~submap() = default;
 
 submap &submap::operator=( submap && ) = default;
 
+void submap::rebuild_field_tiles()
+{
+    field_tiles.reset();
+    for( int x = 0; x < SEEX; x++ ) {
+        for( int y = 0; y < SEEY; y++ ) {
+            if( fld[x][y].field_count() > 0 ) {
+                mark_field_tile( { x, y } );
+            }
+        }
+    }
+}
+
 static const std::string COSMETICS_GRAFFITI( "GRAFFITI" );
 static const std::string COSMETICS_SIGNAGE( "SIGNAGE" );
 // Handle GCC warning: 'warning: returning reference to temporary'
@@ -271,6 +283,7 @@ void submap::rotate( int turns )
         }
     }
 
+    rebuild_field_tiles();
     active_items.rotate_locations( turns, { SEEX, SEEY } );
 
     for( auto &elem : cosmetics ) {
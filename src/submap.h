@@ -2,6 +2,7 @@
 #ifndef CATA_SRC_SUBMAP_H
 #define CATA_SRC_SUBMAP_H
 
+#include <bitset>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
@@ -18,6 +19,7 @@
 #include "field.h"
 #include "game_constants.h"
 #include "item.h"
+#include "item_stack.h"
 #include "mapgen.h"
 #include "point.h"
 #include "type_id.h"
@@ -52,7 +54,7 @@ struct maptile_soa {
     ter_id             ter[sx][sy];  // Terrain on each square
     furn_id            frn[sx][sy];  // Furniture on each square
     std::uint8_t       lum[sx][sy];  // Number of items emitting light on each square
-    cata::colony<item> itm[sx][sy];  // Items on each square
+    item_colony itm[sx][sy];  // Items on each square
     field              fld[sx][sy];  // Field on each square
     trap_id            trp[sx][sy];  // Trap on each square
     int                rad[sx][sy];  // Irradiation of each square
@@ -158,11 +160,11 @@ class submap : maptile_soa<SEEX, SEEY>
         }
 
         // TODO: Replace this as it essentially makes itm public
-        cata::colony<item> &get_items( const point &p ) {
+        item_colony &get_items( const point &p ) {
             return itm[p.x][p.y];
         }
 
-        const cata::colony<item> &get_items( const point &p ) const {
+        const item_colony &get_items( const point &p ) const {
             return itm[p.x][p.y];
         }
 
@@ -175,6 +177,21 @@ class submap : maptile_soa<SEEX, SEEY>
             return fld[p.x][p.y];
         }
 
+        /**
+         * Whether the tile may have fields, so field processing can skip the others.
+         * Every tile that gets a field is marked, but the mark is only cleared when the
+         * field processing finds the tile empty.
+         */
+        bool has_field_tile( const point &p ) const {
+            return field_tiles[p.x * SEEY + p.y];
+        }
+        void mark_field_tile( const point &p ) {
+            field_tiles.set( p.x * SEEY + p.y );
+        }
+        void unmark_field_tile( const point &p ) {
+            field_tiles.reset( p.x * SEEY + p.y );
+        }
+
         struct cosmetic_t {
             point pos;
             std::string type;
@@ -252,8 +269,11 @@ class submap : maptile_soa<SEEX, SEEY>
         std::map<point, computer> computers;
         std::unique_ptr<computer> legacy_computer;
         int temperature = 0;
+        // Index x * SEEY + y, the order in which fields are processed.
+        std::bitset<SEEX * SEEY> field_tiles;
 
         void update_legacy_computer();
+        void rebuild_field_tiles();
 
         static constexpr size_t elements = SEEX * SEEY;
 };
@@ -312,6 +332,7 @@ struct maptile {
             const bool ret = sm->get_field( pos() ).add_field( field_to_add, new_intensity, new_age );
             if( ret ) {
                 sm->field_count++;
+                sm->mark_field_tile( pos() );
             }
 
             return ret;
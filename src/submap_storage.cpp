@@ -0,0 +1,642 @@
+#include "submap_storage.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <ostream>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+
+#include "cata_utility.h"
+#include "filesystem.h"
+
+namespace
+{
+
+// Tags of the values of the binary encoding.
+enum encoding_tag : unsigned char {
+    tag_null = 0,
+    tag_false,
+    tag_true,
+    tag_int,
+    // Any number that isn't a plain integer, kept as its text.
+    tag_number,
+    tag_string,
+    tag_array,
+    tag_object,
+    // A number of repetitions of the next value, only inside arrays.
+    tag_repeat,
+};
+
+constexpr char region_magic[] = "CSMR";
+constexpr int region_version = 1;
+
+[[noreturn]] void malformed( const char *what )
+{
+    throw std::runtime_error( std::string( "malformed submap data: " ) + what );
+}
+
+void write_varint( std::string &out, uint64_t value )
+{
+    while( value >= 0x80 ) {
+        out.push_back( static_cast<char>( ( value & 0x7F ) | 0x80 ) );
+        value >>= 7;
+    }
+    out.push_back( static_cast<char>( value ) );
+}
+
+uint64_t read_varint( const std::string &in, size_t &pos )
+{
+    uint64_t value = 0;
+    for( int shift = 0; shift < 64; shift += 7 ) {
+        if( pos >= in.size() ) {
+            malformed( "truncated number" );
+        }
+        const unsigned char byte = in[pos++];
+        value |= static_cast<uint64_t>( byte & 0x7F ) << shift;
+        if( !( byte & 0x80 ) ) {
+            return value;
+        }
+    }
+    malformed( "overlong number" );
+}
+
+uint64_t zigzag( const int64_t value )
+{
+    return ( static_cast<uint64_t>( value ) << 1 ) ^ static_cast<uint64_t>( value >> 63 );
+}
+
+int64_t unzigzag( const uint64_t value )
+{
+    return static_cast<int64_t>( value >> 1 ) ^ -static_cast<int64_t>( value & 1 );
+}
+
+// Parses JSON text as written by JsonOut and writes its binary encoding.
+class json_encoder
+{
+    public:
+        explicit json_encoder( const std::string &json ) : json( json ) {}
+
+        std::string encode() {
+            std::string body;
+            encode_value( body );
+            skip_space();
+            if( pos != json.size() ) {
+                malformed( "trailing characters" );
+            }
+            std::string out;
+            write_varint( out, strings.size() );
+            for( const std::string *str : string_order ) {
+                write_varint( out, str->size() );
+                out += *str;
+            }
+            out += body;
+            return out;
+        }
+
+    private:
+        void skip_space() {
+            while( pos < json.size() && ( json[pos] == ' ' || json[pos] == '\n' ||
+                                          json[pos] == '\r' || json[pos] == '\t' ) ) {
+                ++pos;
+            }
+        }
+
+        char peek() {
+            skip_space();
+            if( pos >= json.size() ) {
+                malformed( "unexpected end of JSON" );
+            }
+            return json[pos];
+        }
+
+        void expect( const char c ) {
+            if( peek() != c ) {
+                malformed( "unexpected character in JSON" );
+            }
+            ++pos;
+        }
+
+        void expect_word( const char *word ) {
+            const size_t len = std::strlen( word );
+            if( json.compare( pos, len, word ) != 0 ) {
+                malformed( "unknown literal in JSON" );
+            }
+            pos += len;
+        }
+
+        void write_string_ref( std::string &out, const std::string &str ) {
+            auto iter = strings.find( str );
+            if( iter == strings.end() ) {
+                iter = strings.emplace( str, strings.size() ).first;
+                string_order.push_back( &iter->first );
+            }
+            write_varint( out, iter->second );
+        }
+
+        // Text between the quotes, escape sequences are kept as they are.
+        std::string read_string() {
+            expect( '"' );
+            const size_t start = pos;
+            while( pos < json.size() && json[pos] != '"' ) {
+                pos += json[pos] == '\\' ? 2 : 1;
+            }
+            if( pos >= json.size() ) {
+                malformed( "unterminated string" );
+            }
+            return json.substr( start, pos++ - start );
+        }
+
+        void encode_number( std::string &out ) {
+            const size_t start = pos;
+            while( pos < json.size() && std::strchr( "+-0123456789.eE", json[pos] ) != nullptr ) {
+                ++pos;
+            }
+            const std::string text = json.substr( start, pos - start );
+            const size_t digits = text[0] == '-' ? 1 : 0;
+            const bool plain = text.size() > digits && text.size() - digits <= 18 &&
+                               text.find_first_not_of( "0123456789", digits ) == std::string::npos &&
+                               ( text[digits] != '0' || text.size() == digits + 1 ) && text != "-0";
+            if( plain ) {
+                out.push_back( tag_int );
+                write_varint( out, zigzag( std::stoll( text ) ) );
+            } else if( !text.empty() ) {
+                out.push_back( tag_number );
+                write_string_ref( out, text );
+            } else {
+                malformed( "unexpected character in JSON" );
+            }
+        }
+
+        void encode_value( std::string &out ) {
+            switch( peek() ) {
+                case '{': {
+                    ++pos;
+                    std::string members;
+                    size_t count = 0;
+                    while( peek() != '}' ) {
+                        if( count > 0 ) {
+                            expect( ',' );
+                        }
+                        write_string_ref( members, read_string() );
+                        expect( ':' );
+                        encode_value( members );
+                        ++count;
+                    }
+                    ++pos;
+                    out.push_back( tag_object );
+                    write_varint( out, count );
+                    out += members;
+                    break;
+                }
+                case '[': {
+                    ++pos;
+                    std::vector<std::string> values;
+                    while( peek() != ']' ) {
+                        if( !values.empty() ) {
+                            expect( ',' );
+                        }
+                        values.emplace_back();
+                        encode_value( values.back() );
+                    }
+                    ++pos;
+                    encode_array( out, values );
+                    break;
+                }
+                case '"':
+                    out.push_back( tag_string );
+                    write_string_ref( out, read_string() );
+                    break;
+                case 't':
+                    expect_word( "true" );
+                    out.push_back( tag_true );
+                    break;
+                case 'f':
+                    expect_word( "false" );
+                    out.push_back( tag_false );
+                    break;
+                case 'n':
+                    expect_word( "null" );
+                    out.push_back( tag_null );
+                    break;
+                default:
+                    encode_number( out );
+                    break;
+            }
+        }
+
+        // Runs of equal values are stored once, the count of entries stays that of the
+        // encoded entries so the decoder knows where the array ends.
+        static void encode_array( std::string &out, const std::vector<std::string> &values ) {
+            std::string entries;
+            size_t count = 0;
+            for( size_t i = 0; i < values.size(); ) {
+                size_t run = 1;
+                while( i + run < values.size() && values[i + run] == values[i] ) {
+                    ++run;
+                }
+                if( run >= 3 ) {
+                    entries.push_back( tag_repeat );
+                    write_varint( entries, run );
+                    entries += values[i];
+                    ++count;
+                } else {
+                    for( size_t j = 0; j < run; ++j ) {
+                        entries += values[i];
+                        ++count;
+                    }
+                }
+                i += run;
+            }
+            out.push_back( tag_array );
+            write_varint( out, count );
+            out += entries;
+        }
+
+        const std::string &json;
+        size_t pos = 0;
+        std::unordered_map<std::string, uint64_t> strings;
+        std::vector<const std::string *> string_order;
+};
+
+class json_decoder
+{
+    public:
+        explicit json_decoder( const std::string &data ) : data( data ) {}
+
+        std::string decode() {
+            const uint64_t num_strings = read_varint( data, pos );
+            if( num_strings > data.size() ) {
+                malformed( "string table too large" );
+            }
+            strings.reserve( num_strings );
+            for( uint64_t i = 0; i < num_strings; ++i ) {
+                const uint64_t len = read_varint( data, pos );
+                if( len > data.size() - pos ) {
+                    malformed( "truncated string" );
+                }
+                strings.emplace_back( data, pos, len );
+                pos += len;
+            }
+            std::string out;
+            out.reserve( data.size() * 4 );
+            decode_value( out );
+            if( pos != data.size() ) {
+                malformed( "trailing bytes" );
+            }
+            return out;
+        }
+
+    private:
+        const std::string &string_ref() {
+            const uint64_t index = read_varint( data, pos );
+            if( index >= strings.size() ) {
+                malformed( "unknown string" );
+            }
+            return strings[index];
+        }
+
+        unsigned char read_tag() {
+            if( pos >= data.size() ) {
+                malformed( "truncated value" );
+            }
+            return data[pos++];
+        }
+
+        void decode_value( std::string &out ) {
+            switch( read_tag() ) {
+                case tag_null:
+                    out += "null";
+                    break;
+                case tag_false:
+                    out += "false";
+                    break;
+                case tag_true:
+                    out += "true";
+                    break;
+                case tag_int:
+                    out += std::to_string( unzigzag( read_varint( data, pos ) ) );
+                    break;
+                case tag_number:
+                    out += string_ref();
+                    break;
+                case tag_string:
+                    out.push_back( '"' );
+                    out += string_ref();
+                    out.push_back( '"' );
+                    break;
+                case tag_array: {
+                    const uint64_t count = read_varint( data, pos );
+                    out.push_back( '[' );
+                    bool first = true;
+                    for( uint64_t i = 0; i < count; ++i ) {
+                        uint64_t run = 1;
+                        if( pos < data.size() && static_cast<unsigned char>( data[pos] ) == tag_repeat ) {
+                            ++pos;
+                            run = read_varint( data, pos );
+                        }
+                        if( run == 0 || run > 1000000 ) {
+                            malformed( "bad repetition" );
+                        }
+                        if( !first ) {
+                            out.push_back( ',' );
+                        }
+                        first = false;
+                        const size_t start = out.size();
+                        decode_value( out );
+                        const std::string value = out.substr( start );
+                        for( uint64_t j = 1; j < run; ++j ) {
+                            out.push_back( ',' );
+                            out += value;
+                        }
+                    }
+                    out.push_back( ']' );
+                    break;
+                }
+                case tag_object: {
+                    const uint64_t count = read_varint( data, pos );
+                    out.push_back( '{' );
+                    for( uint64_t i = 0; i < count; ++i ) {
+                        if( i > 0 ) {
+                            out.push_back( ',' );
+                        }
+                        out.push_back( '"' );
+                        out += string_ref();
+                        out += "\":";
+                        decode_value( out );
+                    }
+                    out.push_back( '}' );
+                    break;
+                }
+                default:
+                    malformed( "unknown tag" );
+            }
+        }
+
+        const std::string &data;
+        size_t pos = 0;
+        std::vector<std::string> strings;
+};
+
+// Matches need at least this many bytes, found through a hash of their start.
+constexpr size_t min_match = 4;
+constexpr size_t max_offset = 0xFFFF;
+constexpr int hash_bits = 14;
+
+uint32_t read_u32( const char *p )
+{
+    uint32_t value;
+    std::memcpy( &value, p, sizeof( value ) );
+    return value;
+}
+
+size_t match_hash( const char *p )
+{
+    return ( read_u32( p ) * 2654435761u ) >> ( 32 - hash_bits );
+}
+
+void write_length( std::string &out, size_t len )
+{
+    while( len >= 255 ) {
+        out.push_back( static_cast<char>( 255 ) );
+        len -= 255;
+    }
+    out.push_back( static_cast<char>( len ) );
+}
+
+size_t read_length( const std::string &in, size_t &pos, size_t len )
+{
+    if( len != 15 ) {
+        return len;
+    }
+    unsigned char byte;
+    do {
+        if( pos >= in.size() ) {
+            malformed( "truncated length" );
+        }
+        byte = in[pos++];
+        len += byte;
+    } while( byte == 255 );
+    return len;
+}
+
+// Literals since the last match, then a match of earlier output (if any).
+void write_sequence( std::string &out, const char *literals, const size_t num_literals,
+                     const size_t offset, const size_t match_len )
+{
+    const size_t match_code = match_len > 0 ? match_len - min_match : 0;
+    out.push_back( static_cast<char>( ( std::min<size_t>( num_literals, 15 ) << 4 ) |
+                                      std::min<size_t>( match_code, 15 ) ) );
+    if( num_literals >= 15 ) {
+        write_length( out, num_literals - 15 );
+    }
+    out.append( literals, num_literals );
+    if( match_len > 0 ) {
+        out.push_back( static_cast<char>( offset & 0xFF ) );
+        out.push_back( static_cast<char>( offset >> 8 ) );
+        if( match_code >= 15 ) {
+            write_length( out, match_code - 15 );
+        }
+    }
+}
+
+} // namespace
+
+namespace submap_storage
+{
+
+std::string encode_json( const std::string &json )
+{
+    return json_encoder( json ).encode();
+}
+
+std::string decode_json( const std::string &data )
+{
+    return json_decoder( data ).decode();
+}
+
+std::string compress( const std::string &data )
+{
+    std::string out;
+    write_varint( out, data.size() );
+    const char *const in = data.data();
+    const size_t size = data.size();
+    std::vector<size_t> last_seen( size_t( 1 ) << hash_bits, SIZE_MAX );
+    size_t anchor = 0;
+    size_t pos = 0;
+    while( pos + min_match <= size ) {
+        const size_t hash = match_hash( in + pos );
+        const size_t candidate = last_seen[hash];
+        last_seen[hash] = pos;
+        if( candidate == SIZE_MAX || pos - candidate > max_offset ||
+            read_u32( in + candidate ) != read_u32( in + pos ) ) {
+            ++pos;
+            continue;
+        }
+        size_t len = min_match;
+        while( pos + len < size && in[candidate + len] == in[pos + len] ) {
+            ++len;
+        }
+        write_sequence( out, in + anchor, pos - anchor, pos - candidate, len );
+        pos += len;
+        anchor = pos;
+    }
+    if( anchor < size ) {
+        write_sequence( out, in + anchor, size - anchor, 0, 0 );
+    }
+    return out;
+}
+
+std::string decompress( const std::string &data )
+{
+    size_t pos = 0;
+    const uint64_t size = read_varint( data, pos );
+    // Nothing compresses better than 255 to 1.
+    if( size > data.size() * 255 ) {
+        malformed( "size out of range" );
+    }
+    std::string out;
+    out.reserve( size );
+    while( out.size() < size ) {
+        if( pos >= data.size() ) {
+            malformed( "truncated sequence" );
+        }
+        const unsigned char token = data[pos++];
+        const size_t num_literals = read_length( data, pos, token >> 4 );
+        if( num_literals > data.size() - pos || out.size() + num_literals > size ) {
+            malformed( "too many literals" );
+        }
+        out.append( data, pos, num_literals );
+        pos += num_literals;
+        if( out.size() == size ) {
+            break;
+        }
+        if( pos + 2 > data.size() ) {
+            malformed( "truncated match" );
+        }
+        const size_t offset = static_cast<unsigned char>( data[pos] ) |
+                              static_cast<unsigned char>( data[pos + 1] ) << 8;
+        pos += 2;
+        const size_t match_len = read_length( data, pos, token & 0x0F ) + min_match;
+        if( offset == 0 || offset > out.size() || out.size() + match_len > size ) {
+            malformed( "bad match" );
+        }
+        // Matches may overlap their own output, so copy byte by byte.
+        const size_t start = out.size() - offset;
+        for( size_t i = 0; i < match_len; ++i ) {
+            out.push_back( out[start + i] );
+        }
+    }
+    return out;
+}
+
+} // namespace submap_storage
+
+submap_region::submap_region( const std::string &path ) : path( path )
+{
+    if( file_exist( path ) ) {
+        load();
+    }
+}
+
+void submap_region::load()
+{
+    std::ifstream fin( path, std::ios::binary );
+    if( !fin ) {
+        throw std::runtime_error( "opening \"" + path + "\" failed" );
+    }
+    const std::string data( ( std::istreambuf_iterator<char>( fin ) ),
+                            std::istreambuf_iterator<char>() );
+    if( fin.bad() ) {
+        throw std::runtime_error( "reading \"" + path + "\" failed" );
+    }
+    const size_t magic_len = sizeof( region_magic ) - 1;
+    if( data.compare( 0, magic_len, region_magic ) != 0 ) {
+        malformed( "not a submap region" );
+    }
+    size_t pos = magic_len;
+    if( read_varint( data, pos ) != region_version ) {
+        malformed( "unknown region version" );
+    }
+    const uint64_t count = read_varint( data, pos );
+    for( uint64_t i = 0; i < count; ++i ) {
+        tripoint om_addr;
+        om_addr.x = static_cast<int>( unzigzag( read_varint( data, pos ) ) );
+        om_addr.y = static_cast<int>( unzigzag( read_varint( data, pos ) ) );
+        om_addr.z = static_cast<int>( unzigzag( read_varint( data, pos ) ) );
+        const uint64_t len = read_varint( data, pos );
+        if( len > data.size() - pos ) {
+            malformed( "truncated quad" );
+        }
+        quads[om_addr] = data.substr( pos, len );
+        pos += len;
+    }
+}
+
+cata::optional<std::string> submap_region::read_quad( const tripoint &om_addr ) const
+{
+    const auto iter = quads.find( om_addr );
+    if( iter == quads.end() ) {
+        return cata::nullopt;
+    }
+    return submap_storage::decode_json( submap_storage::decompress( iter->second ) );
+}
+
+void submap_region::write_quad( const tripoint &om_addr, const std::string &json )
+{
+    quads[om_addr] = submap_storage::compress( submap_storage::encode_json( json ) );
+    dirty = true;
+}
+
+void submap_region::remove_quad( const tripoint &om_addr )
+{
+    if( quads.erase( om_addr ) != 0 ) {
+        dirty = true;
+    }
+}
+
+bool submap_region::has_quad( const tripoint &om_addr ) const
+{
+    return quads.count( om_addr ) != 0;
+}
+
+std::vector<tripoint> submap_region::get_quads() const
+{
+    std::vector<tripoint> ret;
+    ret.reserve( quads.size() );
+    for( const auto &quad : quads ) {
+        ret.push_back( quad.first );
+    }
+    return ret;
+}
+
+void submap_region::save()
+{
+    if( !dirty ) {
+        return;
+    }
+    if( quads.empty() ) {
+        if( file_exist( path ) && !remove_file( path ) ) {
+            throw std::runtime_error( "removing \"" + path + "\" failed" );
+        }
+    } else {
+        write_to_file( path, [this]( std::ostream & fout ) {
+            std::string header( region_magic );
+            write_varint( header, region_version );
+            write_varint( header, quads.size() );
+            fout << header;
+            for( const auto &quad : quads ) {
+                std::string entry;
+                write_varint( entry, zigzag( quad.first.x ) );
+                write_varint( entry, zigzag( quad.first.y ) );
+                write_varint( entry, zigzag( quad.first.z ) );
+                write_varint( entry, quad.second.size() );
+                fout << entry << quad.second;
+            }
+        } );
+    }
+    dirty = false;
+}
@@ -0,0 +1,71 @@
+#pragma once
+#ifndef CATA_SRC_SUBMAP_STORAGE_H
+#define CATA_SRC_SUBMAP_STORAGE_H
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "optional.h"
+#include "point.h"
+
+/**
+ * Binary storage of the submaps saved by @ref mapbuffer.
+ *
+ * A quad of submaps is first written as JSON, as always.  The binary form replaces that
+ * text by a compact encoding: every string (member names, terrain and item ids, ...) is
+ * stored once in a table and referred to by index, integers are variable length, and
+ * runs of equal values in arrays are stored once with a count.  The result is compressed
+ * with a small LZ77 compressor.  Decoding gives back exactly the JSON that was encoded,
+ * so the loading code is the same for both formats.
+ *
+ * All functions throw std::runtime_error if the input is malformed.
+ */
+namespace submap_storage
+{
+
+std::string encode_json( const std::string &json );
+std::string decode_json( const std::string &data );
+
+std::string compress( const std::string &data );
+std::string decompress( const std::string &data );
+
+} // namespace submap_storage
+
+/**
+ * The binary quads of one overmap, packed into a single file of the world's "maps" folder.
+ * The file is read completely on first use and kept in memory, compressed, each quad
+ * is only decoded when it is loaded.  Changes are written back by @ref save.
+ */
+class submap_region
+{
+    public:
+        /** Reads the file if it exists, throws std::exception if it's broken. */
+        explicit submap_region( const std::string &path );
+
+        const std::string &get_path() const {
+            return path;
+        }
+        /** JSON of the quad at the overmap terrain position, if this region has it. */
+        cata::optional<std::string> read_quad( const tripoint &om_addr ) const;
+        void write_quad( const tripoint &om_addr, const std::string &json );
+        void remove_quad( const tripoint &om_addr );
+        bool has_quad( const tripoint &om_addr ) const;
+        std::vector<tripoint> get_quads() const;
+
+        /**
+         * Writes the file if anything changed, or removes it once it's empty.
+         * Throws std::exception if that fails.
+         */
+        void save();
+
+    private:
+        void load();
+
+        std::string path;
+        bool dirty = false;
+        // Compressed encoding of each quad.
+        std::map<tripoint, std::string> quads;
+};
+
+#endif // CATA_SRC_SUBMAP_STORAGE_H
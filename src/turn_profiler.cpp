@@ -0,0 +1,271 @@
+#include "turn_profiler.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <mutex>
+#include <ostream>
+
+#include "enum_conversions.h"
+#include "get_version.h"
+#include "json.h"
+#include "string_formatter.h"
+
+namespace io
+{
+
+template<>
+std::string enum_to_string<turn_phase>( turn_phase data )
+{
+    switch( data ) {
+        // *INDENT-OFF*
+        case turn_phase::total: return "total";
+        case turn_phase::timed_events: return "timed_events";
+        case turn_phase::missions: return "missions";
+        case turn_phase::hordes: return "hordes";
+        case turn_phase::player_body: return "player_body";
+        case turn_phase::autosave: return "autosave";
+        case turn_phase::weather: return "weather";
+        case turn_phase::activity: return "activity";
+        case turn_phase::sound_markers: return "sound_markers";
+        case turn_phase::player_input: return "player_input";
+        case turn_phase::scent: return "scent";
+        case turn_phase::floor_caches: return "floor_caches";
+        case turn_phase::falling: return "falling";
+        case turn_phase::vehicles: return "vehicles";
+        case turn_phase::fields: return "fields";
+        case turn_phase::items: return "items";
+        case turn_phase::sounds: return "sounds";
+        case turn_phase::map_cache: return "map_cache";
+        case turn_phase::monmove: return "monmove";
+        case turn_phase::npc_overmap_move: return "npc_overmap_move";
+        case turn_phase::furniture_emissions: return "furniture_emissions";
+        case turn_phase::player_turn: return "player_turn";
+        case turn_phase::wait_redraw: return "wait_redraw";
+        case turn_phase::transparency_cache: return "transparency_cache";
+        case turn_phase::vision_transparency_cache: return "vision_transparency_cache";
+        case turn_phase::outside_cache: return "outside_cache";
+        case turn_phase::floor_cache: return "floor_cache";
+        case turn_phase::vehicle_caches: return "vehicle_caches";
+        case turn_phase::seen_cache: return "seen_cache";
+        case turn_phase::sunlight_cache: return "sunlight_cache";
+        case turn_phase::obstacle_cache: return "obstacle_cache";
+        case turn_phase::lightmap: return "lightmap";
+        // *INDENT-ON*
+        case turn_phase::last:
+            break;
+    }
+    debugmsg( "Invalid turn_phase" );
+    abort();
+}
+
+} // namespace io
+
+namespace turn_profiler
+{
+
+namespace
+{
+
+constexpr int num_phases = static_cast<int>( turn_phase::last );
+
+struct turn_sample {
+    std::array<clock::duration, num_phases> time;
+    std::array<int, num_phases> calls;
+
+    void clear() {
+        time.fill( clock::duration::zero() );
+        calls.fill( 0 );
+    }
+};
+
+struct profiler_state {
+    turn_sample current;
+    // Ring buffer of finished turns, allocated on first use so that a disabled
+    // profiler costs no memory.
+    std::vector<turn_sample> window;
+    int next = 0;
+    int filled = 0;
+
+    void clear() {
+        current.clear();
+        window.clear();
+        next = 0;
+        filled = 0;
+    }
+};
+
+profiler_state &state()
+{
+    static profiler_state instance;
+    return instance;
+}
+
+double to_us( const clock::duration &d )
+{
+    return std::chrono::duration<double, std::micro>( d ).count();
+}
+
+int histogram_bucket( const clock::duration &d )
+{
+    int64_t us = std::chrono::duration_cast<std::chrono::microseconds>( d ).count();
+    int bucket = 0;
+    while( us > 0 && bucket < histogram_buckets - 1 ) {
+        us >>= 1;
+        ++bucket;
+    }
+    return bucket;
+}
+
+// Nearest-rank percentile of a sorted, non-empty sample.
+double percentile( const std::vector<clock::duration> &sorted, const double p )
+{
+    const size_t rank = static_cast<size_t>( p * ( sorted.size() - 1 ) + 0.5 );
+    return to_us( sorted[std::min( rank, sorted.size() - 1 )] );
+}
+
+} // namespace
+
+bool detail::enabled = false;
+
+void detail::record( const turn_phase phase, const clock::duration elapsed )
+{
+    // Phases such as the map caches may be timed on worker threads.
+    static std::mutex record_mutex;
+    std::lock_guard<std::mutex> lock( record_mutex );
+    turn_sample &cur = state().current;
+    const int idx = static_cast<int>( phase );
+    cur.time[idx] += elapsed;
+    cur.calls[idx]++;
+}
+
+void set_enabled( const bool enable )
+{
+    if( enable && !detail::enabled ) {
+        reset();
+    }
+    detail::enabled = enable;
+}
+
+void reset()
+{
+    state().clear();
+}
+
+void end_turn()
+{
+    if( !enabled() ) {
+        return;
+    }
+    profiler_state &s = state();
+    if( s.window.empty() ) {
+        s.window.resize( window_size );
+    }
+    // The total is only about the simulation, not about how long the keyboard was waited on.
+    const int total = static_cast<int>( turn_phase::total );
+    const int player_input = static_cast<int>( turn_phase::player_input );
+    s.current.time[total] -= std::min( s.current.time[total], s.current.time[player_input] );
+    s.window[s.next] = s.current;
+    s.next = ( s.next + 1 ) % window_size;
+    s.filled = std::min( s.filled + 1, window_size );
+    s.current.clear();
+}
+
+int recorded_turns()
+{
+    return state().filled;
+}
+
+std::vector<phase_summary> summarize()
+{
+    const profiler_state &s = state();
+    std::vector<phase_summary> result;
+    std::vector<clock::duration> samples;
+    samples.reserve( s.filled );
+    for( int phase = 0; phase < num_phases; ++phase ) {
+        phase_summary sum;
+        sum.phase = static_cast<turn_phase>( phase );
+        samples.clear();
+        clock::duration total = clock::duration::zero();
+        for( int i = 0; i < s.filled; ++i ) {
+            const turn_sample &turn = s.window[i];
+            if( turn.calls[phase] == 0 ) {
+                continue;
+            }
+            sum.turns++;
+            sum.calls += turn.calls[phase];
+            sum.histogram[histogram_bucket( turn.time[phase] )]++;
+            total += turn.time[phase];
+            samples.push_back( turn.time[phase] );
+        }
+        if( samples.empty() ) {
+            continue;
+        }
+        std::sort( samples.begin(), samples.end() );
+        sum.mean_us = to_us( total ) / samples.size();
+        sum.p50_us = percentile( samples, 0.50 );
+        sum.p95_us = percentile( samples, 0.95 );
+        sum.max_us = to_us( samples.back() );
+        result.push_back( sum );
+    }
+    return result;
+}
+
+std::string format_report()
+{
+    std::string report = string_format( "Turns recorded: %d (window %d)\n"
+                                        "Times are per turn, in microseconds, over turns the phase ran.\n\n",
+                                        recorded_turns(), window_size );
+    report += string_format( "%-26s %6s %10s %10s %10s %10s\n", "phase", "turns", "mean", "p50",
+                             "p95", "max" );
+    for( const phase_summary &sum : summarize() ) {
+        report += string_format( "%-26s %6d %10.1f %10.1f %10.1f %10.1f\n",
+                                 io::enum_to_string( sum.phase ), sum.turns, sum.mean_us, sum.p50_us,
+                                 sum.p95_us, sum.max_us );
+    }
+    return report;
+}
+
+void write_json( std::ostream &out )
+{
+    JsonOut jsout( out, true );
+    jsout.start_object();
+    jsout.member( "version", getVersionString() );
+    jsout.member( "window_size", window_size );
+    jsout.member( "turns", recorded_turns() );
+    jsout.member( "phases" );
+    jsout.start_array();
+    for( const phase_summary &sum : summarize() ) {
+        jsout.start_object();
+        jsout.member( "phase", io::enum_to_string( sum.phase ) );
+        jsout.member( "turns", sum.turns );
+        jsout.member( "calls", sum.calls );
+        jsout.member( "mean_us", sum.mean_us );
+        jsout.member( "p50_us", sum.p50_us );
+        jsout.member( "p95_us", sum.p95_us );
+        jsout.member( "max_us", sum.max_us );
+        jsout.member( "histogram_log2_us" );
+        jsout.write_as_array( sum.histogram );
+        jsout.end_object();
+    }
+    jsout.end_array();
+    jsout.end_object();
+}
+
+void write_csv( std::ostream &out )
+{
+    out << "phase,turns,calls,mean_us,p50_us,p95_us,max_us";
+    for( int i = 0; i < histogram_buckets; ++i ) {
+        out << ",hist_" << i;
+    }
+    out << '\n';
+    for( const phase_summary &sum : summarize() ) {
+        out << io::enum_to_string( sum.phase ) << ',' << sum.turns << ',' << sum.calls << ','
+            << sum.mean_us << ',' << sum.p50_us << ',' << sum.p95_us << ',' << sum.max_us;
+        for( const int count : sum.histogram ) {
+            out << ',' << count;
+        }
+        out << '\n';
+    }
+}
+
+} // namespace turn_profiler
@@ -0,0 +1,149 @@
+#pragma once
+#ifndef CATA_SRC_TURN_PROFILER_H
+#define CATA_SRC_TURN_PROFILER_H
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+#include "enum_traits.h"
+
+/**
+ * Phases of @ref game::do_turn and of the map cache builders that can be timed
+ * by the turn profiler.  Phases may nest (e.g. the map cache builders run inside
+ * @ref turn_phase::map_cache), so their times are inclusive and do not add up to
+ * @ref turn_phase::total.  The total leaves out @ref turn_phase::player_input, which
+ * mostly waits for the keyboard.
+ */
+enum class turn_phase : int {
+    total,
+    timed_events,
+    missions,
+    hordes,
+    player_body,
+    autosave,
+    weather,
+    activity,
+    sound_markers,
+    player_input,
+    scent,
+    floor_caches,
+    falling,
+    vehicles,
+    fields,
+    items,
+    sounds,
+    map_cache,
+    monmove,
+    npc_overmap_move,
+    furniture_emissions,
+    player_turn,
+    wait_redraw,
+    transparency_cache,
+    vision_transparency_cache,
+    outside_cache,
+    floor_cache,
+    vehicle_caches,
+    seen_cache,
+    sunlight_cache,
+    obstacle_cache,
+    lightmap,
+    last
+};
+
+template<>
+struct enum_traits<turn_phase> {
+    static constexpr turn_phase last = turn_phase::last;
+};
+
+/**
+ * Lightweight wall-clock profiler for the simulation loop.
+ *
+ * Code is instrumented with @ref turn_profiler::scoped_timer objects.  While the
+ * profiler is disabled (the default) a timer only tests a flag, so the
+ * instrumentation can stay compiled in.  While enabled, time spent in each
+ * phase is accumulated for the current turn and folded into a rolling window
+ * of the last @ref turn_profiler::window_size turns by @ref turn_profiler::end_turn.
+ */
+namespace turn_profiler
+{
+
+using clock = std::chrono::steady_clock;
+
+/** Number of most recent turns kept for the statistics. */
+constexpr int window_size = 1000;
+/**
+ * Number of histogram buckets.  Bucket 0 counts samples shorter than 1 µs,
+ * bucket i counts samples in [2^(i-1), 2^i) µs, the last bucket is open ended.
+ */
+constexpr int histogram_buckets = 24;
+
+struct phase_summary {
+    turn_phase phase = turn_phase::total;
+    /** Turns in the window during which the phase ran at least once. */
+    int turns = 0;
+    /** Number of times the phase ran during the window. */
+    int64_t calls = 0;
+    /** Statistics of the per-turn time of the phase, in microseconds. */
+    double mean_us = 0.0;
+    double p50_us = 0.0;
+    double p95_us = 0.0;
+    double max_us = 0.0;
+    std::array<int, histogram_buckets> histogram = {};
+};
+
+namespace detail
+{
+extern bool enabled;
+void record( turn_phase phase, clock::duration elapsed );
+} // namespace detail
+
+inline bool enabled()
+{
+    return detail::enabled;
+}
+
+/** Enabling starts a fresh window, disabling keeps the collected data around. */
+void set_enabled( bool enable );
+/** Drops all collected data. */
+void reset();
+/** Finishes the current turn and adds its phase times to the rolling window. */
+void end_turn();
+/** Number of turns currently in the rolling window. */
+int recorded_turns();
+
+/** Statistics for every phase that ran at least once during the window. */
+std::vector<phase_summary> summarize();
+/** Human readable table of @ref summarize, for the debug menu. */
+std::string format_report();
+void write_json( std::ostream &out );
+void write_csv( std::ostream &out );
+
+class scoped_timer
+{
+    public:
+        explicit scoped_timer( turn_phase phase ) : phase( phase ), active( enabled() ) {
+            if( active ) {
+                start = clock::now();
+            }
+        }
+        ~scoped_timer() {
+            if( active ) {
+                detail::record( phase, clock::now() - start );
+            }
+        }
+        scoped_timer( const scoped_timer & ) = delete;
+        scoped_timer &operator=( const scoped_timer & ) = delete;
+
+    private:
+        turn_phase phase;
+        bool active;
+        clock::time_point start;
+};
+
+} // namespace turn_profiler
+
+#endif // CATA_SRC_TURN_PROFILER_H
@@ -5320,8 +5320,8 @@ cata::optional<vehicle_stack::iterator> vehicle::add_item( int part, const item
 
 bool vehicle::remove_item( int part, item *it )
 {
-    const cata::colony<item> &veh_items = parts[part].items;
-    const cata::colony<item>::const_iterator iter = veh_items.get_iterator_from_pointer( it );
+    const item_colony &veh_items = parts[part].items;
+    const item_colony::const_iterator iter = veh_items.get_iterator_from_pointer( it );
     if( iter == veh_items.end() ) {
         return false;
     }
@@ -5331,7 +5331,7 @@ bool vehicle::remove_item( int part, item *it )
 
 vehicle_stack::iterator vehicle::remove_item( int part, const vehicle_stack::const_iterator &it )
 {
-    cata::colony<item> &veh_items = parts[part].items;
+    item_colony &veh_items = parts[part].items;
 
     // remove from the active items cache (if it isn't there does nothing)
     active_items.remove( &*it );
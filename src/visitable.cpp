@@ -679,7 +679,7 @@ std::list<item> visitable<map_cursor>::remove_items_with( const
     // fetch the appropriate item stack
     point offset;
     submap *sub = here.get_submap_at( *cur, offset );
-    cata::colony<item> &stack = sub->get_items( offset );
+    item_colony &stack = sub->get_items( offset );
 
     for( auto iter = stack.begin(); iter != stack.end(); ) {
         if( filter( *iter ) ) {
@@ -1112,9 +1112,76 @@ int weather_manager::get_temperature( const tripoint_abs_omt &location )
     return location.z() < 0 ? AVERAGE_ANNUAL_TEMPERATURE : temperature;
 }
 
+const temperature_history &weather_manager::get_temperature_history( const tripoint &location,
+        const int temp_mod, const temperature_flag flag, const time_point &from, const time_point &to )
+{
+    const weather_generator &wgen = get_cur_weather_gen();
+    const unsigned int seed = g->get_seed();
+    const auto temperature_at = [&]( const time_point & t ) {
+        // Use weather if above ground, use map temp if below
+        double env_temperature = 0;
+        if( location.z >= 0 && flag != temperature_flag::ROOT_CELLAR ) {
+            env_temperature = wgen.get_weather_temperature( location, t, seed ) + temp_mod;
+        } else {
+            env_temperature = AVERAGE_ANNUAL_TEMPERATURE + temp_mod;
+        }
+
+        switch( flag ) {
+            case temperature_flag::NORMAL:
+                // Just use the temperature normally
+                break;
+            case temperature_flag::FRIDGE:
+                env_temperature = std::min( env_temperature, static_cast<double>( temperatures::fridge ) );
+                break;
+            case temperature_flag::FREEZER:
+                env_temperature = std::min( env_temperature, static_cast<double>( temperatures::freezer ) );
+                break;
+            case temperature_flag::HEATER:
+                env_temperature = std::max( env_temperature, static_cast<double>( temperatures::normal ) );
+                break;
+            case temperature_flag::ROOT_CELLAR:
+                env_temperature = AVERAGE_ANNUAL_TEMPERATURE;
+                break;
+            default:
+                debugmsg( "Temperature flag enum not valid.  Using normal temperature." );
+        }
+        return static_cast<int>( env_temperature );
+    };
+
+    temperature_history &history = temperature_histories[std::make_tuple( location, temp_mod, flag )];
+    if( history.temperatures.empty() ) {
+        history.start = from;
+    } else if( from < history.start ) {
+        std::vector<int> older;
+        for( time_point t = from; t < history.start; t += 1_hours ) {
+            older.push_back( temperature_at( t ) );
+        }
+        history.temperatures.insert( history.temperatures.begin(), older.begin(), older.end() );
+        history.start = from;
+        history.rot_points.clear();
+        history.cold_rot_points.clear();
+    }
+    for( time_point t = history.end(); t <= to; t += 1_hours ) {
+        history.temperatures.push_back( temperature_at( t ) );
+    }
+
+    if( history.rot_points.empty() ) {
+        history.rot_points.push_back( 0 );
+        history.cold_rot_points.push_back( 0 );
+    }
+    for( size_t i = history.rot_points.size() - 1; i < history.temperatures.size(); ++i ) {
+        const int temp = history.temperatures[i];
+        history.rot_points.push_back( history.rot_points.back() + get_hourly_rotpoints_at_temp( temp ) );
+        history.cold_rot_points.push_back( history.cold_rot_points.back() +
+                                           get_hourly_rotpoints_at_temp( std::min( temperatures::fridge, temp ) ) );
+    }
+    return history;
+}
+
 void weather_manager::clear_temp_cache()
 {
     temperature_cache.clear();
+    temperature_histories.clear();
 }
 
 ///@}
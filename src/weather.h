@@ -37,6 +37,9 @@ static constexpr int BODYTEMP_SCORCHING = 9500;
 ///@}
 
 #include <string>
+#include <cstdint>
+#include <map>
+#include <tuple>
 #include <vector>
 #include <unordered_map>
 #include <utility>
@@ -45,6 +48,7 @@ class Character;
 class item;
 struct trap;
 struct rl_vec2d;
+enum class temperature_flag : int;
 
 double precip_mm_per_hour( precip_class p );
 void handle_weather_effects( weather_type_id w );
@@ -148,6 +152,28 @@ int incident_sunlight( weather_type_id wtype,
 void weather_sound( translation sound_message, std::string sound_effect );
 void wet( Character &target, int amount );
 
+/**
+ * Environment temperatures of a spot at every whole hour of the past, as the weather generator
+ * gives them, with the running sums of the rot points at those temperatures. Shared by all items
+ * on the spot that catch up on the time they spent outside of the reality bubble.
+ */
+struct temperature_history {
+    // Time of temperatures[0], a whole hour.
+    time_point start;
+    std::vector<int> temperatures;
+    // rot_points[i] is the sum of the hourly rot points of temperatures[0] up to temperatures[i - 1].
+    std::vector<int64_t> rot_points;
+    // The same for COLD items, with the temperatures capped at the fridge temperature.
+    std::vector<int64_t> cold_rot_points;
+
+    time_point end() const {
+        return start + temperatures.size() * 1_hours;
+    }
+    size_t index( const time_point &t ) const {
+        return static_cast<size_t>( ( t - start ) / 1_hours );
+    }
+};
+
 class weather_manager
 {
     public:
@@ -178,6 +204,15 @@ class weather_manager
         int get_temperature( const tripoint &location );
         // Returns outdoor or indoor temperature of given location
         int get_temperature( const tripoint_abs_omt &location );
+        /** Whole hour histories by location, temperature modifier and flag, cleared with the temperature cache */
+        std::map<std::tuple<tripoint, int, temperature_flag>, temperature_history> temperature_histories;
+        /**
+         * Temperatures at @p location (map square, as given to the weather generator) for every whole
+         * hour from @p from to @p to, both included, with @p temp_mod added and limited the way
+         * @p flag does it.
+         */
+        const temperature_history &get_temperature_history( const tripoint &location, int temp_mod,
+                temperature_flag flag, const time_point &from, const time_point &to );
         void clear_temp_cache();
         void on_load();
         static void serialize_all( JsonOut &json );
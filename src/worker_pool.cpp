@@ -0,0 +1,101 @@
+#include "worker_pool.h"
+
+#include <algorithm>
+
+worker_pool::worker_pool( const int num_workers )
+{
+    workers.reserve( std::max( num_workers, 0 ) );
+    for( int i = 0; i < num_workers; ++i ) {
+        workers.emplace_back( &worker_pool::work, this );
+    }
+}
+
+worker_pool::~worker_pool()
+{
+    {
+        std::lock_guard<std::mutex> lock( mutex );
+        stopping = true;
+    }
+    job_started.notify_all();
+    for( std::thread &worker : workers ) {
+        worker.join();
+    }
+}
+
+void worker_pool::parallel_for( const int begin, const int end,
+                                const std::function<void( int )> &task )
+{
+    if( workers.empty() || end - begin <= 1 ) {
+        for( int i = begin; i < end; ++i ) {
+            task( i );
+        }
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock( mutex );
+    this->task = &task;
+    next_index = begin;
+    end_index = end;
+    unfinished = end - begin;
+    error = nullptr;
+    ++job_id;
+    job_started.notify_all();
+
+    run_tasks( lock );
+    job_finished.wait( lock, [this]() {
+        return unfinished == 0;
+    } );
+    this->task = nullptr;
+    if( error ) {
+        std::exception_ptr err = error;
+        error = nullptr;
+        std::rethrow_exception( err );
+    }
+}
+
+void worker_pool::work()
+{
+    unsigned int last_job = 0;
+    std::unique_lock<std::mutex> lock( mutex );
+    while( true ) {
+        job_started.wait( lock, [this, last_job]() {
+            return stopping || job_id != last_job;
+        } );
+        if( stopping ) {
+            return;
+        }
+        last_job = job_id;
+        run_tasks( lock );
+    }
+}
+
+void worker_pool::run_tasks( std::unique_lock<std::mutex> &lock )
+{
+    while( task != nullptr && next_index < end_index ) {
+        const std::function<void( int )> &current = *task;
+        const int index = next_index++;
+        lock.unlock();
+        try {
+            current( index );
+        } catch( ... ) {
+            lock.lock();
+            if( !error ) {
+                error = std::current_exception();
+            }
+            lock.unlock();
+        }
+        lock.lock();
+        if( --unfinished == 0 ) {
+            job_finished.notify_all();
+        }
+    }
+}
+
+worker_pool &get_worker_pool()
+{
+    // The caller is busy as well, and more than a few workers don't pay off for the
+    // small jobs this is used for.
+    static worker_pool pool( std::min( static_cast<int>( std::thread::hardware_concurrency() ) - 1,
+                                       3 ) );
+    return pool;
+}
@@ -0,0 +1,63 @@
+#pragma once
+#ifndef CATA_SRC_WORKER_POOL_H
+#define CATA_SRC_WORKER_POOL_H
+
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * Small set of threads for splitting independent work, such as building the caches of
+ * each z-level, over the cores of the host.
+ *
+ * The calling thread takes part in the work, so a pool without workers simply runs
+ * everything on the caller.
+ */
+class worker_pool
+{
+    public:
+        explicit worker_pool( int num_workers );
+        ~worker_pool();
+
+        worker_pool( const worker_pool & ) = delete;
+        worker_pool &operator=( const worker_pool & ) = delete;
+
+        int num_workers() const {
+            return static_cast<int>( workers.size() );
+        }
+
+        /**
+         * Calls @p task for every index in [begin, end) and returns once all calls have
+         * finished.  Calls may run concurrently and in any order, so a task must only write
+         * to data owned by its index.  If tasks throw, the first exception is rethrown here
+         * after all calls have finished.
+         */
+        void parallel_for( int begin, int end, const std::function<void( int )> &task );
+
+    private:
+        void work();
+        // Runs tasks of the current job until none are left, lock must hold the mutex.
+        void run_tasks( std::unique_lock<std::mutex> &lock );
+
+        std::vector<std::thread> workers;
+
+        // Everything below is guarded by the mutex.
+        std::mutex mutex;
+        std::condition_variable job_started;
+        std::condition_variable job_finished;
+        const std::function<void( int )> *task = nullptr;
+        int next_index = 0;
+        int end_index = 0;
+        int unfinished = 0;
+        unsigned int job_id = 0;
+        bool stopping = false;
+        std::exception_ptr error;
+};
+
+/** Pool shared by the game, without spare cores on the host it has no workers. */
+worker_pool &get_worker_pool();
+
+#endif // CATA_SRC_WORKER_POOL_H
@@ -1,14 +1,19 @@
 #include "catch/catch.hpp"
 
+#include <list>
+#include <map>
 #include <memory>
 #include <set>
+#include <vector>
 
+#include "active_item_cache.h"
 #include "calendar.h"
 #include "game_constants.h"
 #include "item.h"
 #include "map.h"
 #include "map_helpers.h"
 #include "point.h"
+#include "type_id.h"
 
 TEST_CASE( "place_active_item_at_various_coordinates", "[item]" )
 {
@@ -47,3 +52,83 @@ TEST_CASE( "place_active_item_at_various_coordinates", "[item]" )
         }
     }
 }
+
+TEST_CASE( "active_items_are_only_visited_when_due", "[item]" )
+{
+    const time_point start = calendar::turn;
+    std::list<item> items;
+    items.emplace_back( "firecracker_act", 0, item::default_charges_tag() );
+    item &firecracker = items.front();
+    firecracker.activate();
+    for( int i = 0; i < 100; ++i ) {
+        items.emplace_back( "apple" );
+    }
+    REQUIRE( firecracker.processing_interval() == 1_turns );
+    REQUIRE( items.back().processing_interval() == 10_minutes );
+
+    active_item_cache cache;
+    for( item &it : items ) {
+        cache.add( it, point_zero );
+    }
+    // Adding again does nothing.
+    cache.add( items.back(), point_zero );
+
+    std::map<const item *, int> visits;
+    size_t most_in_a_turn = 0;
+    const int turns = to_turns<int>( 10_minutes );
+    for( int i = 0; i < turns; ++i ) {
+        calendar::turn = start + time_duration::from_turns( i );
+        const std::vector<item_reference> due = cache.get_for_processing();
+        most_in_a_turn = std::max( most_in_a_turn, due.size() );
+        for( const item_reference &ref : due ) {
+            ++visits[ref.item_ref.get()];
+        }
+    }
+    CHECK( visits[&firecracker] == turns );
+    for( const item &it : items ) {
+        if( &it != &firecracker ) {
+            CHECK( visits[&it] == 1 );
+        }
+    }
+    // The apples are spread out instead of all waking up together.
+    CHECK( most_in_a_turn <= 2 );
+
+    items.pop_back();
+    cache.remove( &items.back() );
+    CHECK( cache.get().size() == items.size() - 1 );
+    calendar::turn = start;
+}
+
+TEST_CASE( "revivable_corpses_are_visited_every_ten_minutes", "[item]" )
+{
+    const time_point old_turn = calendar::turn;
+    const time_point start = calendar::start_of_cataclysm + 1_days;
+    calendar::turn = start;
+    std::list<item> items;
+    // Old enough to get up in five minutes, see item::ready_to_revive.
+    items.push_back( item::make_corpse( mtype_id( "mon_zombie" ), start - 7_hours + 5_minutes ) );
+    item &corpse = items.front();
+    REQUIRE( corpse.can_revive() );
+    REQUIRE( corpse.active );
+
+    active_item_cache cache;
+    cache.add( corpse, point_zero );
+    // Each visit is one roll of ready_to_revive.
+    std::vector<time_point> rolls;
+    const int turns = to_turns<int>( 2_hours );
+    for( int i = 0; i < turns; ++i ) {
+        calendar::turn = start + time_duration::from_turns( i );
+        for( const item_reference &ref : cache.get_for_processing() ) {
+            REQUIRE( ref.item_ref.get() == &corpse );
+            rolls.push_back( calendar::turn );
+        }
+    }
+    // Right away, when it could first get up, then every ten minutes.
+    REQUIRE( rolls.size() == 13 );
+    CHECK( rolls[0] == start );
+    CHECK( rolls[1] == start + 5_minutes );
+    for( size_t i = 2; i < rolls.size(); ++i ) {
+        CHECK( rolls[i] - rolls[i - 1] == 10_minutes );
+    }
+    calendar::turn = old_turn;
+}
@@ -0,0 +1,232 @@
+// Headless, deterministic benchmark of the simulation loop.
+//
+// Loads a saved world (or generates a fresh one), seeds the RNG, lets the player wait (or
+// sleep, see game::is_fast_forwarding) for a number of turns by running game::do_turn without
+// any interface, and reports the throughput together with the per-phase times collected by the
+// turn profiler.  The world is never saved, so the same save can be used to compare builds.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "avatar.h"
+#include "calendar.h"
+#include "cata_utility.h"
+#include "color.h"
+#include "debug.h"
+#include "filesystem.h"
+#include "game.h"
+#include "loading_ui.h"
+#include "map.h"
+#include "options.h"
+#include "output.h"
+#include "overmap.h"
+#include "overmapbuffer.h"
+#include "path_info.h"
+#include "point.h"
+#include "rng.h"
+#include "turn_profiler.h"
+#include "type_id.h"
+#include "weather.h"
+#include "worldfactory.h"
+
+namespace
+{
+
+struct bench_options {
+    std::string world;
+    std::string user_dir = "./bench_user_dir/";
+    std::vector<mod_id> mods;
+    int turns = 1000;
+    unsigned int seed = 42;
+    bool sleep = false;
+    std::string json_path;
+    std::string csv_path;
+};
+
+void print_usage()
+{
+    printf( "Usage: cata_bench [options]\n" );
+    printf( "  --world=<name>         Load the first save of this world from the user dir.\n" );
+    printf( "                         Without it a fresh world is generated.\n" );
+    printf( "  --user-dir=<dir>       User dir to load worlds from (default ./bench_user_dir/).\n" );
+    printf( "  --mods=<mod1,mod2,…>   Mods for a generated world (dda is always loaded).\n" );
+    printf( "  --turns=<n>            Number of turns to simulate (default 1000).\n" );
+    printf( "  --seed=<n>             RNG seed (default 42).\n" );
+    printf( "  --sleep                Let the player sleep instead of wait.\n" );
+    printf( "  --json=<file>          Write the per-phase profile as JSON.\n" );
+    printf( "  --csv=<file>           Write the per-phase profile as CSV.\n" );
+}
+
+bool parse_arguments( int argc, const char *argv[], bench_options &opts )
+{
+    for( int i = 1; i < argc; ++i ) {
+        const std::string arg = argv[i];
+        const size_t eq = arg.find( '=' );
+        const std::string name = arg.substr( 0, eq );
+        const std::string value = eq == std::string::npos ? std::string() : arg.substr( eq + 1 );
+        if( name == "--world" ) {
+            opts.world = value;
+        } else if( name == "--user-dir" ) {
+            opts.user_dir = string_ends_with( value, "/" ) ? value : value + "/";
+        } else if( name == "--mods" ) {
+            for( const std::string &mod_name : string_split( value, ',' ) ) {
+                if( !mod_name.empty() ) {
+                    opts.mods.emplace_back( mod_name );
+                }
+            }
+        } else if( name == "--turns" ) {
+            opts.turns = std::atoi( value.c_str() );
+        } else if( name == "--seed" ) {
+            opts.seed = static_cast<unsigned int>( std::strtoul( value.c_str(), nullptr, 10 ) );
+        } else if( name == "--sleep" ) {
+            opts.sleep = true;
+        } else if( name == "--json" ) {
+            opts.json_path = value;
+        } else if( name == "--csv" ) {
+            opts.csv_path = value;
+        } else {
+            return false;
+        }
+    }
+    return opts.turns > 0;
+}
+
+void init_paths_and_options( const std::string &user_dir )
+{
+    PATH_INFO::init_base_path( "" );
+    PATH_INFO::init_user_dir( user_dir );
+    PATH_INFO::set_standard_filenames();
+    assure_dir_exist( user_dir );
+    assure_dir_exist( PATH_INFO::config_dir() );
+    assure_dir_exist( PATH_INFO::savedir() );
+
+    get_options().init();
+    get_options().load();
+    // Never touch the save being measured.
+    get_options().get_option( "AUTOSAVE" ).setValue( "false" );
+    init_colors();
+}
+
+// Same setup as the test suite: a new world with a fresh character.
+void generate_world( std::vector<mod_id> mods )
+{
+    mods.insert( mods.begin(), mod_id( "dda" ) );
+    g->load_static_data();
+    world_generator->set_active_world( nullptr );
+    world_generator->init();
+    WORLDPTR world = world_generator->make_new_world( mods );
+    if( world == nullptr ) {
+        throw std::runtime_error( "unable to create world" );
+    }
+    world_generator->set_active_world( world );
+
+    calendar::set_eternal_season( get_option<bool>( "ETERNAL_SEASON" ) );
+    calendar::set_season_length( get_option<int>( "SEASON_LENGTH" ) );
+
+    loading_ui ui( false );
+    g->load_core_data( ui );
+    g->load_world_modfiles( ui );
+
+    get_avatar() = avatar();
+    get_avatar().create( character_type::NOW );
+    get_map() = map();
+
+    overmap_special_batch empty_specials( point_abs_om{} );
+    overmap_buffer.create_custom_overmap( point_abs_om{}, empty_specials );
+
+    map &here = get_map();
+    here.load( tripoint_abs_sm( here.get_abs_sub() ), false );
+    get_weather().update_weather();
+}
+
+void load_world( const std::string &name )
+{
+    g->load_static_data();
+    if( !g->load( name ) ) {
+        throw std::runtime_error( "unable to load world " + name );
+    }
+}
+
+} // namespace
+
+int main( int argc, const char *argv[] )
+{
+    bench_options opts;
+    if( !parse_arguments( argc, argv, opts ) ) {
+        print_usage();
+        return EXIT_FAILURE;
+    }
+
+    // Headless: no drawing, popups or animations.
+    test_mode = true;
+    setupDebug( DebugOutput::std_err );
+
+    try {
+        init_paths_and_options( opts.user_dir );
+        g = std::make_unique<game>();
+        g->new_game = true;
+        if( opts.world.empty() ) {
+            generate_world( opts.mods );
+        } else {
+            load_world( opts.world );
+        }
+    } catch( const std::exception &err ) {
+        fprintf( stderr, "Terminated: %s\n", err.what() );
+        return EXIT_FAILURE;
+    }
+
+    srand( opts.seed );
+    rng_set_engine_seed( opts.seed );
+    turn_profiler::set_enabled( true );
+
+    avatar &player_character = get_avatar();
+    if( opts.sleep ) {
+        player_character.fall_asleep( opts.turns * 1_turns );
+    }
+    // The first do_turn of a new game doesn't advance the calendar, so count the turns that
+    // actually passed instead of the calls.
+    const time_point start_turn = calendar::turn;
+    int turns_done = 0;
+    const auto start = std::chrono::steady_clock::now();
+    while( turns_done < opts.turns ) {
+        // Spend the player's moves so do_turn never waits for input.
+        player_character.moves = 0;
+        const bool game_over = g->do_turn();
+        turns_done = to_turns<int>( calendar::turn - start_turn );
+        if( game_over ) {
+            break;
+        }
+    }
+    // Close the last simulated turn.
+    turn_profiler::end_turn();
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    printf( "Simulated %d turns in %.3f seconds (%.1f turns/s, seed %u%s)\n\n", turns_done,
+            elapsed.count(), turns_done / elapsed.count(), opts.seed,
+            g->is_fast_forwarding() ? ", fast forwarding" : "" );
+    printf( "%s", turn_profiler::format_report().c_str() );
+
+    bool ok = turns_done == opts.turns;
+    if( !ok ) {
+        fprintf( stderr, "The game ended after %d turns.\n", turns_done );
+    }
+    if( !opts.json_path.empty() ) {
+        ok = write_to_file( opts.json_path, turn_profiler::write_json, "turn profile" ) && ok;
+    }
+    if( !opts.csv_path.empty() ) {
+        ok = write_to_file( opts.csv_path, turn_profiler::write_csv, "turn profile" ) && ok;
+    }
+
+    if( opts.world.empty() ) {
+        world_generator->delete_world( world_generator->active_world->world_name, true );
+    }
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,219 @@
+#include "catch/catch.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <list>
+#include <vector>
+
+#include "calendar.h"
+#include "character.h"
+#include "creature.h"
+#include "creature_tracker.h"
+#include "game.h"
+#include "game_constants.h"
+#include "map.h"
+#include "map_helpers.h"
+#include "map_iterator.h"
+#include "monfaction.h"
+#include "monster.h"
+#include "mtype.h"
+#include "player_helpers.h"
+#include "point.h"
+#include "rng.h"
+
+static std::vector<monster *> spawn_random_monsters( int count )
+{
+    std::vector<monster *> ret;
+    while( static_cast<int>( ret.size() ) < count ) {
+        const tripoint p( rng( 0, MAPSIZE_X - 1 ), rng( 0, MAPSIZE_Y - 1 ), 0 );
+        if( g->critter_at( p ) ) {
+            continue;
+        }
+        ret.push_back( &spawn_test_monster( one_in( 3 ) ? "mon_dog" : "mon_zombie", p ) );
+    }
+    return ret;
+}
+
+// All living monsters in the box, the slow way.
+static std::vector<monster *> monsters_near( const tripoint &center, int radius, int radiusz )
+{
+    std::vector<monster *> ret;
+    for( monster &critter : g->all_monsters() ) {
+        const tripoint d = ( critter.pos() - center ).abs();
+        if( d.x <= radius && d.y <= radius && d.z <= radiusz ) {
+            ret.push_back( &critter );
+        }
+    }
+    std::sort( ret.begin(), ret.end() );
+    return ret;
+}
+
+static void check_index( const std::vector<monster *> &monsters )
+{
+    for( monster *critter : monsters ) {
+        CHECK( g->critter_at<monster>( critter->pos() ) == critter );
+    }
+    for( int i = 0; i < 20; ++i ) {
+        const tripoint center( rng( -10, MAPSIZE_X + 10 ), rng( -10, MAPSIZE_Y + 10 ), rng( -2, 1 ) );
+        const int radius = rng( 0, 40 );
+        const int radiusz = rng( 0, 1 );
+        CAPTURE( center, radius, radiusz );
+        std::vector<monster *> found = g->critter_tracker->find_all_near( center, radius, radiusz );
+        std::sort( found.begin(), found.end() );
+        CHECK( found == monsters_near( center, radius, radiusz ) );
+    }
+}
+
+TEST_CASE( "creature_tracker_finds_monsters_by_location", "[creature_tracker]" )
+{
+    clear_map();
+    std::vector<monster *> monsters = spawn_random_monsters( 300 );
+    check_index( monsters );
+
+    // Moving around, across submap borders as well.
+    for( monster *critter : monsters ) {
+        const tripoint dest = critter->pos() + tripoint( rng( -SEEX, SEEX ), rng( -SEEY, SEEY ), 0 );
+        if( get_map().inbounds( dest ) && !g->critter_at( dest ) ) {
+            critter->setpos( dest );
+        }
+    }
+    check_index( monsters );
+
+    // Swapping places.
+    monster &first = *monsters[0];
+    monster &second = *monsters[1];
+    const tripoint first_pos = first.pos();
+    const tripoint second_pos = second.pos();
+    g->swap_critters( first, second );
+    CHECK( g->critter_at<monster>( first_pos ) == &second );
+    CHECK( g->critter_at<monster>( second_pos ) == &first );
+
+    // Removing.
+    const tripoint removed_pos = monsters.back()->pos();
+    g->remove_zombie( *monsters.back() );
+    monsters.pop_back();
+    CHECK( g->critter_at<monster>( removed_pos ) == nullptr );
+    check_index( monsters );
+}
+
+TEST_CASE( "creature_tracker_finds_hostile_monsters", "[creature_tracker]" )
+{
+    clear_map();
+    spawn_random_monsters( 200 );
+    const mfaction_id zombie = mfaction_str_id( "zombie" ).id();
+    const tripoint center( HALF_MAPSIZE_X, HALF_MAPSIZE_Y, 0 );
+    const int radius = 30;
+
+    std::vector<monster *> expected;
+    for( monster *critter : monsters_near( center, radius, radius ) ) {
+        const mf_attitude att = zombie.obj().attitude( critter->faction );
+        if( att != MFA_NEUTRAL && att != MFA_FRIENDLY ) {
+            expected.push_back( critter );
+        }
+    }
+    std::vector<monster *> found = g->critter_tracker->find_hostile_near( zombie, center, radius );
+    std::sort( found.begin(), found.end() );
+    CHECK( found == expected );
+}
+
+TEST_CASE( "creature_tracker_finds_monsters_by_faction_and_type", "[creature_tracker]" )
+{
+    clear_map();
+    spawn_random_monsters( 200 );
+    const mfaction_id zombie = mfaction_str_id( "zombie" ).id();
+    const tripoint center( HALF_MAPSIZE_X, HALF_MAPSIZE_Y, 0 );
+    const int radius = 20;
+
+    std::vector<monster *> expected;
+    for( monster *critter : monsters_near( center, radius, radius ) ) {
+        if( critter->faction == zombie ) {
+            expected.push_back( critter );
+        }
+    }
+    std::vector<monster *> found = g->critter_tracker->find_faction_near( zombie, center, radius );
+    std::sort( found.begin(), found.end() );
+    CHECK( found == expected );
+
+    const mtype_id dog( "mon_dog" );
+    std::vector<monster *> dogs;
+    for( monster &critter : g->all_monsters() ) {
+        if( critter.type->id == dog ) {
+            dogs.push_back( &critter );
+        }
+    }
+    REQUIRE( !dogs.empty() );
+    CHECK( g->critter_tracker->find_all_of_type( dog ) == dogs );
+
+    dogs.front()->die( nullptr );
+    g->cleanup_dead();
+    dogs.erase( dogs.begin() );
+    CHECK( g->critter_tracker->find_all_of_type( dog ) == dogs );
+    CHECK( g->critter_tracker->find_all_of_type( mtype_id( "mon_null" ) ).empty() );
+}
+
+TEST_CASE( "creatures_in_radius_match_critter_at", "[creature_tracker]" )
+{
+    clear_map();
+    spawn_random_monsters( 200 );
+    map &here = get_map();
+    for( int i = 0; i < 10; ++i ) {
+        const tripoint center( rng( 0, MAPSIZE_X - 1 ), rng( 0, MAPSIZE_Y - 1 ), 0 );
+        const size_t radius = rng( 1, 20 );
+        CAPTURE( center, radius );
+        std::list<Creature *> expected;
+        for( const tripoint &p : here.points_in_radius( center, radius, 1 ) ) {
+            if( Creature *critter = g->critter_at( p ) ) {
+                expected.push_back( critter );
+            }
+        }
+        CHECK( here.get_creatures_in_radius( center, radius, 1 ) == expected );
+    }
+}
+
+TEST_CASE( "monsters_find_hostile_monsters_with_the_player_at_sight_range", "[creature_tracker]" )
+{
+    const time_point old_turn = calendar::turn;
+    calendar::turn = calendar::turn_zero + 12_hours;
+    clear_map();
+    clear_avatar();
+    map &here = get_map();
+    const tripoint pos( HALF_MAPSIZE_X, HALF_MAPSIZE_Y, 0 );
+    // Seen, but rated as far away as nothing at all.
+    const mtype &zombie_type = mtype_id( "mon_zombie" ).obj();
+    Character &player_character = get_player_character();
+    player_character.setpos( pos + point( std::max( zombie_type.vision_day,
+                                          zombie_type.vision_night ), 0 ) );
+    monster &zombie = spawn_test_monster( "mon_zombie", pos );
+    monster &dog = spawn_test_monster( "mon_dog", pos + point( 0, 3 ) );
+    g->reset_light_level();
+    here.update_visibility_cache( 0 );
+    here.invalidate_map_cache( 0 );
+    here.build_map_cache( 0 );
+    REQUIRE( zombie.sees( player_character ) );
+    REQUIRE( zombie.attitude_to( dog ) == Creature::Attitude::HOSTILE );
+
+    zombie.plan();
+    CHECK( zombie.move_target() == dog.pos() );
+    calendar::turn = old_turn;
+}
+
+TEST_CASE( "horde_planning_benchmark", "[.]" )
+{
+    for( const int count : {
+             100, 200, 400
+         } ) {
+        clear_map();
+        const std::vector<monster *> horde = spawn_random_monsters( count );
+        const auto start = std::chrono::steady_clock::now();
+        for( int i = 0; i < 10; ++i ) {
+            for( monster *critter : horde ) {
+                critter->plan();
+            }
+        }
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        printf( "%d monsters planned in %.3f ms per turn\n", count,
+                std::chrono::duration<double, std::milli>( elapsed ).count() / 10 );
+    }
+}
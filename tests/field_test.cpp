@@ -0,0 +1,107 @@
+#include "catch/catch.hpp"
+
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "calendar.h"
+#include "field.h"
+#include "field_type.h"
+#include "game_constants.h"
+#include "map.h"
+#include "map_helpers.h"
+#include "map_iterator.h"
+#include "mapbuffer.h"
+#include "point.h"
+#include "submap.h"
+#include "type_id.h"
+
+static std::set<field_type_id> field_types_of( const field &fld )
+{
+    std::set<field_type_id> ret;
+    for( const field::value_type &entry : fld ) {
+        CHECK( entry.first == entry.second.get_field_type() );
+        ret.insert( entry.first );
+    }
+    return ret;
+}
+
+TEST_CASE( "field_entries_stay_in_place", "[field]" )
+{
+    const std::vector<field_type_id> types = { fd_blood, fd_bile, fd_web, fd_slime, fd_acid, fd_smoke, fd_fire };
+    field fld;
+    std::vector<field_entry *> entries;
+    for( const field_type_id &type : types ) {
+        CHECK( fld.add_field( type, 1 ) );
+        entries.push_back( fld.find_field( type ) );
+    }
+    CHECK( fld.field_count() == types.size() );
+    CHECK_FALSE( fld.add_field( fd_blood, 1 ) );
+    CHECK( fld.field_count() == types.size() );
+    for( size_t i = 0; i < types.size(); ++i ) {
+        CHECK( fld.find_field( types[i] ) == entries[i] );
+    }
+
+    // Removing while iterating, and adding again.
+    for( auto it = fld.begin(); it != fld.end(); ) {
+        if( it->first == fd_web || it->first == fd_fire ) {
+            fld.remove_field( it++ );
+        } else {
+            ++it;
+        }
+    }
+    CHECK( fld.field_count() == types.size() - 2 );
+    CHECK( fld.find_field( fd_web ) == nullptr );
+    CHECK( fld.find_field( fd_acid ) == entries[4] );
+    CHECK( fld.add_field( fd_fire, 2 ) );
+    CHECK( fld.find_field( fd_acid ) == entries[4] );
+    CHECK( fld.find_field( fd_fire )->get_field_intensity() == 2 );
+
+    const field copy = fld;
+    CHECK( field_types_of( copy ) == field_types_of( fld ) );
+    CHECK( copy.displayed_field_type() == fld.displayed_field_type() );
+    field moved = std::move( fld );
+    CHECK( field_types_of( moved ) == field_types_of( copy ) );
+    // NOLINTNEXTLINE(bugprone-use-after-move)
+    CHECK( fld.field_count() == 0 );
+    CHECK( fld.begin() == fld.end() );
+
+    for( const field_type_id &type : types ) {
+        moved.remove_field( type );
+    }
+    CHECK( moved.field_count() == 0 );
+    CHECK( moved.displayed_field_type() == fd_null );
+}
+
+TEST_CASE( "field_processing_only_visits_tiles_with_fields", "[field]" )
+{
+    clear_map();
+    map &here = get_map();
+    const tripoint origin( 2 * SEEX, 2 * SEEY, 0 );
+    const std::vector<tripoint> spots = { origin, origin + point( 5, 3 ), origin + point( SEEX - 1, SEEY - 1 ) };
+    for( const tripoint &p : spots ) {
+        here.add_field( p, fd_smoke, 3 );
+    }
+    submap *sm = MAPBUFFER.lookup_submap( here.get_abs_sub() + tripoint( 2, 2, 0 ) );
+    REQUIRE( sm != nullptr );
+    for( const tripoint &p : spots ) {
+        CHECK( sm->has_field_tile( p.xy() - origin.xy() ) );
+    }
+
+    // The smoke spreads and then dies out, the tiles have to be unmarked again.
+    bool gone = false;
+    for( int turn = 0; turn < 1000 && !gone; ++turn ) {
+        here.process_fields();
+        calendar::turn += 1_turns;
+        gone = true;
+        for( const tripoint &p : here.points_in_radius( origin, 2 * SEEX ) ) {
+            gone = gone && here.get_field( p, fd_smoke ) == nullptr;
+        }
+    }
+    REQUIRE( gone );
+    for( int x = 0; x < SEEX; ++x ) {
+        for( int y = 0; y < SEEY; ++y ) {
+            CHECK_FALSE( sm->has_field_tile( { x, y } ) );
+        }
+    }
+}
@@ -6,6 +6,7 @@
 
 #include "calendar.h"
 #include "enums.h"
+#include "flag.h"
 #include "item.h"
 #include "item_factory.h"
 #include "itype.h"
@@ -54,6 +55,41 @@ TEST_CASE( "gun_layer", "[item]" )
     CHECK( gun.get_layer() == layer_level::BELTED );
 }
 
+TEST_CASE( "item_flags_are_found_by_interned_id", "[item]" )
+{
+    const flag_id use_ups( "USE_UPS" );
+    CHECK( flag_id( "USE_UPS" ) == use_ups );
+    CHECK( use_ups.str() == "USE_UPS" );
+    CHECK( flag_id( "SOME_UNDEFINED_TEST_FLAG" ) != use_ups );
+    CHECK( flag_id().str().empty() );
+
+    // Flags of the type.
+    const item mod( "battery_ups" );
+    for( const std::string &name : mod.type->item_tags ) {
+        CHECK( mod.has_flag( name ) );
+        CHECK( mod.has_flag( flag_id( name ) ) );
+    }
+
+    // Flags of the item itself.
+    item hotplate( "hotplate" );
+    CHECK_FALSE( hotplate.has_flag( "SOME_UNDEFINED_TEST_FLAG" ) );
+    hotplate.set_flag( "SOME_UNDEFINED_TEST_FLAG" );
+    CHECK( hotplate.has_flag( flag_id( "SOME_UNDEFINED_TEST_FLAG" ) ) );
+    item copy = hotplate;
+    CHECK( copy.item_tags == hotplate.item_tags );
+    copy.unset_flag( flag_id( "SOME_UNDEFINED_TEST_FLAG" ) );
+    CHECK_FALSE( copy.has_flag( "SOME_UNDEFINED_TEST_FLAG" ) );
+    CHECK( hotplate.has_flag( "SOME_UNDEFINED_TEST_FLAG" ) );
+    CHECK( copy.item_tags != hotplate.item_tags );
+
+    // Flags inherited from a tool mod.
+    REQUIRE( use_ups.obj().inherit() );
+    CHECK_FALSE( hotplate.has_flag( use_ups ) );
+    hotplate.put_in( mod, item_pocket::pocket_type::MOD );
+    CHECK( hotplate.has_flag( use_ups ) );
+    CHECK( hotplate.has_flag( "USE_UPS" ) );
+}
+
 TEST_CASE( "stacking_cash_cards", "[item]" )
 {
     // Differently-charged cash cards should stack if neither is zero.
@@ -64,6 +100,32 @@ TEST_CASE( "stacking_cash_cards", "[item]" )
     CHECK( cash1.stacks_with( cash2 ) );
 }
 
+TEST_CASE( "item_specific_state_is_shared_until_changed", "[item]" )
+{
+    item plain( "rock" );
+    CHECK( plain.extra_data_use_count() == 0 );
+    CHECK_FALSE( plain.has_var( "name" ) );
+    plain.erase_var( "name" );
+    CHECK( plain.extra_data_use_count() == 0 );
+
+    item named( "rock" );
+    named.set_var( "name", "pet rock" );
+    item copy = named;
+    CHECK( named.extra_data_use_count() == 2 );
+    CHECK( copy.stacks_with( named ) );
+
+    copy.set_var( "name", "other rock" );
+    CHECK( named.extra_data_use_count() == 1 );
+    CHECK( copy.extra_data_use_count() == 1 );
+    CHECK( named.get_var( "name" ) == "pet rock" );
+    CHECK( copy.get_var( "name" ) == "other rock" );
+    CHECK_FALSE( copy.stacks_with( named ) );
+
+    copy.add_technique( matec_id( "WBLOCK_1" ) );
+    CHECK( copy.has_technique( matec_id( "WBLOCK_1" ) ) );
+    CHECK_FALSE( named.has_technique( matec_id( "WBLOCK_1" ) ) );
+}
+
 // second minute hour day week season year
 
 TEST_CASE( "stacking_over_time", "[item]" )
@@ -0,0 +1,61 @@
+#include "catch/catch.hpp"
+
+#include "los_cache.h"
+#include "point.h"
+
+TEST_CASE( "los_cache_is_symmetric_and_invalidated_per_level", "[map]" )
+{
+    los_cache cache;
+    const tripoint a( 10, 20, 0 );
+    const tripoint b( 30, 5, 0 );
+    const tripoint c( 10, 20, 1 );
+    const tripoint d( 30, 5, 1 );
+    const tripoint up( 31, 5, 1 );
+
+    CHECK( cache.get( a, b ) == -1 );
+    cache.set( a, b, true );
+    cache.set( c, d, false );
+    cache.set( a, up, true );
+    CHECK( cache.get( a, b ) == 1 );
+    CHECK( cache.get( b, a ) == 1 );
+    CHECK( cache.get( d, c ) == 0 );
+    CHECK( cache.get( up, a ) == 1 );
+
+    // Only the changed level and the lines between levels are forgotten.
+    cache.invalidate( 0 );
+    CHECK( cache.get( a, b ) == -1 );
+    CHECK( cache.get( c, d ) == 0 );
+    CHECK( cache.get( a, up ) == -1 );
+
+    cache.set( b, a, false );
+    CHECK( cache.get( a, b ) == 0 );
+    cache.invalidate_all();
+    CHECK( cache.get( a, b ) == -1 );
+    CHECK( cache.get( c, d ) == -1 );
+
+    const los_cache::statistics &stats = cache.stats();
+    CHECK( stats.lookups == 11 );
+    CHECK( stats.hits == 6 );
+    CHECK( stats.stores == 4 );
+}
+
+TEST_CASE( "los_cache_keeps_many_lines", "[map]" )
+{
+    los_cache cache;
+    for( int x = 0; x < 132; ++x ) {
+        for( int y = 0; y < 132; ++y ) {
+            cache.set( tripoint( 60, 60, 0 ), tripoint( x, y, 0 ), ( x + y ) % 2 == 0 );
+        }
+    }
+    int known = 0;
+    for( int x = 0; x < 132; ++x ) {
+        for( int y = 0; y < 132; ++y ) {
+            const int cached = cache.get( tripoint( x, y, 0 ), tripoint( 60, 60, 0 ) );
+            if( cached >= 0 ) {
+                ++known;
+                CHECK( cached == ( ( x + y ) % 2 == 0 ? 1 : 0 ) );
+            }
+        }
+    }
+    CHECK( known == 132 * 132 );
+}
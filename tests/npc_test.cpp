@@ -1,5 +1,7 @@
 #include "catch/catch.hpp"
 
+#include <chrono>
+#include <cstdio>
 #include <memory>
 #include <set>
 #include <sstream>
@@ -13,10 +15,12 @@
 #include "field.h"
 #include "field_type.h"
 #include "game.h"
+#include "game_constants.h"
 #include "line.h"
 #include "map.h"
 #include "map_helpers.h"
 #include "memory_fast.h"
+#include "monster.h"
 #include "npc.h"
 #include "npc_class.h"
 #include "optional.h"
@@ -448,3 +452,117 @@ TEST_CASE( "npc_can_target_player" )
     REQUIRE( hostile.current_target() != nullptr );
     CHECK( hostile.current_target() == static_cast<Creature *>( &player_character ) );
 }
+
+TEST_CASE( "npc_danger_assessment_follows_monsters_that_move" )
+{
+    const time_point old_turn = calendar::turn;
+    calendar::turn = calendar::turn_zero + 12_hours;
+    clear_map();
+    clear_creatures();
+    clear_npcs();
+    clear_avatar();
+    g->faction_manager_ptr->create_if_needed();
+
+    map &here = get_map();
+    const tripoint origin( HALF_MAPSIZE_X, HALF_MAPSIZE_Y, 0 );
+    g->place_player( origin );
+    npc &guy = spawn_npc( origin.xy() + point( 10, 0 ), "thug" );
+    guy.set_attitude( NPCATT_FOLLOW );
+    for( int y = -2; y <= 2; ++y ) {
+        here.ter_set( guy.pos() + point( 2, y ), ter_id( "t_wall" ) );
+    }
+    // Daylight, whatever the tests before left behind.
+    g->reset_light_level();
+    here.update_visibility_cache( origin.z );
+    here.invalidate_map_cache( origin.z );
+    here.build_map_cache( origin.z );
+
+    monster &zombie = spawn_test_monster( "mon_zombie", guy.pos() + point( 4, 0 ) );
+    guy.regen_ai_cache();
+    CHECK( guy.current_target() == nullptr );
+
+    // Looking again without anything moving gives the same answer
+    guy.regen_ai_cache();
+    CHECK( guy.current_target() == nullptr );
+
+    zombie.setpos( guy.pos() + point( 0, 4 ) );
+    guy.regen_ai_cache();
+    CHECK( guy.current_target() == static_cast<Creature *>( &zombie ) );
+
+    zombie.die( nullptr );
+    g->cleanup_dead();
+    guy.regen_ai_cache();
+    CHECK( guy.current_target() == nullptr );
+    calendar::turn = old_turn;
+}
+
+TEST_CASE( "npc_finds_a_way_to_its_next_overmap_tile" )
+{
+    clear_map();
+    clear_avatar();
+    map &here = get_map();
+    g->place_player( tripoint( HALF_MAPSIZE_X, 120, 0 ) );
+    // The only ways through are too far off the straight line for plain A* to find them.
+    for( int y = 0; y < MAPSIZE_Y; ++y ) {
+        if( y != 10 ) {
+            here.ter_set( tripoint( 40, y, 0 ), ter_id( "t_wall" ) );
+        }
+        if( y != 120 ) {
+            here.ter_set( tripoint( 70, y, 0 ), ter_id( "t_wall" ) );
+        }
+    }
+    npc &guy = spawn_npc( point( 10, 60 ), "test_talker" );
+    const tripoint_abs_omt next_omt = project_to<coords::omt>(
+                                          tripoint_abs_ms( here.getabs( tripoint( 80, 60, 0 ) ) ) );
+    REQUIRE( next_omt != guy.global_omt_location() );
+    guy.goal = next_omt;
+    guy.omt_path = { next_omt };
+    REQUIRE( guy.path.empty() );
+
+    guy.go_to_omt_destination();
+    REQUIRE_FALSE( guy.path.empty() );
+    CHECK( project_to<coords::omt>( tripoint_abs_ms( here.getabs( guy.path.back() ) ) ) == next_omt );
+    clear_map();
+}
+
+TEST_CASE( "npc_follower_turn_benchmark", "[.]" )
+{
+    calendar::turn = calendar::turn_zero + 12_hours;
+    clear_map();
+    clear_creatures();
+    clear_npcs();
+    g->faction_manager_ptr->create_if_needed();
+
+    const tripoint origin = get_player_character().pos();
+    std::vector<npc *> followers;
+    for( int i = 0; i < 24; ++i ) {
+        npc &guy = spawn_npc( origin.xy() + point( 3 + i % 6 * 2, -6 + i / 6 * 4 ), "thug" );
+        guy.set_attitude( NPCATT_FOLLOW );
+        followers.push_back( &guy );
+    }
+    for( int i = 0; i < 40; ++i ) {
+        spawn_test_monster( "mon_zombie", origin + point( -30 + i % 10 * 6, 25 + i / 10 * 4 ) );
+    }
+
+    const int turns = 100;
+    const auto run = [&]( const bool step ) {
+        const auto start = std::chrono::high_resolution_clock::now();
+        for( int t = 0; t < turns; ++t ) {
+            calendar::turn += 1_turns;
+            for( npc *guy : followers ) {
+                if( step ) {
+                    guy->setpos( guy->pos() + ( t % 2 ? point_north : point_south ) );
+                }
+                guy->regen_ai_cache();
+            }
+        }
+        return std::chrono::duration_cast<std::chrono::microseconds>(
+                   std::chrono::high_resolution_clock::now() - start ).count();
+    };
+    const long long moving = run( true );
+    const long long standing = run( false );
+    printf( "%zu followers, %d turns: %lld us per follower turn when they move, "
+            "%lld us when they stand still.\n", followers.size(), turns,
+            moving / turns / static_cast<long long>( followers.size() ),
+            standing / turns / static_cast<long long>( followers.size() ) );
+}
@@ -0,0 +1,181 @@
+#include "catch/catch.hpp"
+
+#include <algorithm>
+#include <set>
+#include <vector>
+
+#include "game_constants.h"
+#include "line.h"
+#include "map.h"
+#include "map_helpers.h"
+#include "npc.h"
+#include "pathfinding.h"
+#include "player_helpers.h"
+#include "point.h"
+#include "type_id.h"
+
+static int route_cost( const tripoint &from, const std::vector<tripoint> &route )
+{
+    int cost = 0;
+    tripoint prev = from;
+    for( const tripoint &p : route ) {
+        cost += ( prev.x != p.x && prev.y != p.y ) ? 3 : 2;
+        prev = p;
+    }
+    return cost;
+}
+
+TEST_CASE( "flow_field_routes_match_astar", "[pathfinding]" )
+{
+    clear_map();
+    map &here = get_map();
+    const tripoint target( 60, 60, 0 );
+    // A wall with a single gap between the sources and the target.
+    for( int y = 45; y <= 75; ++y ) {
+        if( y != 70 ) {
+            here.ter_set( tripoint( 55, y, 0 ), ter_id( "t_wall" ) );
+        }
+    }
+    const pathfinding_settings settings( 0, 30, 1000, 0, false, false, false, false, false );
+    // Closing a tile nowhere near the route forces a plain A* search.
+    const std::set<tripoint> astar_only = { tripoint( 10, 10, 0 ) };
+
+    const std::vector<tripoint> sources = {
+        { 45, 50, 0 }, { 45, 60, 0 }, { 48, 72, 0 }, { 50, 65, 0 }, { 40, 58, 0 }
+    };
+    for( const tripoint &source : sources ) {
+        // The first few requests build the flow field, later ones follow it.
+        const std::vector<tripoint> route = here.route( source, target, settings );
+        const std::vector<tripoint> astar = here.route( source, target, settings, astar_only );
+        CAPTURE( source );
+        REQUIRE_FALSE( astar.empty() );
+        REQUIRE_FALSE( route.empty() );
+        CHECK( route.back() == target );
+        CHECK( route_cost( source, route ) == route_cost( source, astar ) );
+        for( const tripoint &p : route ) {
+            CHECK( here.passable( p ) );
+        }
+        // Asking again in the same turn gives the remembered route.
+        CHECK( here.route( source, target, settings ) == route );
+    }
+
+    SECTION( "changes to the map are seen" ) {
+        // Closing the gap leaves only the way around either end of the wall.
+        here.ter_set( tripoint( 55, 70, 0 ), ter_id( "t_wall" ) );
+        const std::vector<tripoint> detour = here.route( sources[1], target, settings );
+        const std::vector<tripoint> astar = here.route( sources[1], target, settings, astar_only );
+        REQUIRE_FALSE( detour.empty() );
+        CHECK( std::find( detour.begin(), detour.end(), tripoint( 55, 70, 0 ) ) == detour.end() );
+        CHECK( route_cost( sources[1], detour ) == route_cost( sources[1], astar ) );
+    }
+}
+
+TEST_CASE( "hierarchical_routes_cross_the_map", "[pathfinding]" )
+{
+    clear_map();
+    map &here = get_map();
+    // Walls across the whole map with one gap each, so the route has to zig-zag.  The gaps are
+    // close enough to the straight line for plain A* to find the best route too.
+    const tripoint first_gap( 40, 50, 0 );
+    const tripoint second_gap( 90, 72, 0 );
+    for( int y = 0; y < MAPSIZE_Y; ++y ) {
+        if( y != first_gap.y ) {
+            here.ter_set( tripoint( first_gap.x, y, 0 ), ter_id( "t_wall" ) );
+        }
+        if( y != second_gap.y ) {
+            here.ter_set( tripoint( second_gap.x, y, 0 ), ter_id( "t_wall" ) );
+        }
+    }
+    pathfinding_settings settings( 0, 200, 2000, 0, false, false, false, false, false );
+    settings.allow_approximate = true;
+    const std::set<tripoint> astar_only = { tripoint( 10, 10, 0 ) };
+    const tripoint source( 20, 60, 0 );
+    const tripoint target( 110, 60, 0 );
+    REQUIRE( rl_dist( source, target ) >= route_hierarchy::min_distance );
+
+    const auto check_route = [&]( const std::vector<tripoint> &route ) {
+        REQUIRE_FALSE( route.empty() );
+        CHECK( route.back() == target );
+        tripoint prev = source;
+        for( const tripoint &p : route ) {
+            CHECK( square_dist( prev, p ) == 1 );
+            CHECK( here.passable( p ) );
+            prev = p;
+        }
+        // The abstract graph only crosses borders at a few entrances, so its routes may be
+        // somewhat longer than the best one.
+        const std::vector<tripoint> astar = here.route( source, target, settings, astar_only );
+        REQUIRE_FALSE( astar.empty() );
+        CHECK( route_cost( source, route ) >= route_cost( source, astar ) );
+        CHECK( route_cost( source, route ) <= route_cost( source, astar ) * 3 / 2 );
+    };
+    const std::vector<tripoint> route = here.route( source, target, settings );
+    check_route( route );
+    CHECK( std::find( route.begin(), route.end(), first_gap ) != route.end() );
+    CHECK( std::find( route.begin(), route.end(), second_gap ) != route.end() );
+
+    SECTION( "changed submaps are rebuilt" ) {
+        const tripoint new_gap( first_gap.x, 74, 0 );
+        here.ter_set( first_gap, ter_id( "t_wall" ) );
+        here.ter_set( new_gap, ter_id( "t_floor" ) );
+        const std::vector<tripoint> detour = here.route( source, target, settings );
+        check_route( detour );
+        CHECK( std::find( detour.begin(), detour.end(), new_gap ) != detour.end() );
+    }
+
+    SECTION( "exact routes are the default" ) {
+        settings.allow_approximate = false;
+        CHECK( route_cost( source, here.route( source, target, settings ) ) ==
+               route_cost( source, here.route( source, target, settings, astar_only ) ) );
+    }
+}
+
+TEST_CASE( "hierarchical_routes_avoid_what_npcs_avoid", "[pathfinding]" )
+{
+    clear_map();
+    map &here = get_map();
+    // The gaps are too far off the straight line for plain A* to find them.
+    const tripoint first_gap( 40, 10, 0 );
+    const tripoint second_gap( 90, 120, 0 );
+    for( int y = 0; y < MAPSIZE_Y; ++y ) {
+        if( y != first_gap.y ) {
+            here.ter_set( tripoint( first_gap.x, y, 0 ), ter_id( "t_wall" ) );
+        }
+        if( y != second_gap.y ) {
+            here.ter_set( tripoint( second_gap.x, y, 0 ), ter_id( "t_wall" ) );
+        }
+    }
+    get_player_location().setpos( tripoint( 100, 20, 0 ) );
+    npc &guy = spawn_npc( point( 20, 60 ), "test_talker" );
+    const tripoint target( 110, 60, 0 );
+    // Right in front of and behind the first gap, and on the way to the second one.
+    const std::vector<tripoint> in_the_way = {
+        first_gap + point_west, first_gap + point_east, tripoint( 60, 60, 0 ), second_gap + point_west
+    };
+    for( const tripoint &p : in_the_way ) {
+        spawn_test_monster( "mon_zombie", p );
+    }
+
+    pathfinding_settings settings = guy.get_pathfinding_settings();
+    const std::set<tripoint> avoid = guy.get_path_avoid();
+    for( const tripoint &p : in_the_way ) {
+        REQUIRE( avoid.count( p ) );
+    }
+    REQUIRE( here.route( guy.pos(), target, settings, avoid ).empty() );
+
+    settings.allow_approximate = true;
+    const std::vector<tripoint> route = here.route( guy.pos(), target, settings, avoid );
+    REQUIRE_FALSE( route.empty() );
+    CHECK( route.back() == target );
+    CHECK( std::find( route.begin(), route.end(), first_gap ) != route.end() );
+    CHECK( std::find( route.begin(), route.end(), second_gap ) != route.end() );
+    tripoint prev = guy.pos();
+    for( const tripoint &p : route ) {
+        CAPTURE( p );
+        CHECK( square_dist( prev, p ) == 1 );
+        CHECK( here.passable( p ) );
+        CHECK_FALSE( avoid.count( p ) );
+        prev = p;
+    }
+    clear_map();
+}
@@ -0,0 +1,88 @@
+#include "catch/catch.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+#include "colony.h"
+#include "game_constants.h"
+#include "item.h"
+#include "item_stack.h"
+#include "pool_allocator.h"
+
+TEST_CASE( "pooled_colony_reuses_freed_blocks", "[colony]" )
+{
+    using pooled_colony = cata::colony<int, cata::pool_allocator<int>>;
+    cata::memory_pool::release();
+    const size_t in_use = cata::memory_pool::stats().bytes_in_use;
+    {
+        pooled_colony numbers;
+        for( int i = 0; i < 1000; ++i ) {
+            numbers.insert( i );
+        }
+        CHECK( cata::memory_pool::stats().bytes_in_use > in_use );
+        for( pooled_colony::iterator it = numbers.begin(); it != numbers.end(); ) {
+            it = *it % 3 == 0 ? numbers.erase( it ) : std::next( it );
+        }
+        int sum = 0;
+        for( const int i : numbers ) {
+            sum += i;
+        }
+        CHECK( numbers.size() == 666 );
+        CHECK( sum == 999 * 1000 / 2 - 3 * 333 * 334 / 2 );
+    }
+    CHECK( cata::memory_pool::stats().bytes_in_use == in_use );
+
+    // The same sizes again come from the pool.
+    cata::memory_pool::reset_counters();
+    {
+        pooled_colony numbers;
+        for( int i = 0; i < 1000; ++i ) {
+            numbers.insert( i );
+        }
+        const cata::memory_pool::statistics &stats = cata::memory_pool::stats();
+        CHECK( stats.allocations > 0 );
+        CHECK( stats.reused == stats.allocations );
+    }
+
+    cata::memory_pool::release();
+    CHECK( cata::memory_pool::stats().bytes_pooled == 0 );
+}
+
+template<typename Colony>
+static std::chrono::high_resolution_clock::duration fill_submaps( int submaps )
+{
+    const item rock( "rock" );
+    const item nail( "nail" );
+    const auto start = std::chrono::high_resolution_clock::now();
+    for( int i = 0; i < submaps; ++i ) {
+        // Like a submap with a few items on every other tile, loaded and unloaded again.
+        std::unique_ptr<Colony[]> tiles( new Colony[SEEX * SEEY] );
+        for( int t = 0; t < SEEX * SEEY; t += 2 ) {
+            for( int n = 0; n < 1 + t % 5; ++n ) {
+                tiles[t].insert( n % 2 ? rock : nail );
+            }
+        }
+    }
+    return std::chrono::high_resolution_clock::now() - start;
+}
+
+TEST_CASE( "pooled_item_colony_benchmark", "[.]" )
+{
+    const int submaps = 2000;
+    fill_submaps<item_colony>( 10 );
+    cata::memory_pool::reset_counters();
+    const auto plain = fill_submaps<cata::colony<item>>( submaps );
+    const auto pooled = fill_submaps<item_colony>( submaps );
+
+    const auto ms = []( const std::chrono::high_resolution_clock::duration & d ) {
+        return static_cast<long long>( std::chrono::duration_cast<std::chrono::milliseconds>( d ).count() );
+    };
+    const cata::memory_pool::statistics &stats = cata::memory_pool::stats();
+    printf( "Filling %d submaps took %lld ms with the heap, %lld ms with the pool.\n"
+            "%llu blocks allocated, %llu of them reused.\n", submaps, ms( plain ), ms( pooled ),
+            static_cast<unsigned long long>( stats.allocations ),
+            static_cast<unsigned long long>( stats.reused ) );
+    CHECK( stats.reused > stats.allocations / 2 );
+}
@@ -4,6 +4,7 @@
 #include <memory>
 
 #include "calendar.h"
+#include "game_constants.h"
 #include "item.h"
 #include "point.h"
 #include "weather.h"
@@ -97,3 +98,65 @@ TEST_CASE( "Items rot away" )
         INFO( "Rot: " << to_turns<int>( test_item.get_rot() ) );
     }
 }
+
+// Rots the item one hour at a time, the way process_temperature_rot used to catch up.
+static time_duration rot_hour_by_hour( item it, const temperature_history &history,
+                                       const size_t from, const size_t to )
+{
+    for( size_t i = from; i < to; ++i ) {
+        it.calc_rot( history.temperatures[i], 1.0f, 1_hours );
+    }
+    return it.get_rot();
+}
+
+TEST_CASE( "Rot of items left outside of the reality bubble" )
+{
+    const time_point old_turn = calendar::turn;
+    if( calendar::turn <= calendar::start_of_cataclysm ) {
+        calendar::turn = calendar::start_of_cataclysm + 1_minutes;
+    }
+    set_map_temperature( 65 );
+
+    SECTION( "Rot in a root cellar" ) {
+        // The hours more than 2 days ago are summed up in one go, that has to come to what
+        // rotting hour by hour does.
+        item test_item( "cheese_hard" );
+        test_item.process( nullptr, tripoint_zero, 1, temperature_flag::ROOT_CELLAR );
+        const time_point start = calendar::turn;
+
+        calendar::turn += 10_days + 17_minutes;
+        test_item.process( nullptr, tripoint_zero, 1, temperature_flag::ROOT_CELLAR );
+
+        const double expected = ( calendar::turn - start ) / 1_hours *
+                                get_hourly_rotpoints_at_temp( AVERAGE_ANNUAL_TEMPERATURE );
+        CHECK( to_turns<int>( test_item.get_rot() ) == Approx( expected ).epsilon( 0.001 ) );
+    }
+
+    // Warm enough for food to rot away, and warmer than a fridge.
+    const time_point from = calendar::turn - ( calendar::turn - calendar::turn_zero ) % 1_hours;
+    const temperature_history &history = get_weather().get_temperature_history( tripoint_zero, 0,
+                                         temperature_flag::HEATER, from, from + 10_days );
+    const size_t hours = history.index( from + 10_days );
+
+    SECTION( "Food stops rotting after the hour it passes twice its shelf life" ) {
+        item test_item( "meat_cooked" );
+        const time_duration hourly = rot_hour_by_hour( test_item, history, 0, hours );
+        REQUIRE( test_item.get_relative_rot() == 0 );
+        test_item.calc_rot( history, 0, hours, 1.0f );
+        CHECK( test_item.get_relative_rot() > 2.0 );
+        CHECK( test_item.get_rot() < test_item.get_shelf_life() * 3 );
+        CHECK( test_item.get_rot() == hourly );
+    }
+
+    SECTION( "Cold food rots at the fridge temperature" ) {
+        item test_item( "cheese_hard" );
+        test_item.item_tags.insert( "COLD" );
+        const time_duration hourly = rot_hour_by_hour( test_item, history, 0, hours );
+        test_item.calc_rot( history, 0, hours, 1.0f );
+        CHECK( test_item.get_rot() == hourly );
+        CHECK( test_item.get_rot() == hours * get_hourly_rotpoints_at_temp( temperatures::fridge ) *
+               1_turns );
+    }
+
+    calendar::turn = old_turn;
+}
@@ -0,0 +1,203 @@
+#include "catch/catch.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+#include "game.h"
+#include "game_constants.h"
+#include "map.h"
+#include "map_helpers.h"
+#include "mapdata.h"
+#include "point.h"
+#include "rng.h"
+#include "scent_map.h"
+#include "type_id.h"
+#include "vehicle.h"
+
+namespace
+{
+
+class test_scent_map : public scent_map
+{
+    public:
+        explicit test_scent_map( const game &g ) : scent_map( g ) {
+            // The game's scent map is reset when a game starts, these would start out undefined.
+            reset();
+        }
+
+        const scent_array<int> &values() const {
+            return grscent;
+        }
+
+        // The diffusion the way it was done tile by tile, to compare against.
+        void reference_update( const tripoint &center, map &m ) {
+            scent_array<int> sum_3_scent_y;
+            scent_array<int> squares_used_y;
+            scent_array<bool> blocks_scent;
+            scent_array<bool> reduces_scent;
+
+            const int radius = 40;
+            const int scentmap_minx = center.x - radius;
+            const int scentmap_maxx = center.x + radius;
+            const int scentmap_miny = center.y - radius;
+            const int scentmap_maxy = center.y + radius;
+            const int diffusivity = 100;
+
+            m.scent_blockers( blocks_scent, reduces_scent, point( scentmap_minx - 1, scentmap_miny - 1 ),
+                              point( scentmap_maxx + 1, scentmap_maxy + 1 ) );
+            for( const point &p : m.vehicle_scent_reducers( point( scentmap_minx - 1, scentmap_miny - 1 ),
+                    point( scentmap_maxx + 1, scentmap_maxy + 1 ) ) ) {
+                reduces_scent[p.x][p.y] = true;
+            }
+            for( int x = scentmap_minx - 1; x <= scentmap_maxx + 1; ++x ) {
+                for( int y = scentmap_miny; y <= scentmap_maxy; ++y ) {
+                    sum_3_scent_y[y][x] = 0;
+                    squares_used_y[y][x] = 0;
+                    for( int i = y - 1; i <= y + 1; ++i ) {
+                        if( !blocks_scent[x][i] ) {
+                            if( reduces_scent[x][i] ) {
+                                sum_3_scent_y[y][x] += 2 * grscent[x][i];
+                                squares_used_y[y][x] += 2;
+                            } else {
+                                sum_3_scent_y[y][x] += 10 * grscent[x][i];
+                                squares_used_y[y][x] += 10;
+                            }
+                        }
+                    }
+                }
+            }
+            for( int x = scentmap_minx; x <= scentmap_maxx; ++x ) {
+                for( int y = scentmap_miny; y <= scentmap_maxy; ++y ) {
+                    int &scent_here = grscent[x][y];
+                    if( !blocks_scent[x][y] ) {
+                        const int squares_used = squares_used_y[y][x - 1]
+                                                 + squares_used_y[y][x]
+                                                 + squares_used_y[y][x + 1];
+                        const int this_diffusivity = reduces_scent[x][y] ? diffusivity / 5 : diffusivity;
+                        int temp_scent = scent_here * ( 10 * 1000 - squares_used * this_diffusivity );
+                        temp_scent -= scent_here * this_diffusivity * ( 90 - squares_used ) / 5;
+                        scent_here =
+                            ( temp_scent
+                              + this_diffusivity * ( sum_3_scent_y[y][x - 1]
+                                                     + sum_3_scent_y[y][x]
+                                                     + sum_3_scent_y[y][x + 1] )
+                            ) / ( 1000 * 10 );
+                    } else {
+                        scent_here = 0;
+                    }
+                }
+            }
+        }
+
+        void reference_shift( const point &sm_shift ) {
+            scent_array<int> new_scent;
+            for( size_t x = 0; x < MAPSIZE_X; ++x ) {
+                for( size_t y = 0; y < MAPSIZE_Y; ++y ) {
+                    const point p = point( x, y ) + sm_shift;
+                    new_scent[x][y] = inbounds( p ) ? grscent[ p.x ][ p.y ] : 0;
+                }
+            }
+            grscent = new_scent;
+        }
+};
+
+} // namespace
+
+static void build_scent_test_map()
+{
+    clear_map();
+    map &here = get_map();
+    const ter_id wall( "t_wall" );
+    const furn_id tank( "f_gas_tank" );
+    REQUIRE( wall->has_flag( TFLAG_NO_SCENT ) );
+    REQUIRE( tank->has_flag( TFLAG_REDUCE_SCENT ) );
+    for( int i = 0; i < 1000; ++i ) {
+        const tripoint p( rng( 0, MAPSIZE_X - 1 ), rng( 0, MAPSIZE_Y - 1 ), 0 );
+        if( one_in( 3 ) ) {
+            here.furn_set( p, tank );
+        } else {
+            here.ter_set( p, wall );
+        }
+    }
+    const tripoint center( HALF_MAPSIZE_X, HALF_MAPSIZE_Y, 0 );
+    REQUIRE( here.add_vehicle( vproto_id( "car" ), center + point( 10, 5 ), 0, 0, 0 ) != nullptr );
+    REQUIRE_FALSE( here.vehicle_scent_reducers( point_zero,
+                   point( MAPSIZE_X - 1, MAPSIZE_Y - 1 ) ).empty() );
+}
+
+static void randomize( test_scent_map &fast, test_scent_map &slow )
+{
+    for( int i = 0; i < 200; ++i ) {
+        const tripoint p( rng( 0, MAPSIZE_X - 1 ), rng( 0, MAPSIZE_Y - 1 ), 0 );
+        const int value = rng( 0, 1000 );
+        fast.set_unsafe( p, value );
+        slow.set_unsafe( p, value );
+    }
+}
+
+TEST_CASE( "scent_diffusion_matches_tile_by_tile_diffusion", "[scent]" )
+{
+    build_scent_test_map();
+    map &here = get_map();
+    test_scent_map fast( *g );
+    test_scent_map slow( *g );
+    randomize( fast, slow );
+
+    tripoint center( HALF_MAPSIZE_X, HALF_MAPSIZE_Y, 0 );
+    for( int turn = 0; turn < 60; ++turn ) {
+        CAPTURE( turn );
+        if( turn == 20 ) {
+            // The cached blockers have to notice the change.
+            here.ter_set( center + point( 3, 3 ), ter_id( "t_wall" ) );
+            here.ter_set( center, ter_id( "t_dirt" ) );
+            randomize( fast, slow );
+        } else if( turn == 30 ) {
+            center += point( -7, 4 );
+        } else if( turn == 40 ) {
+            for( const point &sm_shift : {
+                     point( SEEX, 0 ), point( -2 * SEEX, SEEY ), point( 0, -SEEY ), point( MAPSIZE_X, 0 )
+                 } ) {
+                fast.shift( sm_shift );
+                slow.reference_shift( sm_shift );
+                REQUIRE( fast.values() == slow.values() );
+                randomize( fast, slow );
+            }
+        }
+        fast.update( center, here );
+        slow.reference_update( center, here );
+        REQUIRE( fast.values() == slow.values() );
+        fast.decay();
+        slow.decay();
+    }
+}
+
+TEST_CASE( "scent_diffusion_benchmark", "[.]" )
+{
+    build_scent_test_map();
+    map &here = get_map();
+    test_scent_map fast( *g );
+    test_scent_map slow( *g );
+    randomize( fast, slow );
+    const tripoint center( HALF_MAPSIZE_X, HALF_MAPSIZE_Y, 0 );
+    const int iterations = 2000;
+
+    const auto start = std::chrono::high_resolution_clock::now();
+    for( int i = 0; i < iterations; ++i ) {
+        slow.reference_update( center, here );
+    }
+    const auto middle = std::chrono::high_resolution_clock::now();
+    for( int i = 0; i < iterations; ++i ) {
+        fast.update( center, here );
+    }
+    const auto end = std::chrono::high_resolution_clock::now();
+
+    const auto ms = []( const std::chrono::high_resolution_clock::duration & d ) {
+        return static_cast<long long>( std::chrono::duration_cast<std::chrono::milliseconds>( d ).count() );
+    };
+    printf( "%d scent updates took %lld ms tile by tile, %lld ms with cached blockers.\n",
+            iterations, ms( middle - start ), ms( end - middle ) );
+    CHECK( fast.values() == slow.values() );
+}
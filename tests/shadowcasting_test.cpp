@@ -1,5 +1,6 @@
 #include "catch/catch.hpp"
 
+#include <algorithm>
 #include <array>
 #include <chrono>
 #include <cstdio>
@@ -601,6 +602,70 @@ TEST_CASE( "shadowcasting_vision_along_a_wall", "[shadowcasting]" )
     run_spot_check( test_case, expected_results );
 }
 
+static void shadowcasting_intensity_matches_rl_dist()
+{
+    // Through open air the light reaching a cell only depends on how far away it is, even
+    // though the kernel only calculates it again when the distance changes.
+    float lit_squares[MAPSIZE_X][MAPSIZE_Y] = {{0}};
+    float transparency_cache[MAPSIZE_X][MAPSIZE_Y];
+    std::fill_n( &transparency_cache[0][0], MAPSIZE_X * MAPSIZE_Y, LIGHT_TRANSPARENCY_OPEN_AIR );
+    castLightAll<float, float, sight_calc, sight_check, update_light, accumulate_transparency>(
+        lit_squares, transparency_cache, ORIGIN );
+    for( int x = 0; x < MAPSIZE_X; ++x ) {
+        for( int y = 0; y < MAPSIZE_Y; ++y ) {
+            const point p( x, y );
+            if( p == ORIGIN || square_dist( p, ORIGIN ) > 60 ) {
+                continue;
+            }
+            CAPTURE( p );
+            const float expected = sight_calc( 1.0f, LIGHT_TRANSPARENCY_OPEN_AIR,
+                                               rl_dist( ORIGIN, p ) );
+            REQUIRE( lit_squares[x][y] == Approx( expected ).epsilon( 0.0001 ) );
+        }
+    }
+}
+
+TEST_CASE( "shadowcasting_intensity_matches_rl_dist", "[shadowcasting]" )
+{
+    const bool old_trigdist = trigdist;
+    SECTION( "trigdist" ) {
+        trigdist = true;
+        shadowcasting_intensity_matches_rl_dist();
+    }
+    SECTION( "square distances" ) {
+        trigdist = false;
+        shadowcasting_intensity_matches_rl_dist();
+    }
+    trigdist = old_trigdist;
+}
+
+static void shadowcasting_intensity_performance( const bool use_trigdist )
+{
+    const bool old_trigdist = trigdist;
+    trigdist = use_trigdist;
+    float lit_squares[MAPSIZE_X][MAPSIZE_Y] = {{0}};
+    float transparency_cache[MAPSIZE_X][MAPSIZE_Y] = {{0}};
+    randomly_fill_transparency( transparency_cache );
+    const int iterations = 10000;
+    const auto start = std::chrono::high_resolution_clock::now();
+    for( int i = 0; i < iterations; i++ ) {
+        castLightAll<float, float, sight_calc, sight_check, update_light, accumulate_transparency>(
+            lit_squares, transparency_cache, ORIGIN );
+    }
+    const auto end = std::chrono::high_resolution_clock::now();
+    trigdist = old_trigdist;
+    const long long diff = std::chrono::duration_cast<std::chrono::microseconds>
+                           ( end - start ).count();
+    printf( "castLight() with %s distances executed %d times in %lld microseconds.\n",
+            use_trigdist ? "circular" : "square", iterations, diff );
+}
+
+TEST_CASE( "shadowcasting_intensity_performance", "[.]" )
+{
+    shadowcasting_intensity_performance( false );
+    shadowcasting_intensity_performance( true );
+}
+
 // Some random edge cases aren't matching.
 TEST_CASE( "shadowcasting_runoff", "[.]" )
 {
@@ -0,0 +1,98 @@
+#include "catch/catch.hpp"
+
+#include "calendar.h"
+#include "game.h"
+#include "game_constants.h"
+#include "line.h"
+#include "map.h"
+#include "map_helpers.h"
+#include "map_iterator.h"
+#include "monster.h"
+#include "point.h"
+#include "sounds.h"
+#include "type_id.h"
+#include "weather.h"
+#include "weather_type.h"
+
+TEST_CASE( "monsters_react_to_the_loudest_sound_they_hear", "[sounds]" )
+{
+    clear_map();
+    sounds::reset_sounds();
+    const tripoint pos( HALF_MAPSIZE_X, HALF_MAPSIZE_Y + 10, 0 );
+    // Keep the player off the monster's tile and out of the way of the sounds.
+    g->place_player( pos + point( 0, -10 ) );
+    monster &zombie = spawn_test_monster( "mon_zombie", pos );
+    REQUIRE( zombie.can_hear() );
+    const int weather_vol = get_weather().weather_id->sound_attn;
+
+    const tripoint loud = pos + point( -30, 0 );
+    for( int i = 0; i < 3; ++i ) {
+        sounds::sound( pos + point( 3, i ), 40, sounds::sound_t::combat, "bang" );
+    }
+    sounds::sound( loud, 150, sounds::sound_t::alarm, "alarm" );
+    sounds::process_sounds();
+
+    // Loud enough to be located exactly.
+    CHECK( zombie.wander_pos == loud );
+    CHECK( zombie.wandf == 150 - weather_vol - 30 );
+    sounds::reset_sounds();
+}
+
+TEST_CASE( "monsters_are_scared_by_every_sound_they_hear", "[sounds]" )
+{
+    clear_map();
+    sounds::reset_sounds();
+    const tripoint pos( HALF_MAPSIZE_X, HALF_MAPSIZE_Y + 10, 0 );
+    g->place_player( pos + point( 0, -10 ) );
+    const tripoint loud = pos + point( -30, 0 );
+    const tripoint quiet = pos + point( 20, 0 );
+
+    monster &duck = spawn_test_monster( "mon_duck", pos );
+    REQUIRE( duck.can_hear() );
+    const int morale = duck.morale;
+    sounds::sound( loud, 150, sounds::sound_t::alarm, "alarm" );
+    sounds::process_sounds();
+    const int scared_by_alarm = morale - duck.morale;
+    REQUIRE( scared_by_alarm > 0 );
+
+    duck.morale = morale;
+    sounds::sound( loud, 150, sounds::sound_t::alarm, "alarm" );
+    sounds::sound( quiet, 60, sounds::sound_t::combat, "bang" );
+    sounds::process_sounds();
+    // Only running from the loudest sound, but scared by both.
+    CHECK( duck.wander_pos == pos + point( 30, 0 ) );
+    CHECK( duck.morale < morale - scared_by_alarm );
+    sounds::reset_sounds();
+}
+
+TEST_CASE( "walls_muffle_sounds_for_monsters", "[sounds]" )
+{
+    clear_map();
+    sounds::reset_sounds();
+    const time_point old_turn = calendar::turn;
+    map &here = get_map();
+    const tripoint pos( HALF_MAPSIZE_X, HALF_MAPSIZE_Y + 10, 0 );
+    const tripoint source = pos + point( -20, 0 );
+    monster &zombie = spawn_test_monster( "mon_zombie", pos );
+
+    sounds::sound( source, 100, sounds::sound_t::alarm, "alarm" );
+    sounds::process_sounds();
+    const int open_air = zombie.wandf;
+    REQUIRE( open_air > 0 );
+
+    // Wall the source in.
+    for( const tripoint &p : here.points_in_radius( source, 2 ) ) {
+        if( square_dist( p, source ) == 2 ) {
+            here.ter_set( p, ter_id( "t_wall" ) );
+        }
+    }
+    here.build_map_cache( 0 );
+    zombie.wandf = 0;
+    calendar::turn += 1_turns;
+    sounds::sound( source, 100, sounds::sound_t::alarm, "alarm" );
+    sounds::process_sounds();
+    CHECK( zombie.wandf > 0 );
+    CHECK( zombie.wandf < open_air );
+    sounds::reset_sounds();
+    calendar::turn = old_turn;
+}
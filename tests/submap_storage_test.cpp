@@ -0,0 +1,335 @@
+#include "catch/catch.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <iterator>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "calendar.h"
+#include "cata_utility.h"
+#include "coordinate_conversions.h"
+#include "filesystem.h"
+#include "game.h"
+#include "item.h"
+#include "json.h"
+#include "map.h"
+#include "map_helpers.h"
+#include "mapbuffer.h"
+#include "mapbuffer_io.h"
+#include "optional.h"
+#include "path_info.h"
+#include "point.h"
+#include "rng.h"
+#include "submap.h"
+#include "string_formatter.h"
+#include "submap_storage.h"
+#include "type_id.h"
+
+// The JSON of every quad in the mapbuffer, the way mapbuffer saves it.
+static std::map<tripoint, std::string> quads_as_json()
+{
+    std::map<tripoint, std::vector<tripoint>> quads;
+    for( const auto &elem : MAPBUFFER ) {
+        quads[sm_to_omt_copy( elem.first )].push_back( elem.first );
+    }
+    std::map<tripoint, std::string> ret;
+    for( const auto &quad : quads ) {
+        std::ostringstream os;
+        JsonOut jsout( os );
+        jsout.start_array();
+        for( const tripoint &sm_addr : quad.second ) {
+            jsout.start_object();
+            jsout.member( "version", savegame_version );
+            jsout.member( "coordinates" );
+            jsout.start_array();
+            jsout.write( sm_addr.x );
+            jsout.write( sm_addr.y );
+            jsout.write( sm_addr.z );
+            jsout.end_array();
+            MAPBUFFER.lookup_submap( sm_addr )->store( jsout );
+            jsout.end_object();
+        }
+        jsout.end_array();
+        ret[quad.first] = os.str();
+    }
+    return ret;
+}
+
+static void fill_test_map()
+{
+    clear_map();
+    map &here = get_map();
+    for( int i = 0; i < 200; ++i ) {
+        const tripoint p( rng( 0, MAPSIZE_X - 1 ), rng( 0, MAPSIZE_Y - 1 ), 0 );
+        here.ter_set( p, ter_id( "t_wall" ) );
+        here.add_item( p + tripoint_east, item( "rock", calendar::turn_zero ) );
+    }
+}
+
+TEST_CASE( "submap_storage_compression_round_trip", "[submap_storage]" )
+{
+    std::string data;
+    SECTION( "empty" ) {
+    }
+    SECTION( "random" ) {
+        for( int i = 0; i < 100000; ++i ) {
+            data.push_back( static_cast<char>( rng( 0, 255 ) ) );
+        }
+    }
+    SECTION( "repetitive" ) {
+        for( int i = 0; i < 100000; ++i ) {
+            data += std::to_string( i % 37 );
+        }
+        CHECK( submap_storage::compress( data ).size() < data.size() / 10 );
+    }
+    CHECK( submap_storage::decompress( submap_storage::compress( data ) ) == data );
+}
+
+TEST_CASE( "submap_storage_rejects_corrupt_data", "[submap_storage]" )
+{
+    const std::string data = submap_storage::compress( "[\"some\",\"json\",\"some\",\"json\"]" );
+    CHECK_THROWS( submap_storage::decompress( data.substr( 0, data.size() - 3 ) ) );
+    const std::string encoded = submap_storage::encode_json( "{\"a\":[1,2,3,3,3,3]}" );
+    CHECK_THROWS( submap_storage::decode_json( encoded.substr( 0, encoded.size() - 1 ) ) );
+    CHECK_THROWS( submap_storage::encode_json( "{\"a\":[1,2" ) );
+}
+
+TEST_CASE( "submap_storage_round_trips_saved_quads", "[submap_storage]" )
+{
+    fill_test_map();
+    const std::map<tripoint, std::string> quads = quads_as_json();
+    REQUIRE_FALSE( quads.empty() );
+
+    const std::string path = PATH_INFO::world_base_save_path() + "/submap_storage_test.region";
+    {
+        submap_region region( path );
+        for( const auto &quad : quads ) {
+            const std::string encoded = submap_storage::encode_json( quad.second );
+            CHECK( submap_storage::decode_json( encoded ) == quad.second );
+            region.write_quad( quad.first, quad.second );
+        }
+        region.save();
+    }
+    REQUIRE( file_exist( path ) );
+
+    submap_region region( path );
+    CHECK( region.get_quads().size() == quads.size() );
+    for( const auto &quad : quads ) {
+        const cata::optional<std::string> json = region.read_quad( quad.first );
+        REQUIRE( json );
+        CHECK( *json == quad.second );
+        region.remove_quad( quad.first );
+    }
+    CHECK_FALSE( region.read_quad( tripoint( 1000, 1000, 0 ) ) );
+    // Removing the last quad removes the file.
+    region.save();
+    CHECK_FALSE( file_exist( path ) );
+}
+
+TEST_CASE( "mapbuffer_io_reads_back_queued_and_prefetched_quads", "[submap_storage]" )
+{
+    // Region files are kept in a folder that mapbuffer::save creates.
+    const std::string dirname = PATH_INFO::world_base_save_path() + "/mapbuffer_io_test";
+    REQUIRE( assure_dir_exist( dirname ) );
+    const auto location = [&dirname]( const tripoint & om_addr, const bool binary ) {
+        mapbuffer_io::quad_location loc;
+        loc.om_addr = om_addr;
+        loc.dirname = dirname;
+        loc.path = string_format( "%s/%d.%d.%d.map", dirname, om_addr.x, om_addr.y, om_addr.z );
+        loc.region_path = dirname + "/test.region";
+        loc.binary = binary;
+        return loc;
+    };
+    const bool binary = GENERATE( false, true );
+    CAPTURE( binary );
+    const tripoint first( 1, 2, 0 );
+    const tripoint second( 3, 4, 0 );
+    {
+        mapbuffer_io io;
+        CHECK_FALSE( io.read( location( first, binary ) ) );
+        io.write( location( first, binary ), "[\"first\"]" );
+        io.write( location( second, binary ), "[\"second\"]" );
+        // A newer save replaces the queued one.
+        io.write( location( first, binary ), "[\"first again\"]" );
+        CHECK( io.read( location( first, binary ) ).value_or( "" ) == "[\"first again\"]" );
+        io.flush_regions();
+        io.wait();
+        CHECK( io.take_errors().empty() );
+    }
+    CHECK( file_exist( location( first, false ).path ) != binary );
+
+    mapbuffer_io io;
+    io.prefetch( location( second, binary ) );
+    io.wait();
+    CHECK( io.read( location( second, binary ) ).value_or( "" ) == "[\"second\"]" );
+    CHECK( io.read( location( first, binary ) ).value_or( "" ) == "[\"first again\"]" );
+    // Saving in the other format moves the quads over.
+    io.write( location( first, !binary ), "[\"first\"]" );
+    io.write( location( second, !binary ), "[\"second\"]" );
+    io.flush_regions();
+    io.wait();
+    CHECK( io.take_errors().empty() );
+    CHECK( file_exist( location( first, false ).path ) == binary );
+    CHECK( file_exist( location( first, false ).region_path ) != binary );
+
+    remove_file( location( first, false ).path );
+    remove_file( location( second, false ).path );
+    remove_file( location( first, false ).region_path );
+    remove_directory( dirname );
+}
+
+TEST_CASE( "mapbuffer_io_keeps_the_latest_prefetches", "[submap_storage]" )
+{
+    const std::string dirname = PATH_INFO::world_base_save_path() + "/mapbuffer_io_test";
+    REQUIRE( assure_dir_exist( dirname ) );
+    const auto location = [&dirname]( const tripoint & om_addr ) {
+        mapbuffer_io::quad_location loc;
+        loc.om_addr = om_addr;
+        loc.dirname = dirname;
+        loc.path = string_format( "%s/%d.%d.%d.map", dirname, om_addr.x, om_addr.y, om_addr.z );
+        loc.region_path = dirname + "/test.region";
+        return loc;
+    };
+    std::vector<tripoint> quads;
+    for( size_t i = 0; i < mapbuffer_io::max_prefetched; ++i ) {
+        quads.emplace_back( static_cast<int>( i ), 0, 0 );
+    }
+    {
+        mapbuffer_io io;
+        for( const tripoint &om_addr : quads ) {
+            io.write( location( om_addr ), string_format( "[%d]", om_addr.x ) );
+        }
+        io.wait();
+        REQUIRE( io.take_errors().empty() );
+    }
+
+    mapbuffer_io io;
+    // Reading the first quad takes it out of memory, fetching it again makes it the newest.
+    io.prefetch( location( quads.front() ) );
+    io.wait();
+    CHECK( io.read( location( quads.front() ) ).value_or( "" ) == "[0]" );
+    io.prefetch( location( quads.front() ) );
+    io.wait();
+    for( size_t i = 1; i < quads.size(); ++i ) {
+        io.prefetch( location( quads[i] ) );
+    }
+    io.wait();
+    CHECK( io.take_errors().empty() );
+    // Now exactly as many quads are prefetched as are kept, so all of them are still in memory.
+    for( const tripoint &om_addr : quads ) {
+        remove_file( location( om_addr ).path );
+    }
+    for( const tripoint &om_addr : quads ) {
+        CAPTURE( om_addr );
+        CHECK( io.read( location( om_addr ) ).value_or( "" ) == string_format( "[%d]", om_addr.x ) );
+    }
+    remove_directory( dirname );
+}
+
+TEST_CASE( "mapbuffer_converts_saved_quads_between_formats", "[submap_storage]" )
+{
+    fill_test_map();
+    const std::map<tripoint, std::string> quads = quads_as_json();
+    REQUIRE_FALSE( quads.empty() );
+    // Where mapbuffer saves the quads as JSON.
+    const std::string maps_dir = PATH_INFO::world_base_save_path() + "/maps";
+    const auto json_path = [&maps_dir]( const tripoint & om_addr ) {
+        const tripoint segment_addr = omt_to_seg_copy( om_addr );
+        return string_format( "%s/%d.%d.%d/%d.%d.%d.map", maps_dir, segment_addr.x, segment_addr.y,
+                              segment_addr.z, om_addr.x, om_addr.y, om_addr.z );
+    };
+    REQUIRE( assure_dir_exist( maps_dir ) );
+    for( const auto &quad : quads ) {
+        const std::string path = json_path( quad.first );
+        REQUIRE( assure_dir_exist( path.substr( 0, path.find_last_of( '/' ) ) ) );
+        REQUIRE( write_to_file( path, [&quad]( std::ostream & fout ) {
+            fout << quad.second;
+        }, "map quad" ) );
+    }
+
+    CHECK( MAPBUFFER.convert_storage( true ) >= static_cast<int>( quads.size() ) );
+    for( const auto &quad : quads ) {
+        CHECK_FALSE( file_exist( json_path( quad.first ) ) );
+    }
+    CHECK( MAPBUFFER.convert_storage( false ) >= static_cast<int>( quads.size() ) );
+    for( const auto &quad : quads ) {
+        const std::string path = json_path( quad.first );
+        std::string json;
+        REQUIRE( read_from_file( path, [&json]( std::istream & fin ) {
+            json.assign( std::istreambuf_iterator<char>( fin ), std::istreambuf_iterator<char>() );
+        } ) );
+        CHECK( json == quad.second );
+        remove_file( path );
+    }
+    CHECK( get_files_from_path( ".region", maps_dir, false, true ).empty() );
+}
+
+TEST_CASE( "submap_storage_benchmark", "[.]" )
+{
+    fill_test_map();
+    const std::map<tripoint, std::string> quads = quads_as_json();
+    const int iterations = 20;
+
+    size_t json_size = 0;
+    size_t binary_size = 0;
+    std::map<tripoint, std::string> binary;
+    const auto start_save = std::chrono::high_resolution_clock::now();
+    for( int i = 0; i < iterations; ++i ) {
+        for( const auto &quad : quads ) {
+            binary[quad.first] = submap_storage::compress( submap_storage::encode_json( quad.second ) );
+        }
+    }
+    const auto end_save = std::chrono::high_resolution_clock::now();
+    for( const auto &quad : quads ) {
+        json_size += quad.second.size();
+        binary_size += binary[quad.first].size();
+    }
+
+    // Loading parses the JSON either way, the binary form has to be decoded first.
+    const auto parse = []( const std::string & json ) {
+        std::istringstream is( json );
+        JsonIn jsin( is );
+        jsin.start_array();
+        while( !jsin.end_array() ) {
+            submap sm;
+            jsin.start_object();
+            int version = 0;
+            while( !jsin.end_object() ) {
+                const std::string name = jsin.get_member_name();
+                if( name == "version" ) {
+                    version = jsin.get_int();
+                } else if( name == "coordinates" ) {
+                    jsin.skip_value();
+                } else {
+                    sm.load( jsin, name, version );
+                }
+            }
+        }
+    };
+    const auto start_json = std::chrono::high_resolution_clock::now();
+    for( int i = 0; i < iterations; ++i ) {
+        for( const auto &quad : quads ) {
+            parse( quad.second );
+        }
+    }
+    const auto end_json = std::chrono::high_resolution_clock::now();
+    for( int i = 0; i < iterations; ++i ) {
+        for( const auto &quad : binary ) {
+            parse( submap_storage::decode_json( submap_storage::decompress( quad.second ) ) );
+        }
+    }
+    const auto end_binary = std::chrono::high_resolution_clock::now();
+
+    const auto ms = []( const std::chrono::high_resolution_clock::duration & d ) {
+        return static_cast<long long>( std::chrono::duration_cast<std::chrono::milliseconds>( d ).count() );
+    };
+    printf( "%zu quads: %zu bytes of JSON, %zu bytes binary.\n", quads.size(), json_size,
+            binary_size );
+    printf( "Encoding %d times took %lld ms.\n", iterations, ms( end_save - start_save ) );
+    printf( "Loading %d times took %lld ms from JSON, %lld ms from binary.\n", iterations,
+            ms( end_json - start_json ), ms( end_binary - end_json ) );
+    CHECK( binary_size < json_size );
+}
@@ -0,0 +1,125 @@
+#include "catch/catch.hpp"
+
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "json.h"
+#include "turn_profiler.h"
+
+static const turn_profiler::phase_summary *find_phase(
+    const std::vector<turn_profiler::phase_summary> &summary, const turn_phase phase )
+{
+    for( const turn_profiler::phase_summary &sum : summary ) {
+        if( sum.phase == phase ) {
+            return &sum;
+        }
+    }
+    return nullptr;
+}
+
+TEST_CASE( "turn_profiler_records_nothing_while_disabled", "[turn_profiler]" )
+{
+    turn_profiler::set_enabled( false );
+    turn_profiler::reset();
+    {
+        turn_profiler::scoped_timer timer( turn_phase::monmove );
+    }
+    turn_profiler::end_turn();
+    CHECK( turn_profiler::recorded_turns() == 0 );
+    CHECK( turn_profiler::summarize().empty() );
+}
+
+TEST_CASE( "turn_profiler_accumulates_phases_per_turn", "[turn_profiler]" )
+{
+    turn_profiler::set_enabled( true );
+    for( int turn = 0; turn < 3; ++turn ) {
+        {
+            turn_profiler::scoped_timer timer( turn_phase::fields );
+            std::this_thread::sleep_for( std::chrono::microseconds( 100 ) );
+        }
+        // Phases may run several times in a turn.
+        for( int i = 0; i < 2; ++i ) {
+            turn_profiler::scoped_timer timer( turn_phase::lightmap );
+        }
+        turn_profiler::end_turn();
+    }
+    // A turn in which only one phase ran.
+    {
+        turn_profiler::scoped_timer timer( turn_phase::fields );
+    }
+    turn_profiler::end_turn();
+    turn_profiler::set_enabled( false );
+
+    CHECK( turn_profiler::recorded_turns() == 4 );
+    const std::vector<turn_profiler::phase_summary> summary = turn_profiler::summarize();
+    REQUIRE( summary.size() == 2 );
+
+    const turn_profiler::phase_summary *fields = find_phase( summary, turn_phase::fields );
+    REQUIRE( fields != nullptr );
+    CHECK( fields->turns == 4 );
+    CHECK( fields->calls == 4 );
+    CHECK( fields->max_us >= 100.0 );
+    CHECK( fields->p50_us <= fields->p95_us );
+    CHECK( fields->p95_us <= fields->max_us );
+    int histogram_total = 0;
+    for( const int count : fields->histogram ) {
+        histogram_total += count;
+    }
+    CHECK( histogram_total == 4 );
+
+    const turn_profiler::phase_summary *lightmap = find_phase( summary, turn_phase::lightmap );
+    REQUIRE( lightmap != nullptr );
+    CHECK( lightmap->turns == 3 );
+    CHECK( lightmap->calls == 6 );
+
+    SECTION( "json export" ) {
+        std::ostringstream os;
+        turn_profiler::write_json( os );
+        std::istringstream is( os.str() );
+        JsonIn jsin( is );
+        JsonObject jo = jsin.get_object();
+        jo.allow_omitted_members();
+        CHECK( jo.get_int( "turns" ) == 4 );
+        CHECK( jo.get_array( "phases" ).size() == 2 );
+    }
+
+    SECTION( "csv export" ) {
+        std::ostringstream os;
+        turn_profiler::write_csv( os );
+        const std::string csv = os.str();
+        CHECK( csv.find( "phase,turns,calls" ) == 0 );
+        CHECK( csv.find( "\nfields,4,4," ) != std::string::npos );
+        CHECK( csv.find( "\nlightmap,3,6," ) != std::string::npos );
+    }
+
+    turn_profiler::reset();
+    CHECK( turn_profiler::recorded_turns() == 0 );
+}
+
+TEST_CASE( "turn_profiler_total_leaves_out_player_input", "[turn_profiler]" )
+{
+    turn_profiler::set_enabled( true );
+    {
+        turn_profiler::scoped_timer turn_timer( turn_phase::total );
+        {
+            turn_profiler::scoped_timer timer( turn_phase::player_input );
+            std::this_thread::sleep_for( std::chrono::milliseconds( 50 ) );
+        }
+        turn_profiler::scoped_timer timer( turn_phase::fields );
+        std::this_thread::sleep_for( std::chrono::microseconds( 100 ) );
+    }
+    turn_profiler::end_turn();
+    turn_profiler::set_enabled( false );
+
+    const std::vector<turn_profiler::phase_summary> summary = turn_profiler::summarize();
+    const turn_profiler::phase_summary *total = find_phase( summary, turn_phase::total );
+    const turn_profiler::phase_summary *input = find_phase( summary, turn_phase::player_input );
+    REQUIRE( total != nullptr );
+    REQUIRE( input != nullptr );
+    CHECK( input->max_us >= 50000.0 );
+    CHECK( total->max_us >= 100.0 );
+    CHECK( total->max_us < 50000.0 );
+    turn_profiler::reset();
+}
@@ -542,3 +542,57 @@ TEST_CASE( "vision_see_wall_in_moonlight", "[shadowcasting][vision]" )
 
     t.test_all();
 }
+
+TEST_CASE( "incremental_lightmap_matches_full_rebuild", "[shadowcasting][vision]" )
+{
+    const ter_id t_brick_wall( "t_brick_wall" );
+    const ter_id t_floor( "t_floor" );
+    const ter_id t_utility_light( "t_utility_light" );
+
+    Character &player_character = get_player_character();
+    g->place_player( tripoint( 60, 60, 0 ) );
+    player_character.worn.clear();
+    clear_map();
+    g->reset_light_level();
+    calendar::turn = calendar::turn_zero;
+
+    map &here = get_map();
+    const int z = player_character.posz();
+    here.ter_set( tripoint( 50, 50, z ), t_utility_light );
+    here.ter_set( tripoint( 70, 55, z ), t_utility_light );
+    here.ter_set( tripoint( 51, 50, z ), t_utility_light );
+    for( int y = 40; y < 60; ++y ) {
+        here.ter_set( tripoint( 55, y, z ), t_brick_wall );
+    }
+    here.invalidate_map_cache( z );
+    here.build_map_cache( z );
+
+    // Move lights and open the wall, then let the lightmap update incrementally.
+    here.ter_set( tripoint( 70, 55, z ), t_floor );
+    here.ter_set( tripoint( 65, 70, z ), t_utility_light );
+    here.ter_set( tripoint( 55, 50, z ), t_floor );
+    here.ter_set( tripoint( 60, 62, z ), t_brick_wall );
+    here.build_map_cache( z );
+
+    const level_cache &cache = here.access_cache( z );
+    const std::vector<four_quadrants> incremental_lm( &cache.lm[0][0],
+            &cache.lm[0][0] + MAPSIZE_X * MAPSIZE_Y );
+    const std::vector<float> incremental_sm( &cache.sm[0][0], &cache.sm[0][0] + MAPSIZE_X * MAPSIZE_Y );
+
+    // Drop the cached composite so that every light source is cast again.
+    here.access_cache( z ).bulk_light.reset();
+    here.invalidate_map_cache( z );
+    here.build_map_cache( z );
+
+    std::ostringstream mismatches;
+    for( int x = 0; x < MAPSIZE_X; ++x ) {
+        for( int y = 0; y < MAPSIZE_Y; ++y ) {
+            const int i = x * MAPSIZE_Y + y;
+            if( incremental_lm[i].to_string() != cache.lm[x][y].to_string() ||
+                incremental_sm[i] != cache.sm[x][y] ) {
+                mismatches << "(" << x << "," << y << ") ";
+            }
+        }
+    }
+    CHECK( mismatches.str().empty() );
+}
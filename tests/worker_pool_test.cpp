@@ -0,0 +1,52 @@
+#include "catch/catch.hpp"
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+#include "worker_pool.h"
+
+TEST_CASE( "worker_pool_runs_every_index_once", "[worker_pool]" )
+{
+    for( const int num_workers : {
+             0, 1, 3
+         } ) {
+        CAPTURE( num_workers );
+        worker_pool pool( num_workers );
+        for( int job = 0; job < 20; ++job ) {
+            std::vector<std::atomic<int>> calls( 40 );
+            for( std::atomic<int> &c : calls ) {
+                c = 0;
+            }
+            pool.parallel_for( -5, 35, [&]( const int i ) {
+                calls[i + 5]++;
+            } );
+            for( const std::atomic<int> &c : calls ) {
+                CHECK( c == 1 );
+            }
+        }
+        // Empty ranges do nothing.
+        pool.parallel_for( 3, 3, []( int ) {
+            FAIL( "task called for an empty range" );
+        } );
+    }
+}
+
+TEST_CASE( "worker_pool_rethrows_task_exceptions", "[worker_pool]" )
+{
+    worker_pool pool( 2 );
+    std::atomic<int> calls( 0 );
+    CHECK_THROWS_AS( pool.parallel_for( 0, 10, [&]( const int i ) {
+        calls++;
+        if( i == 4 ) {
+            throw std::runtime_error( "task failed" );
+        }
+    } ), std::runtime_error );
+    // The remaining tasks still ran, and the pool is usable afterwards.
+    CHECK( calls == 10 );
+    calls = 0;
+    pool.parallel_for( 0, 10, [&]( int ) {
+        calls++;
+    } );
+    CHECK( calls == 10 );
+}